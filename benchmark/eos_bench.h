@@ -0,0 +1,23 @@
+#ifndef EOS_BENCH_H__
+#define EOS_BENCH_H__
+
+#include "eventos.h"
+
+/* tool --------------------------------------------------------------------- */
+// 伪随机数，保证每次运行的结果可重复
+eos_u32_t eos_bench_rand(void);
+// 单调时钟，单位纳秒
+double eos_bench_time_ns(void);
+
+/* benchmark function ------------------------------------------------------- */
+void eos_bench_etimer(void);
+void eos_bench_slack(void);
+void eos_bench_coroutine(void);
+void eos_bench_hsm(void);
+void eos_bench_tsm(void);
+void eos_bench_region(void);
+void eos_bench_reactor(void);
+void eos_bench_batch(void);
+void eos_bench_edf(void);
+
+#endif
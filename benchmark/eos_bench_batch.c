@@ -0,0 +1,80 @@
+#include "eos_bench.h"
+#include "eos_test_def.h"
+#include <stdio.h>
+
+// 事件的批量送达：模拟10kHz的采样流，每1ms发布BENCH_BURST个带4字节数据的采样事件，然后调度
+// 直至没有事件。single为逐个送达的Reactor，batch为批处理的Reactor。ns为每个采样的耗时（含发布），
+// passes为每个采样的调度次数（eos_once返回EosRun_OK的次数）。
+
+#if (EOS_USE_EVENT_BATCH != 0)
+#define BENCH_TOPIC                         Event_User
+#define BENCH_BURST                         10
+#define BENCH_SAMPLES                       200000
+
+static eos_mcu_t sub_table[Event_User + 1];
+static eos_reactor_t bench_reactor[2];
+static eos_u32_t bench_sum;
+
+static void bench_single(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    bench_sum += *(eos_u32_t *)e->data;
+}
+
+static void bench_batch(eos_reactor_t * const me, eos_event_t const * const e, eos_u32_t count)
+{
+    (void)me;
+    for (eos_u32_t i = 0; i < count; i ++) {
+        bench_sum += *(eos_u32_t *)e[i].data;
+    }
+}
+
+static void bench_samples(const char *name)
+{
+    eos_u32_t passes = 0;
+    bench_sum = 0;
+    double t = eos_bench_time_ns();
+    for (eos_u32_t i = 0; i < BENCH_SAMPLES; i += BENCH_BURST) {
+        for (eos_u32_t k = 0; k < BENCH_BURST; k ++) {
+            eos_u32_t sample = i + k;
+            eos_event_pub(BENCH_TOPIC, &sample, sizeof(sample));
+        }
+        while (eos_once() == EosRun_OK) {
+            passes ++;
+        }
+    }
+    t = (eos_bench_time_ns() - t) / BENCH_SAMPLES;
+    // 所有采样都被处理
+    if (bench_sum != (eos_u32_t)((eos_u64_t)BENCH_SAMPLES * (BENCH_SAMPLES - 1) / 2)) {
+        printf("%s: lost samples\n", name);
+    }
+    printf("%-8s %10.1f %10.2f %10.2f\n", name, t, 1000.0 / t, (double)passes / BENCH_SAMPLES);
+}
+
+static void bench_start(eos_reactor_t *me)
+{
+    eos_set_time(0);
+    eos_init();
+    eos_sub_init(sub_table, Event_User + 1);
+    eos_reactor_init(me, 0, EOS_NULL);
+}
+#endif
+
+void eos_bench_batch(void)
+{
+#if (EOS_USE_EVENT_BATCH != 0)
+    printf("\n[batch] %u samples in bursts of %u, batch size %u\n",
+           BENCH_SAMPLES, BENCH_BURST, EOS_MAX_EVENT_BATCH);
+    printf("%-8s %10s %10s %10s\n", "engine", "ns", "Msample/s", "passes");
+
+    bench_start(&bench_reactor[0]);
+    eos_reactor_start(&bench_reactor[0], bench_single);
+    eos_event_sub(&bench_reactor[0].super, BENCH_TOPIC);
+    bench_samples("single");
+
+    bench_start(&bench_reactor[1]);
+    eos_reactor_start_batch(&bench_reactor[1], bench_batch);
+    eos_event_sub(&bench_reactor[1].super, BENCH_TOPIC);
+    bench_samples("batch");
+#endif
+}
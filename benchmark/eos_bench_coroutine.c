@@ -0,0 +1,96 @@
+#include "eos_bench.h"
+#include "eos_coroutine.h"
+#include "eos_test_def.h"
+#include <stdio.h>
+
+// 有栈协程Actor的开销：每个事件的处理耗时（发布与调度），普通Reactor与协程Actor之差即为两次
+// 上下文切换（进入与返回协程）；另外单独测量一次swapcontext往返，并给出每个Actor的内存开销。
+
+#define BENCH_TOPIC                         Event_User
+#define BENCH_TOPIC_CO                      (Event_User + 1)
+#define BENCH_EVENTS                        200000
+
+static eos_mcu_t sub_table[Event_User + 2];
+static eos_reactor_t bench_reactor;
+static eos_coroutine_t bench_co;
+static eos_u8_t bench_stack[EOS_COROUTINE_STACK_MIN];
+static eos_u32_t bench_count;
+
+static void bench_func(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    (void)e;
+    bench_count ++;
+}
+
+static void bench_entry(eos_coroutine_t * const me)
+{
+    while (1) {
+        eos_coroutine_wait(me);
+        bench_count ++;
+    }
+}
+
+// 发布并处理BENCH_EVENTS个事件，返回每个事件的平均耗时
+static double bench_events(eos_topic_t topic)
+{
+    bench_count = 0;
+    double t = eos_bench_time_ns();
+    for (eos_u32_t i = 0; i < BENCH_EVENTS; i ++) {
+        eos_event_pub_topic(topic);
+        eos_once();
+    }
+    t = (eos_bench_time_ns() - t) / BENCH_EVENTS;
+    if (bench_count != BENCH_EVENTS) {
+        printf("error: %u events handled, %u expected.\n", bench_count, BENCH_EVENTS);
+    }
+
+    return t;
+}
+
+static ucontext_t swap_main, swap_co;
+
+static void bench_swap_entry(void)
+{
+    while (1) {
+        swapcontext(&swap_co, &swap_main);
+    }
+}
+
+void eos_bench_coroutine(void)
+{
+    printf("\n[coroutine] ns per event, %u events\n", BENCH_EVENTS);
+    eos_set_time(0);
+    eos_init();
+    eos_sub_init(sub_table, Event_User + 2);
+    eos_reactor_init(&bench_reactor, 0, EOS_NULL);
+    eos_reactor_start(&bench_reactor, bench_func);
+    eos_event_sub(&bench_reactor.super, BENCH_TOPIC);
+    eos_coroutine_init(&bench_co, 1, BENCH_TOPIC_CO, bench_stack, sizeof(bench_stack));
+    eos_coroutine_start(&bench_co, bench_entry);
+    while (eos_once() == EosRun_OK) {
+    }
+
+    double time_reactor = bench_events(BENCH_TOPIC);
+    double time_co = bench_events(BENCH_TOPIC_CO);
+    printf("%-24s %10.1f\n", "reactor", time_reactor);
+    printf("%-24s %10.1f\n", "coroutine", time_co);
+    printf("%-24s %10.1f\n", "context switch", (time_co - time_reactor) / 2);
+
+    // 单独的swapcontext往返（两次切换）
+    getcontext(&swap_co);
+    swap_co.uc_stack.ss_sp = bench_stack;
+    swap_co.uc_stack.ss_size = sizeof(bench_stack);
+    swap_co.uc_link = &swap_main;
+    makecontext(&swap_co, bench_swap_entry, 0);
+    double t = eos_bench_time_ns();
+    for (eos_u32_t i = 0; i < BENCH_EVENTS; i ++) {
+        swapcontext(&swap_main, &swap_co);
+    }
+    t = (eos_bench_time_ns() - t) / BENCH_EVENTS;
+    printf("%-24s %10.1f\n", "swapcontext round trip", t);
+
+    printf("bytes per actor: reactor %u, coroutine %u + stack (>= %u)\n",
+           (eos_u32_t)sizeof(eos_reactor_t), (eos_u32_t)sizeof(eos_coroutine_t),
+           EOS_COROUTINE_STACK_MIN);
+}
@@ -0,0 +1,110 @@
+#include "eos_bench.h"
+#include "eos_test_def.h"
+#include <stdio.h>
+
+// 最早截止优先与按优先级调度的对比：以1ms为步长模拟一个单核的系统，高优先级的Actor处理宽松的批量
+// 事件（耗时3ms，截止40ms，到达率1/5），低优先级的Actor处理紧急的事件（耗时1ms，截止4ms，到达率
+// 1/4），负载率85%。处理器空闲时才调度一次，事件处理完成的时刻晚于截止时刻即为错过。priority
+// 的主题没有截止时间，edf为两个主题设置了截止时间。urgent与lax为两类事件的错过率，late为最大
+// 迟到（毫秒），ns为每个事件的耗时（含模拟与发布）。
+
+#if (EOS_USE_EDF != 0)
+#define BENCH_LAX                           Event_User
+#define BENCH_URGENT                        (Event_User + 1)
+#define BENCH_MS                            1000000
+
+static eos_mcu_t sub_table[Event_User + 2];
+static eos_u16_t deadline_table[Event_User + 2];
+static eos_reactor_t bench_lax[2];
+static eos_reactor_t bench_urgent[2];
+static eos_u32_t bench_now;
+static eos_u32_t bench_busy;                        // 处理器空闲的时刻
+static eos_u32_t bench_count[2];
+static eos_u32_t bench_missed[2];
+static eos_u32_t bench_late;
+
+// 处理事件，占用处理器cost毫秒，检查完成的时刻。
+static void bench_handle(eos_u32_t type, eos_event_t const * const e,
+                         eos_u32_t cost, eos_u32_t deadline)
+{
+    eos_u32_t done = bench_now + cost;
+    eos_u32_t due = *(eos_u32_t *)e->data + deadline;
+
+    bench_busy = done;
+    bench_count[type] ++;
+    if (done > due) {
+        bench_missed[type] ++;
+        if (bench_late < done - due) {
+            bench_late = done - due;
+        }
+    }
+}
+
+static void bench_lax_handler(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    bench_handle(0, e, 3, 40);
+}
+
+static void bench_urgent_handler(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    bench_handle(1, e, 1, 4);
+}
+
+static void bench_run(eos_u32_t run, const char *name, eos_u16_t lax_ms, eos_u16_t urgent_ms)
+{
+    eos_set_time(0);
+    eos_init();
+    eos_sub_init(sub_table, Event_User + 2);
+    eos_deadline_init(deadline_table, Event_User + 2);
+    eos_topic_deadline(BENCH_LAX, lax_ms);
+    eos_topic_deadline(BENCH_URGENT, urgent_ms);
+    eos_reactor_init(&bench_lax[run], 1, EOS_NULL);
+    eos_reactor_start(&bench_lax[run], bench_lax_handler);
+    eos_event_sub(&bench_lax[run].super, BENCH_LAX);
+    eos_reactor_init(&bench_urgent[run], 0, EOS_NULL);
+    eos_reactor_start(&bench_urgent[run], bench_urgent_handler);
+    eos_event_sub(&bench_urgent[run].super, BENCH_URGENT);
+
+    bench_busy = 0;
+    bench_late = 0;
+    for (eos_u32_t i = 0; i < 2; i ++) {
+        bench_count[i] = 0;
+        bench_missed[i] = 0;
+    }
+    // 两次运行的到达序列相同
+    eos_u32_t seed = 1;
+    double t = eos_bench_time_ns();
+    for (bench_now = 0; bench_now < BENCH_MS; bench_now ++) {
+        eos_set_time(bench_now);
+        seed = seed * 1103515245 + 12345;
+        if (((seed >> 16) % 5) == 0) {
+            eos_event_pub(BENCH_LAX, &bench_now, sizeof(bench_now));
+        }
+        seed = seed * 1103515245 + 12345;
+        if (((seed >> 16) % 4) == 0) {
+            eos_event_pub(BENCH_URGENT, &bench_now, sizeof(bench_now));
+        }
+        if (bench_now >= bench_busy) {
+            eos_once();
+        }
+    }
+    eos_u32_t count = bench_count[0] + bench_count[1];
+    t = (eos_bench_time_ns() - t) / count;
+    printf("%-8s %9.2f%% %9.2f%% %10u %10.1f\n", name,
+           100.0 * bench_missed[1] / bench_count[1],
+           100.0 * bench_missed[0] / bench_count[0], bench_late, t);
+}
+#endif
+
+void eos_bench_edf(void)
+{
+#if (EOS_USE_EDF != 0)
+    printf("\n[edf] lax 3ms/40ms and urgent 1ms/4ms events, %u ms\n", BENCH_MS);
+    printf("%-8s %10s %10s %10s %10s\n", "engine", "urgent", "lax", "late", "ns");
+
+    bench_run(0, "priority", 0, 0);
+    bench_run(1, "edf", 40, 4);
+#endif
+}
@@ -0,0 +1,105 @@
+#include "eos_bench.h"
+#include "eos_test_def.h"
+#include <stdio.h>
+
+// 时间事件的性能测试：N个定时器的启动、到期、空闲滴答与取消的平均耗时。
+// 线性表的到期处理为O(N)，时间轮为O(1)，差异随N的增大而明显。
+
+#if (EOS_USE_TIME_EVENT != 0)
+#define BENCH_TOPIC                         Event_User
+#define BENCH_IDLE_MS                       10000
+
+static const eos_u32_t bench_num[] = {
+    16, 64, 250, 1000, 4000
+};
+
+static eos_mcu_t sub_table[Event_User + EOS_MAX_TIME_EVENT];
+static eos_reactor_t bench_reactor;
+static eos_u32_t bench_fired;
+
+static void bench_func(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    (void)e;
+    bench_fired ++;
+}
+
+static void bench_setup(void)
+{
+    eos_set_time(0);
+    eos_init();
+    eos_sub_init(sub_table, Event_User + EOS_MAX_TIME_EVENT);
+    eos_reactor_init(&bench_reactor, 0, EOS_NULL);
+    eos_reactor_start(&bench_reactor, bench_func);
+    for (eos_u32_t i = 0; i < EOS_MAX_TIME_EVENT; i ++) {
+        eos_event_sub(&bench_reactor.super, BENCH_TOPIC + i);
+    }
+}
+
+static void bench_ticks(eos_u32_t ticks)
+{
+    for (eos_u32_t i = 0; i < ticks; i ++) {
+        eos_tick();
+        while (eos_once() == EosRun_OK) {
+        }
+    }
+}
+
+static void bench_run(eos_u32_t num)
+{
+    double time_start, time_expire, time_tick, time_cancel, t;
+
+    // 每一轮结束时定时器已全部取消，从0时刻重新开始。
+    eos_set_time(0);
+    bench_fired = 0;
+
+    // 启动，超时时间均匀分布在num毫秒之内，平均每毫秒到期一个
+    t = eos_bench_time_ns();
+    for (eos_u32_t i = 0; i < num; i ++) {
+        eos_event_pub_delay(BENCH_TOPIC + i, (eos_bench_rand() % num) + 1);
+    }
+    time_start = (eos_bench_time_ns() - t) / num;
+
+    // 逐毫秒滴答，直至全部到期（包含事件的派发）
+    t = eos_bench_time_ns();
+    bench_ticks(num);
+    time_expire = (eos_bench_time_ns() - t) / num;
+    if (bench_fired != num) {
+        printf("error: %u timers expired, %u expected.\n", bench_fired, num);
+    }
+
+    // 空闲滴答，所有定时器都远未到期
+    for (eos_u32_t i = 0; i < num; i ++) {
+        eos_event_pub_delay(BENCH_TOPIC + i, 3600000 + (eos_bench_rand() % 60000));
+    }
+    t = eos_bench_time_ns();
+    bench_ticks(BENCH_IDLE_MS);
+    time_tick = (eos_bench_time_ns() - t) / BENCH_IDLE_MS;
+
+    // 取消
+    t = eos_bench_time_ns();
+    for (eos_u32_t i = 0; i < num; i ++) {
+        eos_event_time_cancel(BENCH_TOPIC + i);
+    }
+    time_cancel = (eos_bench_time_ns() - t) / num;
+
+    printf("%8u %12.1f %12.1f %12.1f %12.1f\n",
+           num, time_start, time_expire, time_tick, time_cancel);
+}
+#endif
+
+void eos_bench_etimer(void)
+{
+#if (EOS_USE_TIME_EVENT != 0)
+    printf("\n[etimer] %s, ns per operation\n",
+           (EOS_USE_TIMER_WHEEL != 0) ? "timer wheel" : "linear table");
+    printf("%8s %12s %12s %12s %12s\n",
+           "timers", "start", "busy tick", "idle tick", "cancel");
+    bench_setup();
+    for (eos_u32_t i = 0; i < sizeof(bench_num) / sizeof(eos_u32_t); i ++) {
+        if (bench_num[i] > EOS_MAX_TIME_EVENT)
+            break;
+        bench_run(bench_num[i]);
+    }
+#endif
+}
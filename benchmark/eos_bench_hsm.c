@@ -0,0 +1,189 @@
+#include "eos_bench.h"
+#include "eos_test_def.h"
+#include <stdio.h>
+
+// 层次状态机的转移开销：两个分支各BENCH_DEPTH层（4层，最大嵌套层数不小于8时为8层），叶子状态
+// 之间来回转移，每次转移退出与进入各BENCH_DEPTH层。分别给出每次转移的耗时与状态函数的调用次数
+// （其中用于探测父状态的Event_Null调用单独列出）。cold为每次转移之前清空缓存，即不使用缓存时的
+// 开销。desc为相同结构的描述符表驱动的状态机，每个状态都有进入与退出动作，calls为handler与动作
+// 的调用次数。
+
+#if (EOS_USE_SM_MODE != 0 && EOS_USE_HSM_MODE != 0)
+#define BENCH_TOPIC                         Event_User
+#define BENCH_TOPIC_NONE                    (Event_User + 1)
+#define BENCH_EVENTS                        200000
+
+static eos_mcu_t sub_table[Event_User + 2];
+static eos_sm_t bench_sm;
+static eos_u32_t bench_calls;
+static eos_u32_t bench_probes;
+
+#define BENCH_STATE(name_, super_, topic_, target_)                            \
+static eos_ret_t name_(eos_sm_t * const me, eos_event_t const * const e)      \
+{                                                                              \
+    bench_calls ++;                                                            \
+    if (e->topic == Event_Null)                                                \
+        bench_probes ++;                                                       \
+    if (e->topic == (topic_))                                                  \
+        return EOS_TRAN(target_);                                              \
+    if (e->topic == Event_Enter || e->topic == Event_Exit)                     \
+        return EOS_Ret_Handled;                                                \
+    return EOS_SUPER(super_);                                                  \
+}
+
+BENCH_STATE(bench_a1, eos_state_top, BENCH_TOPIC_NONE, bench_a1)
+BENCH_STATE(bench_a2, bench_a1, BENCH_TOPIC_NONE, bench_a2)
+BENCH_STATE(bench_a3, bench_a2, BENCH_TOPIC_NONE, bench_a3)
+BENCH_STATE(bench_b1, eos_state_top, BENCH_TOPIC_NONE, bench_b1)
+BENCH_STATE(bench_b2, bench_b1, BENCH_TOPIC_NONE, bench_b2)
+BENCH_STATE(bench_b3, bench_b2, BENCH_TOPIC_NONE, bench_b3)
+#if (EOS_MAX_HSM_NEST_DEPTH >= 8)
+#define BENCH_DEPTH                         8
+#define BENCH_LEAF_A                        bench_a8
+static eos_ret_t bench_a8(eos_sm_t * const me, eos_event_t const * const e);
+static eos_ret_t bench_b8(eos_sm_t * const me, eos_event_t const * const e);
+BENCH_STATE(bench_a4, bench_a3, BENCH_TOPIC_NONE, bench_a4)
+BENCH_STATE(bench_a5, bench_a4, BENCH_TOPIC_NONE, bench_a5)
+BENCH_STATE(bench_a6, bench_a5, BENCH_TOPIC_NONE, bench_a6)
+BENCH_STATE(bench_a7, bench_a6, BENCH_TOPIC_NONE, bench_a7)
+BENCH_STATE(bench_a8, bench_a7, BENCH_TOPIC, bench_b8)
+BENCH_STATE(bench_b4, bench_b3, BENCH_TOPIC_NONE, bench_b4)
+BENCH_STATE(bench_b5, bench_b4, BENCH_TOPIC_NONE, bench_b5)
+BENCH_STATE(bench_b6, bench_b5, BENCH_TOPIC_NONE, bench_b6)
+BENCH_STATE(bench_b7, bench_b6, BENCH_TOPIC_NONE, bench_b7)
+BENCH_STATE(bench_b8, bench_b7, BENCH_TOPIC, bench_a8)
+#else
+#define BENCH_DEPTH                         4
+#define BENCH_LEAF_A                        bench_a4
+static eos_ret_t bench_a4(eos_sm_t * const me, eos_event_t const * const e);
+static eos_ret_t bench_b4(eos_sm_t * const me, eos_event_t const * const e);
+BENCH_STATE(bench_a4, bench_a3, BENCH_TOPIC, bench_b4)
+BENCH_STATE(bench_b4, bench_b3, BENCH_TOPIC, bench_a4)
+#endif
+
+static eos_ret_t bench_init(eos_sm_t * const me, eos_event_t const * const e)
+{
+    (void)e;
+
+    return EOS_TRAN(BENCH_LEAF_A);
+}
+
+#if (EOS_USE_SM_DESC != 0)
+static eos_dsm_t bench_dsm;
+
+static void bench_action(eos_dsm_t * const me)
+{
+    (void)me;
+    bench_calls ++;
+}
+
+#if (EOS_USE_STATE_SUB != 0)
+#define BENCH_DESC_SUB                      , EOS_NULL, 0
+#else
+#define BENCH_DESC_SUB
+#endif
+#define BENCH_DESC(name_, parent_, handler_)                                   \
+static const eos_state_t name_ = {                                             \
+    parent_, EOS_NULL, bench_action, bench_action, handler_ BENCH_DESC_SUB     \
+};
+
+#if (BENCH_DEPTH == 8)
+#define BENCH_DESC_A                        bench_desc_a8
+#define BENCH_DESC_B                        bench_desc_b8
+#else
+#define BENCH_DESC_A                        bench_desc_a4
+#define BENCH_DESC_B                        bench_desc_b4
+#endif
+static const eos_state_t BENCH_DESC_A;
+static const eos_state_t BENCH_DESC_B;
+
+static eos_ret_t bench_desc_a(eos_dsm_t * const me, eos_event_t const * const e)
+{
+    bench_calls ++;
+    if (e->topic == BENCH_TOPIC)
+        return EOS_DSM_TRAN(BENCH_DESC_B);
+
+    return EOS_Ret_Null;
+}
+
+static eos_ret_t bench_desc_b(eos_dsm_t * const me, eos_event_t const * const e)
+{
+    bench_calls ++;
+    if (e->topic == BENCH_TOPIC)
+        return EOS_DSM_TRAN(BENCH_DESC_A);
+
+    return EOS_Ret_Null;
+}
+
+BENCH_DESC(bench_desc_a1, EOS_NULL, EOS_NULL)
+BENCH_DESC(bench_desc_a2, &bench_desc_a1, EOS_NULL)
+BENCH_DESC(bench_desc_a3, &bench_desc_a2, EOS_NULL)
+BENCH_DESC(bench_desc_b1, EOS_NULL, EOS_NULL)
+BENCH_DESC(bench_desc_b2, &bench_desc_b1, EOS_NULL)
+BENCH_DESC(bench_desc_b3, &bench_desc_b2, EOS_NULL)
+#if (BENCH_DEPTH == 8)
+BENCH_DESC(bench_desc_a4, &bench_desc_a3, EOS_NULL)
+BENCH_DESC(bench_desc_a5, &bench_desc_a4, EOS_NULL)
+BENCH_DESC(bench_desc_a6, &bench_desc_a5, EOS_NULL)
+BENCH_DESC(bench_desc_a7, &bench_desc_a6, EOS_NULL)
+BENCH_DESC(bench_desc_a8, &bench_desc_a7, bench_desc_a)
+BENCH_DESC(bench_desc_b4, &bench_desc_b3, EOS_NULL)
+BENCH_DESC(bench_desc_b5, &bench_desc_b4, EOS_NULL)
+BENCH_DESC(bench_desc_b6, &bench_desc_b5, EOS_NULL)
+BENCH_DESC(bench_desc_b7, &bench_desc_b6, EOS_NULL)
+BENCH_DESC(bench_desc_b8, &bench_desc_b7, bench_desc_b)
+#else
+BENCH_DESC(bench_desc_a4, &bench_desc_a3, bench_desc_a)
+BENCH_DESC(bench_desc_b4, &bench_desc_b3, bench_desc_b)
+#endif
+#endif
+
+static void bench_transitions(const char *name, eos_bool_t cold)
+{
+    bench_calls = 0;
+    bench_probes = 0;
+    double t = eos_bench_time_ns();
+    for (eos_u32_t i = 0; i < BENCH_EVENTS; i ++) {
+#if (EOS_USE_HSM_CACHE != 0)
+        if (cold == EOS_True) {
+            eos_sm_cache_clear();
+        }
+#else
+        (void)cold;
+#endif
+        eos_event_pub_topic(BENCH_TOPIC);
+        eos_once();
+    }
+    t = (eos_bench_time_ns() - t) / BENCH_EVENTS;
+    printf("%-8s %10.1f %10.1f %10.1f\n", name, t,
+           (double)bench_calls / BENCH_EVENTS, (double)bench_probes / BENCH_EVENTS);
+}
+#endif
+
+void eos_bench_hsm(void)
+{
+#if (EOS_USE_SM_MODE != 0 && EOS_USE_HSM_MODE != 0)
+    printf("\n[hsm] depth %u, %u transitions\n", BENCH_DEPTH, BENCH_EVENTS);
+    eos_set_time(0);
+    eos_init();
+    eos_sub_init(sub_table, Event_User + 2);
+    eos_sm_init(&bench_sm, 0, EOS_NULL);
+    eos_sm_start(&bench_sm, bench_init);
+    eos_event_sub(&bench_sm.super, BENCH_TOPIC);
+
+    printf("%-8s %10s %10s %10s\n", "engine", "ns", "calls", "probes");
+    bench_transitions("cold", EOS_True);
+#if (EOS_USE_HSM_CACHE != 0)
+    bench_transitions("warm", EOS_False);
+#endif
+
+#if (EOS_USE_SM_DESC != 0)
+    eos_init();
+    eos_sub_init(sub_table, Event_User + 2);
+    eos_dsm_init(&bench_dsm, 0, EOS_NULL);
+    eos_dsm_start(&bench_dsm, &BENCH_DESC_A);
+    eos_event_sub(&bench_dsm.super, BENCH_TOPIC);
+    bench_transitions("desc", EOS_False);
+#endif
+#endif
+}
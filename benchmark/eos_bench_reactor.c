@@ -0,0 +1,143 @@
+#include "eos_bench.h"
+#include "eos_test_def.h"
+#include <stdio.h>
+
+// Reactor的分发开销：一个Reactor处理BENCH_HANDLERS个稀疏的主题（分布在BENCH_RANGE个主题中），
+// 每个主题一个处理函数。每次随机发布其中一个主题的事件并调度。switch为在一个处理函数中switch
+// 主题，dense为覆盖整个范围的密集表，hash为散列表。bytes为主题处理表占用的字节数，switch的跳转
+// 是代码，不计入。
+
+#if (EOS_USE_REACTOR_TABLE != 0)
+#define BENCH_HANDLERS                      24
+#define BENCH_RANGE                         199
+#define BENCH_HASH                          32
+#define BENCH_EVENTS                        200000
+
+// 第k个主题，37与BENCH_RANGE互质，各主题互不相同
+#define BENCH_TOPIC(k)                      (Event_User + ((k) * 37) % BENCH_RANGE)
+
+static eos_mcu_t sub_table[Event_User + BENCH_RANGE];
+static eos_u32_t bench_calls[BENCH_HANDLERS];
+static eos_reactor_t bench_reactor[3];
+
+static eos_event_handler bench_dense_handler[BENCH_RANGE];
+static eos_reactor_table_t bench_dense;
+static eos_topic_t bench_hash_topic[BENCH_HASH];
+static eos_event_handler bench_hash_handler[BENCH_HASH];
+static eos_reactor_table_t bench_hash;
+
+#define BENCH_HANDLER(k_)                                                      \
+static void bench_h##k_(eos_reactor_t * const me, eos_event_t const * const e) \
+{                                                                              \
+    (void)me;                                                                  \
+    (void)e;                                                                   \
+    bench_calls[k_] ++;                                                        \
+}
+
+BENCH_HANDLER(0)  BENCH_HANDLER(1)  BENCH_HANDLER(2)  BENCH_HANDLER(3)
+BENCH_HANDLER(4)  BENCH_HANDLER(5)  BENCH_HANDLER(6)  BENCH_HANDLER(7)
+BENCH_HANDLER(8)  BENCH_HANDLER(9)  BENCH_HANDLER(10) BENCH_HANDLER(11)
+BENCH_HANDLER(12) BENCH_HANDLER(13) BENCH_HANDLER(14) BENCH_HANDLER(15)
+BENCH_HANDLER(16) BENCH_HANDLER(17) BENCH_HANDLER(18) BENCH_HANDLER(19)
+BENCH_HANDLER(20) BENCH_HANDLER(21) BENCH_HANDLER(22) BENCH_HANDLER(23)
+
+static const eos_event_handler bench_handlers[BENCH_HANDLERS] = {
+    bench_h0,  bench_h1,  bench_h2,  bench_h3,  bench_h4,  bench_h5,
+    bench_h6,  bench_h7,  bench_h8,  bench_h9,  bench_h10, bench_h11,
+    bench_h12, bench_h13, bench_h14, bench_h15, bench_h16, bench_h17,
+    bench_h18, bench_h19, bench_h20, bench_h21, bench_h22, bench_h23,
+};
+
+#define BENCH_CASE(k_)                                                         \
+        case BENCH_TOPIC(k_):                                                  \
+            bench_calls[k_] ++;                                                \
+            break;
+
+static void bench_switch(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+
+    switch (e->topic) {
+        BENCH_CASE(0)  BENCH_CASE(1)  BENCH_CASE(2)  BENCH_CASE(3)
+        BENCH_CASE(4)  BENCH_CASE(5)  BENCH_CASE(6)  BENCH_CASE(7)
+        BENCH_CASE(8)  BENCH_CASE(9)  BENCH_CASE(10) BENCH_CASE(11)
+        BENCH_CASE(12) BENCH_CASE(13) BENCH_CASE(14) BENCH_CASE(15)
+        BENCH_CASE(16) BENCH_CASE(17) BENCH_CASE(18) BENCH_CASE(19)
+        BENCH_CASE(20) BENCH_CASE(21) BENCH_CASE(22) BENCH_CASE(23)
+        default:
+            break;
+    }
+}
+
+static void bench_tables(void)
+{
+    for (eos_u32_t i = 0; i < BENCH_HASH; i ++) {
+        bench_hash_topic[i] = Event_Null;
+    }
+    for (eos_u32_t k = 0; k < BENCH_HANDLERS; k ++) {
+        bench_dense_handler[BENCH_TOPIC(k) - Event_User] = bench_handlers[k];
+        eos_reactor_table_add(bench_hash_topic, bench_hash_handler, BENCH_HASH,
+                              BENCH_TOPIC(k), bench_handlers[k]);
+    }
+    bench_dense = (eos_reactor_table_t) {
+        EOS_NULL, bench_dense_handler, EOS_NULL, Event_User, BENCH_RANGE
+    };
+    bench_hash = (eos_reactor_table_t) {
+        bench_hash_topic, bench_hash_handler, EOS_NULL, 0, BENCH_HASH
+    };
+}
+
+static void bench_events(const char *name, eos_u32_t bytes)
+{
+    eos_u32_t seed = 1;
+    eos_u32_t calls = 0;
+    for (eos_u32_t k = 0; k < BENCH_HANDLERS; k ++) {
+        bench_calls[k] = 0;
+    }
+    double t = eos_bench_time_ns();
+    for (eos_u32_t i = 0; i < BENCH_EVENTS; i ++) {
+        seed = seed * 1103515245 + 12345;
+        eos_event_pub_topic(BENCH_TOPIC((seed >> 16) % BENCH_HANDLERS));
+        eos_once();
+    }
+    t = (eos_bench_time_ns() - t) / BENCH_EVENTS;
+    for (eos_u32_t k = 0; k < BENCH_HANDLERS; k ++) {
+        calls += bench_calls[k];
+    }
+    printf("%-8s %10.1f %10.1f %10u\n", name, t, (double)calls / BENCH_EVENTS, bytes);
+}
+
+static void bench_start(eos_reactor_t *me, eos_reactor_table_t const *table)
+{
+    eos_set_time(0);
+    eos_init();
+    eos_sub_init(sub_table, Event_User + BENCH_RANGE);
+    eos_reactor_init(me, 0, EOS_NULL);
+    if (table == EOS_NULL) {
+        eos_reactor_start(me, bench_switch);
+    }
+    else {
+        eos_reactor_start_table(me, table);
+    }
+    for (eos_u32_t k = 0; k < BENCH_HANDLERS; k ++) {
+        eos_event_sub(&me->super, BENCH_TOPIC(k));
+    }
+}
+#endif
+
+void eos_bench_reactor(void)
+{
+#if (EOS_USE_REACTOR_TABLE != 0)
+    printf("\n[reactor] %u handlers in %u topics, %u events\n",
+           BENCH_HANDLERS, BENCH_RANGE, BENCH_EVENTS);
+    printf("%-8s %10s %10s %10s\n", "engine", "ns", "handled", "bytes");
+    bench_tables();
+
+    bench_start(&bench_reactor[0], EOS_NULL);
+    bench_events("switch", 0);
+    bench_start(&bench_reactor[1], &bench_dense);
+    bench_events("dense", BENCH_RANGE * sizeof(eos_event_handler));
+    bench_start(&bench_reactor[2], &bench_hash);
+    bench_events("hash", BENCH_HASH * (sizeof(eos_topic_t) + sizeof(eos_event_handler)));
+#endif
+}
@@ -0,0 +1,106 @@
+#include "eos_bench.h"
+#include "eos_test_def.h"
+#include <stdio.h>
+#include <stddef.h>
+
+// 正交区域与多个Actor的对比：BENCH_REGIONS个相互独立的部分，每个都在两个状态之间来回转移，分别
+// 用一个带正交区域的状态机与BENCH_REGIONS个状态机Actor实现。每发布一个事件，执行调度直至没有
+// 事件。passes为每个事件的调度次数（eos_once返回EosRun_OK的次数），bytes为状态机与区域占用的
+// 内存（多个Actor时不计eos_sm_t中正交区域的成员），slots为占用的优先级。
+
+#if (EOS_USE_SM_REGION != 0)
+#define BENCH_REGIONS                       EOS_MAX_ACTORS
+#define BENCH_TOPIC                         Event_User
+#define BENCH_EVENTS                        200000
+
+static eos_mcu_t sub_table[Event_User + 1];
+static eos_sm_t bench_sm;
+static eos_sm_t bench_actor[BENCH_REGIONS];
+static eos_region_t bench_region[BENCH_REGIONS - 1];
+
+static eos_ret_t bench_a(eos_sm_t * const me, eos_event_t const * const e);
+static eos_ret_t bench_b(eos_sm_t * const me, eos_event_t const * const e);
+
+static eos_ret_t bench_init(eos_sm_t * const me, eos_event_t const * const e)
+{
+    (void)e;
+
+    return EOS_TRAN(bench_a);
+}
+
+static eos_ret_t bench_a(eos_sm_t * const me, eos_event_t const * const e)
+{
+    switch (e->topic) {
+        case Event_Enter:
+        case Event_Exit:
+            return EOS_Ret_Handled;
+
+        case BENCH_TOPIC:
+            return EOS_TRAN(bench_b);
+
+        default:
+            return EOS_SUPER(eos_state_top);
+    }
+}
+
+static eos_ret_t bench_b(eos_sm_t * const me, eos_event_t const * const e)
+{
+    switch (e->topic) {
+        case Event_Enter:
+        case Event_Exit:
+            return EOS_Ret_Handled;
+
+        case BENCH_TOPIC:
+            return EOS_TRAN(bench_a);
+
+        default:
+            return EOS_SUPER(eos_state_top);
+    }
+}
+
+static void bench_events(const char *name, eos_u32_t bytes, eos_u32_t slots)
+{
+    eos_u32_t passes = 0;
+    double t = eos_bench_time_ns();
+    for (eos_u32_t i = 0; i < BENCH_EVENTS; i ++) {
+        eos_event_pub_topic(BENCH_TOPIC);
+        while (eos_once() == EosRun_OK) {
+            passes ++;
+        }
+    }
+    t = (eos_bench_time_ns() - t) / BENCH_EVENTS;
+    printf("%-8s %10.1f %10.1f %10u %10u\n", name, t, (double)passes / BENCH_EVENTS, bytes, slots);
+}
+#endif
+
+void eos_bench_region(void)
+{
+#if (EOS_USE_SM_REGION != 0)
+    printf("\n[region] %u independent parts, %u events\n", BENCH_REGIONS, BENCH_EVENTS);
+    printf("%-8s %10s %10s %10s %10s\n", "engine", "ns", "passes", "bytes", "slots");
+
+    // 一个Actor，其余的部分为正交区域
+    eos_set_time(0);
+    eos_init();
+    eos_sub_init(sub_table, Event_User + 1);
+    eos_sm_init(&bench_sm, 0, EOS_NULL);
+    eos_sm_region_init(&bench_sm, bench_region, BENCH_REGIONS - 1);
+    eos_sm_start(&bench_sm, bench_init);
+    for (eos_u8_t i = 1; i < BENCH_REGIONS; i ++) {
+        eos_sm_region_start(&bench_sm, i, bench_init);
+    }
+    eos_event_sub(&bench_sm.super, BENCH_TOPIC);
+    bench_events("region", sizeof(eos_sm_t) + sizeof(bench_region), 1);
+
+    // 每个部分一个Actor
+    eos_set_time(0);
+    eos_init();
+    eos_sub_init(sub_table, Event_User + 1);
+    for (eos_u8_t i = 0; i < BENCH_REGIONS; i ++) {
+        eos_sm_init(&bench_actor[i], i, EOS_NULL);
+        eos_sm_start(&bench_actor[i], bench_init);
+        eos_event_sub(&bench_actor[i].super, BENCH_TOPIC);
+    }
+    bench_events("actors", BENCH_REGIONS * offsetof(eos_sm_t, region), BENCH_REGIONS);
+#endif
+}
@@ -0,0 +1,131 @@
+#include "eos_bench.h"
+#include "eos_test_def.h"
+#include <stdio.h>
+
+// 定时器松弛与相位错开的效果：按空闲休眠的方式直接跳到下一个截止时刻，统计仿真时间内的
+// 唤醒次数、处理的事件数，以及单次唤醒中处理的事件数的峰值。
+// 注：时间轮的降级也需要唤醒，计入唤醒次数。
+
+#if (EOS_USE_TIMER_SLACK != 0)
+#define BENCH_TOPIC                         Event_User
+#define BENCH_TIMERS                        64
+#define BENCH_SIM_MS                        10000
+
+#if (EOS_MAX_TIME_EVENT < BENCH_TIMERS)
+#define BENCH_NUM                           EOS_MAX_TIME_EVENT
+#else
+#define BENCH_NUM                           BENCH_TIMERS
+#endif
+
+static const eos_u32_t bench_period[] = {
+    50, 100, 200, 500
+};
+
+static eos_mcu_t sub_table[Event_User + 1];
+static eos_reactor_t bench_reactor;
+static eos_timer_t bench_timer[BENCH_NUM];
+static eos_u32_t bench_start[BENCH_NUM];
+static eos_u32_t bench_period_ms[BENCH_NUM];
+static eos_u32_t bench_fired;
+
+static void bench_func(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    (void)e;
+    bench_fired ++;
+}
+
+static void bench_setup(void)
+{
+    eos_set_time(0);
+    eos_init();
+    eos_sub_init(sub_table, Event_User + 1);
+    eos_reactor_init(&bench_reactor, 0, EOS_NULL);
+    eos_reactor_start(&bench_reactor, bench_func);
+    eos_event_sub(&bench_reactor.super, BENCH_TOPIC);
+
+    // 各组对比使用相同的启动时刻与周期
+    eos_u32_t time = 0;
+    for (eos_u32_t i = 0; i < BENCH_NUM; i ++) {
+        time += (eos_bench_rand() % 7) + 1;
+        bench_start[i] = time;
+        bench_period_ms[i] = bench_period[eos_bench_rand() % 4];
+    }
+}
+
+static void bench_run_to(eos_u32_t time_ms)
+{
+    eos_tick_advance((eos_u32_t)(time_ms - eos_time()));
+    while (eos_once() == EosRun_OK) {
+    }
+}
+
+// 仿真BENCH_SIM_MS毫秒，每次唤醒处理完所有的事件。
+static void bench_sim(char const *name)
+{
+    eos_u32_t wakeups = 0, peak = 0;
+    eos_time_t end = eos_time() + BENCH_SIM_MS;
+
+    bench_fired = 0;
+    while (1) {
+        eos_u32_t time_ms = eos_time_deadline();
+        if (time_ms == EOS_U32_MAX || (eos_time() + time_ms) > end)
+            break;
+        eos_tick_advance(time_ms);
+        wakeups ++;
+
+        eos_u32_t fired = bench_fired;
+        while (eos_once() == EosRun_OK) {
+        }
+        if (peak < (bench_fired - fired)) {
+            peak = bench_fired - fired;
+        }
+    }
+
+    printf("%-24s %10u %10u %10u\n", name, wakeups, bench_fired, peak);
+    for (eos_u32_t i = 0; i < BENCH_NUM; i ++) {
+        eos_timer_cancel(bench_timer[i]);
+    }
+}
+
+// 任意相位的周期定时器，松弛量为周期的slack_div分之一（0表示不设松弛量）。
+static void bench_random(char const *name, eos_u32_t slack_div)
+{
+    eos_set_time(0);
+    for (eos_u32_t i = 0; i < BENCH_NUM; i ++) {
+        bench_run_to(bench_start[i]);
+        bench_timer[i] = eos_timer_period(BENCH_TOPIC, bench_period_ms[i]);
+        if (slack_div != 0) {
+            eos_timer_set_slack(bench_timer[i], bench_period_ms[i] / slack_div);
+        }
+    }
+    bench_sim(name);
+}
+
+// 同时启动的相同周期的定时器
+static void bench_burst(char const *name, eos_bool_t stagger)
+{
+    eos_set_time(0);
+    for (eos_u32_t i = 0; i < BENCH_NUM; i ++) {
+        bench_timer[i] = eos_timer_period(BENCH_TOPIC, 100);
+        if (stagger == EOS_True) {
+            eos_timer_stagger(bench_timer[i]);
+        }
+    }
+    bench_sim(name);
+}
+#endif
+
+void eos_bench_slack(void)
+{
+#if (EOS_USE_TIMER_SLACK != 0)
+    printf("\n[slack] %u periodic timers, %u ms simulated\n", BENCH_NUM, BENCH_SIM_MS);
+    printf("%-24s %10s %10s %10s\n", "case", "wakeups", "events", "peak");
+    bench_setup();
+    bench_random("random phase", 0);
+    bench_random("random, slack 1/16", 16);
+    bench_random("random, slack 1/4", 4);
+    bench_burst("burst 100ms", EOS_False);
+    bench_burst("burst 100ms, stagger", EOS_True);
+#endif
+}
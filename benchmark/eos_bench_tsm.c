@@ -0,0 +1,223 @@
+#include "eos_bench.h"
+#include "eos_test_def.h"
+#include <stdio.h>
+
+// 平面状态机的分发开销：模拟一个40个状态、30个主题的协议解析器，每个状态处理3个主题，分别转移到
+// 其后的第1~3个状态。每次沿当前状态的有效主题随机发布一个事件。sm为每个状态一个switch状态函数的
+// 状态机，每次转移还要调用退出与进入；dense与sparse为同一个转移表的密集表与稀疏表，bytes为转移表
+// （next、action与稀疏表的base、check）占用的字节数，sm的状态函数是代码，不计入。
+
+#if (EOS_USE_SM_TABLE != 0)
+#define BENCH_STATES                        40
+#define BENCH_TOPICS                        30
+#define BENCH_WIDTH                         3
+#define BENCH_EVENTS                        200000
+
+// 状态s的第k个主题与目标状态
+#define BENCH_TOPIC(s, k)                   (((s) * 7 + (k) * 11) % BENCH_TOPICS)
+#define BENCH_NEXT(s, k)                    (((s) + (k) + 1) % BENCH_STATES)
+
+static eos_mcu_t sub_table[Event_User + BENCH_TOPICS];
+static eos_u8_t bench_state;
+static eos_u32_t bench_calls;
+
+static eos_u8_t bench_dense_next[BENCH_STATES * BENCH_TOPICS];
+static eos_tsm_action bench_dense_action[BENCH_STATES * BENCH_TOPICS];
+static eos_u8_t bench_sparse_next[BENCH_STATES * BENCH_WIDTH + BENCH_TOPICS];
+static eos_tsm_action bench_sparse_action[BENCH_STATES * BENCH_WIDTH + BENCH_TOPICS];
+static eos_u16_t bench_sparse_base[BENCH_STATES];
+static eos_u8_t bench_sparse_check[BENCH_STATES * BENCH_WIDTH + BENCH_TOPICS];
+static eos_tsm_table_t bench_dense;
+static eos_tsm_table_t bench_sparse;
+static eos_tsm_t bench_tsm[2];
+
+static void bench_action(eos_tsm_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    (void)e;
+    bench_calls ++;
+}
+
+static eos_bool_t bench_fits(eos_u32_t base, eos_u32_t s)
+{
+    for (eos_u32_t k = 0; k < BENCH_WIDTH; k ++) {
+        if (bench_sparse_check[base + BENCH_TOPIC(s, k)] != EOS_TSM_NONE)
+            return EOS_False;
+    }
+
+    return EOS_True;
+}
+
+// 按行位移压缩，与tools/tsm_pack.py相同：每一行取第一个不冲突的位置。
+static eos_u32_t bench_pack(void)
+{
+    eos_u32_t size = 0;
+
+    for (eos_u32_t i = 0; i < sizeof(bench_sparse_check); i ++) {
+        bench_sparse_next[i] = EOS_TSM_NONE;
+        bench_sparse_check[i] = EOS_TSM_NONE;
+    }
+    for (eos_u32_t s = 0; s < BENCH_STATES; s ++) {
+        eos_u32_t b = 0;
+        while (bench_fits(b, s) == EOS_False) {
+            b ++;
+        }
+        bench_sparse_base[s] = (eos_u16_t)b;
+        for (eos_u32_t k = 0; k < BENCH_WIDTH; k ++) {
+            bench_sparse_next[b + BENCH_TOPIC(s, k)] = BENCH_NEXT(s, k);
+            bench_sparse_action[b + BENCH_TOPIC(s, k)] = bench_action;
+            bench_sparse_check[b + BENCH_TOPIC(s, k)] = (eos_u8_t)s;
+        }
+        if (size < b + BENCH_TOPICS) {
+            size = b + BENCH_TOPICS;
+        }
+    }
+
+    return size;
+}
+
+static void bench_tables(void)
+{
+    for (eos_u32_t i = 0; i < BENCH_STATES * BENCH_TOPICS; i ++) {
+        bench_dense_next[i] = EOS_TSM_NONE;
+    }
+    for (eos_u32_t s = 0; s < BENCH_STATES; s ++) {
+        for (eos_u32_t k = 0; k < BENCH_WIDTH; k ++) {
+            bench_dense_next[s * BENCH_TOPICS + BENCH_TOPIC(s, k)] = BENCH_NEXT(s, k);
+            bench_dense_action[s * BENCH_TOPICS + BENCH_TOPIC(s, k)] = bench_action;
+        }
+    }
+    bench_dense = (eos_tsm_table_t) {
+        bench_dense_next, bench_dense_action, EOS_NULL, EOS_NULL, EOS_NULL, EOS_NULL,
+        BENCH_STATES * BENCH_TOPICS, BENCH_STATES, Event_User, BENCH_TOPICS,
+#if (EOS_USE_STATE_SUB != 0)
+        EOS_NULL,
+#endif
+    };
+    bench_sparse = (eos_tsm_table_t) {
+        bench_sparse_next, bench_sparse_action, bench_sparse_base, bench_sparse_check,
+        EOS_NULL, EOS_NULL,
+        (eos_u16_t)bench_pack(), BENCH_STATES, Event_User, BENCH_TOPICS,
+#if (EOS_USE_STATE_SUB != 0)
+        EOS_NULL,
+#endif
+    };
+}
+
+#if (EOS_USE_SM_MODE != 0)
+static eos_sm_t bench_sm;
+static eos_state_handler bench_states[BENCH_STATES];
+
+#define BENCH_CASE(n_, k_)                                                     \
+        case Event_User + BENCH_TOPIC(n_, k_):                                 \
+            bench_calls ++;                                                    \
+            bench_state = BENCH_NEXT(n_, k_);                                  \
+            return EOS_TRAN(bench_states[BENCH_NEXT(n_, k_)]);
+
+#define BENCH_STATE(n_)                                                        \
+static eos_ret_t bench_s##n_(eos_sm_t * const me, eos_event_t const * const e) \
+{                                                                              \
+    switch (e->topic) {                                                        \
+        case Event_Enter:                                                      \
+        case Event_Exit:                                                       \
+            return EOS_Ret_Handled;                                            \
+        BENCH_CASE(n_, 0)                                                      \
+        BENCH_CASE(n_, 1)                                                      \
+        BENCH_CASE(n_, 2)                                                      \
+        default:                                                               \
+            return EOS_SUPER(eos_state_top);                                   \
+    }                                                                          \
+}
+
+BENCH_STATE(0)  BENCH_STATE(1)  BENCH_STATE(2)  BENCH_STATE(3)  BENCH_STATE(4)
+BENCH_STATE(5)  BENCH_STATE(6)  BENCH_STATE(7)  BENCH_STATE(8)  BENCH_STATE(9)
+BENCH_STATE(10) BENCH_STATE(11) BENCH_STATE(12) BENCH_STATE(13) BENCH_STATE(14)
+BENCH_STATE(15) BENCH_STATE(16) BENCH_STATE(17) BENCH_STATE(18) BENCH_STATE(19)
+BENCH_STATE(20) BENCH_STATE(21) BENCH_STATE(22) BENCH_STATE(23) BENCH_STATE(24)
+BENCH_STATE(25) BENCH_STATE(26) BENCH_STATE(27) BENCH_STATE(28) BENCH_STATE(29)
+BENCH_STATE(30) BENCH_STATE(31) BENCH_STATE(32) BENCH_STATE(33) BENCH_STATE(34)
+BENCH_STATE(35) BENCH_STATE(36) BENCH_STATE(37) BENCH_STATE(38) BENCH_STATE(39)
+
+static eos_state_handler bench_states[BENCH_STATES] = {
+    (eos_state_handler)bench_s0,  (eos_state_handler)bench_s1,  (eos_state_handler)bench_s2,
+    (eos_state_handler)bench_s3,  (eos_state_handler)bench_s4,  (eos_state_handler)bench_s5,
+    (eos_state_handler)bench_s6,  (eos_state_handler)bench_s7,  (eos_state_handler)bench_s8,
+    (eos_state_handler)bench_s9,  (eos_state_handler)bench_s10, (eos_state_handler)bench_s11,
+    (eos_state_handler)bench_s12, (eos_state_handler)bench_s13, (eos_state_handler)bench_s14,
+    (eos_state_handler)bench_s15, (eos_state_handler)bench_s16, (eos_state_handler)bench_s17,
+    (eos_state_handler)bench_s18, (eos_state_handler)bench_s19, (eos_state_handler)bench_s20,
+    (eos_state_handler)bench_s21, (eos_state_handler)bench_s22, (eos_state_handler)bench_s23,
+    (eos_state_handler)bench_s24, (eos_state_handler)bench_s25, (eos_state_handler)bench_s26,
+    (eos_state_handler)bench_s27, (eos_state_handler)bench_s28, (eos_state_handler)bench_s29,
+    (eos_state_handler)bench_s30, (eos_state_handler)bench_s31, (eos_state_handler)bench_s32,
+    (eos_state_handler)bench_s33, (eos_state_handler)bench_s34, (eos_state_handler)bench_s35,
+    (eos_state_handler)bench_s36, (eos_state_handler)bench_s37, (eos_state_handler)bench_s38,
+    (eos_state_handler)bench_s39,
+};
+
+static eos_ret_t bench_init(eos_sm_t * const me, eos_event_t const * const e)
+{
+    (void)e;
+
+    return EOS_TRAN(bench_s0);
+}
+#endif
+
+// 沿当前状态的有效主题发布事件，state为被测状态机的当前状态。
+static void bench_events(const char *name, eos_u8_t const *state, eos_u32_t bytes)
+{
+    eos_u32_t seed = 1;
+    bench_calls = 0;
+    double t = eos_bench_time_ns();
+    for (eos_u32_t i = 0; i < BENCH_EVENTS; i ++) {
+        seed = seed * 1103515245 + 12345;
+        eos_event_pub_topic(Event_User + BENCH_TOPIC(*state, (seed >> 16) % BENCH_WIDTH));
+        eos_once();
+    }
+    t = (eos_bench_time_ns() - t) / BENCH_EVENTS;
+    printf("%-8s %10.1f %10.1f %10u\n", name, t, (double)bench_calls / BENCH_EVENTS, bytes);
+}
+
+static void bench_start(eos_actor_t *actor)
+{
+    for (eos_u32_t i = 0; i < BENCH_TOPICS; i ++) {
+        eos_event_sub(actor, Event_User + i);
+    }
+}
+#endif
+
+void eos_bench_tsm(void)
+{
+#if (EOS_USE_SM_TABLE != 0)
+    printf("\n[tsm] %u states x %u topics, %u events\n", BENCH_STATES, BENCH_TOPICS, BENCH_EVENTS);
+    printf("%-8s %10s %10s %10s\n", "engine", "ns", "handled", "bytes");
+    bench_tables();
+
+#if (EOS_USE_SM_MODE != 0)
+    eos_set_time(0);
+    eos_init();
+    eos_sub_init(sub_table, Event_User + BENCH_TOPICS);
+    eos_sm_init(&bench_sm, 0, EOS_NULL);
+    eos_sm_start(&bench_sm, bench_init);
+    bench_start(&bench_sm.super);
+    bench_state = 0;
+    bench_events("sm", &bench_state, 0);
+#endif
+
+    eos_tsm_table_t const *table[2] = { &bench_dense, &bench_sparse };
+    const char *name[2] = { "dense", "sparse" };
+    for (eos_u32_t i = 0; i < 2; i ++) {
+        eos_u32_t bytes = table[i]->size * (sizeof(eos_u8_t) + sizeof(eos_tsm_action));
+        if (table[i]->base != EOS_NULL) {
+            bytes += table[i]->size * sizeof(eos_u8_t) + BENCH_STATES * sizeof(eos_u16_t);
+        }
+        eos_set_time(0);
+        eos_init();
+        eos_sub_init(sub_table, Event_User + BENCH_TOPICS);
+        eos_tsm_init(&bench_tsm[i], 0, EOS_NULL);
+        eos_tsm_start(&bench_tsm[i], table[i], 0);
+        bench_start(&bench_tsm[i].super);
+        bench_events(name[i], &bench_tsm[i].state, bytes);
+    }
+#endif
+}
@@ -0,0 +1,58 @@
+#include "eventos.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <time.h>
+
+#if (EOS_USE_HRTIMER != 0)
+eos_u32_t eos_port_hrtime(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (eos_u32_t)(((unsigned long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000) /
+                       EOS_HRTIMER_RES_US);
+}
+#endif
+
+void eos_port_critical_enter(void)
+{
+    // NULL
+}
+
+void eos_port_critical_exit(void)
+{
+    // NULL
+}
+
+void eos_hook_idle(void)
+{
+
+}
+
+void eos_hook_start(void)
+{
+
+}
+
+void eos_hook_stop(void)
+{
+
+}
+
+#if (EOS_USE_TICKLESS != 0)
+void eos_hook_wakeup(void)
+{
+
+}
+#endif
+
+void eos_port_assert(eos_u32_t error_id)
+{
+    printf("------------------------------------\n");
+    printf("ASSERT >>> Module: EventOS Nano, ErrorId: %d.\n", error_id);
+    printf("------------------------------------\n");
+
+    while (1) {
+        usleep(100000);
+    }
+}
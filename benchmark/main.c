@@ -0,0 +1,39 @@
+#include "eos_bench.h"
+#include <time.h>
+#include <stdio.h>
+
+// 性能测试程序，在PC上运行，输出各项操作的平均耗时。
+// 注：benchmark/eos_config_user.h中的配置（如EOS_USE_TIMER_WHEEL）决定了被测试的实现。
+
+static eos_u32_t bench_seed = 1;
+
+eos_u32_t eos_bench_rand(void)
+{
+    bench_seed = bench_seed * 1103515245 + 12345;
+    return (bench_seed >> 8);
+}
+
+double eos_bench_time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec * 1000000000.0 + (double)ts.tv_nsec;
+}
+
+int main(void)
+{
+    printf("EventOS Nano benchmark\n");
+
+    eos_bench_etimer();
+    eos_bench_slack();
+    eos_bench_coroutine();
+    eos_bench_hsm();
+    eos_bench_tsm();
+    eos_bench_region();
+    eos_bench_reactor();
+    eos_bench_batch();
+    eos_bench_edf();
+
+    return 0;
+}
@@ -53,7 +53,9 @@ extern "C" {
 // eos define ------------------------------------------------------------------
 enum eos_actor_mode {
     EOS_Mode_Reactor = 0,
-    EOS_Mode_StateMachine = !EOS_Mode_Reactor
+    EOS_Mode_StateMachine,
+    EOS_Mode_Descriptor,                    // state machine driven by descriptor tables
+    EOS_Mode_Table,                         // flat state machine driven by a transition table
 };
 
 // **eos** ---------------------------------------------------------------------
@@ -87,7 +89,7 @@ enum {
     EosTimerUnit_Ms                         = 0,    // 60S, ms
     EosTimerUnit_100Ms,                             // 100Min, 50ms
     EosTimerUnit_Sec,                               // 16h, 500ms
-    EosTimerUnit_Minute,                            // 15day, 30S
+    EosTimerUnit_Minute,                            // 15day (45day in 64-bit time), 30S
 
     EosTimerUnit_Max
 };
@@ -96,7 +98,11 @@ static const eos_u32_t timer_threshold[EosTimerUnit_Max] = {
     60000,                                          // 60 S
     6000000,                                        // 100 Minutes
     57600000,                                       // 16 hours
+#if (EOS_USE_TIME_64BIT != 0)
+    3932100000,                                     // 65535 minutes, about 45 days
+#else
     1296000000,                                     // 15 days
+#endif
 };
 
 static const eos_u32_t timer_unit[EosTimerUnit_Max] = {
@@ -108,14 +114,66 @@ typedef struct eos_event_timer {
     eos_u32_t oneshoot                      : 1;
     eos_u32_t unit                          : 2;
     eos_u32_t period                        : 16;
-    eos_u32_t timeout_ms;
+    eos_time_t timeout_ms;
+#if (EOS_USE_TIMER_WHEEL != 0)
+    eos_u16_t next;                                 // list of the wheel slot
+    eos_u16_t last;
+    eos_u16_t slot;                                 // level * EOS_WHEEL_SIZE + index
+#endif
+#if (EOS_USE_TIMER_HANDLE != 0)
+    eos_u16_t id;                                   // index of timer_handle[]
+#endif
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+    eos_u16_t data;                                 // event block in the heap, or EOS_HEAP_MAX
+    eos_u8_t actor;                                 // priority of the receiver, or EOS_MAX_ACTORS
+#endif
+#if (EOS_USE_TIMER_EXACT != 0)
+    eos_u8_t catchup;                               // EosTimerCatchUp_xxx
+    eos_u32_t period_ms;                            // exact period, not quantized by the unit
+    eos_timer_stats_t stats;
+#endif
+#if (EOS_USE_TIMER_SLACK != 0)
+    eos_u16_t slack;                                // tolerance after the nominal deadline
+    eos_u16_t shift;                                // timeout_ms - nominal deadline
+#endif
 } eos_event_timer_t;
+
+#if (EOS_USE_TIMER_HANDLE != 0)
+#define EOS_TIMER_NONE                      0xffff
+
+// handle = (seq << 16) | id, id locates the timer in etimer[] through timer_handle[].
+typedef struct eos_timer_handle {
+    eos_u16_t index;                                // index of etimer[], or the next free id
+    eos_u16_t seq;                                  // changed when the id is released, never 0
+} eos_timer_handle_t;
+#endif
+
+#if (EOS_USE_HRTIMER != 0)
+// timeout and period are in counts of eos_port_hrtime(), compared wrap-safely.
+typedef struct eos_hrtimer {
+    eos_u32_t timeout;
+    eos_u32_t period;                               // 0 means oneshoot
+    eos_topic_t topic;
+} eos_hrtimer_t;
+#endif
+
+#if (EOS_USE_TIMER_WHEEL != 0)
+#define EOS_WHEEL_BITS                      5
+#define EOS_WHEEL_SIZE                      (1 << EOS_WHEEL_BITS)
+#define EOS_WHEEL_MASK                      (EOS_WHEEL_SIZE - 1)
+#define EOS_WHEEL_LEVEL                     6       // 32^6 ms, about 12 days
+#define EOS_WHEEL_DUE                       (EOS_WHEEL_LEVEL * EOS_WHEEL_SIZE)
+#define EOS_WHEEL_NONE                      0xffff
+#endif
 #endif
 
 typedef struct eos_block {
     // word[0]
     eos_u32_t next                          : 15;
     eos_u32_t q_next                        : 15;
+#if (EOS_USE_EVENT_BLOCK != 0)
+    eos_u32_t urgent                        : 1;    // delivered to blocked actors too
+#endif
     // word[1]
     eos_u32_t last                          : 15;
     eos_u32_t q_last                        : 15;
@@ -123,13 +181,74 @@ typedef struct eos_block {
     // word[2]
     eos_u16_t size                          : 15;
     eos_u32_t offset                        : 8;
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+    eos_u32_t pinned                        : 1;    // held by a time event
+    eos_u32_t queued                        : 1;    // in the event queue
+#endif
 } eos_block_t;
 
+// The event id is used by requests, and by events sent to one actor directly.
+#if (EOS_USE_REQUEST != 0 || EOS_USE_TIMER_PAYLOAD != 0 || EOS_USE_DELAY != 0)
+#define EOS_USE_EVENT_ID                    1
+#else
+#define EOS_USE_EVENT_ID                    0
+#endif
+
 typedef struct eos_event_inner {
     eos_sub_t sub;
     eos_topic_t topic;
+#if (EOS_USE_EVENT_ID != 0)
+    eos_u16_t id;                                   // bit15: sent to one actor directly
+#endif
+#if (EOS_USE_EDF != 0)
+    eos_time_t deadline;                            // absolute, EOS_TIME_MAX for none
+#endif
 } eos_event_inner_t;
 
+#if (EOS_USE_EVENT_ID != 0)
+#define EOS_EVENT_ID_DIRECT                 0x8000
+#endif
+
+#if (EOS_USE_REQUEST != 0)
+#define EOS_REQUEST_ID_SEQ_MAX              0x7f
+#define EOS_REQUEST_NONE                    0xff
+
+// id = (seq(7bit) << 8) | slot(8bit), so a reply locates its slot in O(1).
+typedef struct eos_request {
+    eos_time_t timeout_ms;
+    eos_topic_t topic_timeout;
+    eos_u16_t id;                                   // 0 means the slot is free
+    eos_u8_t priority;                              // priority of the requester
+    eos_u8_t next;                                  // free list
+} eos_request_t;
+#endif
+
+#if (EOS_USE_TOPIC_FILTER != 0)
+// The last suppressed event is kept in the filter itself, not in the heap.
+typedef struct eos_filter {
+    eos_time_t timeout_ms;                          // end of the quiet time or the window
+    eos_u32_t interval_ms;
+    eos_topic_t topic;                              // Event_Null means the slot is free
+    eos_u8_t mode;                                  // EosFilter_xxx
+    eos_u8_t active;                                // timeout_ms is valid
+    eos_u8_t pending;                               // an event is held
+#if (EOS_USE_EVENT_DATA != 0)
+    eos_u8_t size;
+    eos_u8_t data[EOS_TOPIC_FILTER_DATA];
+#endif
+} eos_filter_t;
+#endif
+
+#if (EOS_USE_HSM_CACHE != 0)
+// A transition exits up to the LCA and enters down to the target. Keeping the LCA only,
+// the size does not depend on the nesting depth.
+typedef struct eos_hsm_tran {
+    eos_state_handler source;                       // EOS_NULL means the slot is free
+    eos_state_handler target;
+    eos_state_handler lca;
+} eos_hsm_tran_t;
+#endif
+
 typedef struct eos_heap {
 #if (EOS_USE_MAGIC != 0)
     eos_u32_t magic;
@@ -145,6 +264,14 @@ typedef struct eos_heap {
     // word[2]
     eos_sub_t sub_general;
     eos_sub_t count;
+#if (EOS_USE_EVENT_BLOCK != 0)
+    eos_sub_t sub_blocked;                          // actors holding back their events
+    eos_sub_t sub_urgent;                           // actors with urgent events in queue
+#endif
+#if (EOS_USE_EDF != 0)
+    eos_time_t deadline[EOS_MAX_ACTORS];            // the earliest deadline of each actor's events
+    eos_u16_t deadline_num[EOS_MAX_ACTORS];         // number of the actor's events due at it
+#endif
 } eos_heap_t;
 
 typedef struct eos_tag {
@@ -163,11 +290,76 @@ typedef struct eos_tag {
     eos_heap_t heap;
 #endif
 
+#if (EOS_USE_HSM_CACHE != 0)
+    eos_state_handler hsm_state[EOS_HSM_CACHE_STATE];         // direct mapped, keyed by the state
+    eos_state_handler hsm_super[EOS_HSM_CACHE_STATE];
+    eos_hsm_tran_t hsm_tran[EOS_HSM_CACHE_TRAN];              // keyed by (source, target)
+#endif
+
 #if (EOS_USE_TIME_EVENT != 0)
     eos_event_timer_t etimer[EOS_MAX_TIME_EVENT];
-    eos_u32_t time;
-    eos_u32_t timeout_min;
-    eos_u8_t timer_count;
+    eos_time_t time;
+    eos_time_t timeout_min;
+    eos_u16_t timer_count;
+#if (EOS_USE_TIMER_WHEEL != 0)
+    eos_u16_t wheel[EOS_WHEEL_DUE + 1];                       // slot heads, the last is the due list
+    eos_u32_t wheel_map[EOS_WHEEL_LEVEL];                     // bitmap of non-empty slots
+    eos_time_t wheel_time;                                    // the time before it is processed
+#endif
+#if (EOS_USE_TIMER_HANDLE != 0)
+    eos_timer_handle_t timer_handle[EOS_MAX_TIME_EVENT];
+    eos_u16_t timer_free;                                     // free list of handle ids
+#endif
+#if (EOS_USE_TIMER_SLACK != 0)
+    eos_u32_t timer_phase;                                    // golden ratio sequence of stagger
+#endif
+#endif
+
+#if (EOS_USE_HRTIMER != 0)
+    eos_hrtimer_t hrtimer[EOS_MAX_HRTIMER];
+    eos_u32_t hrtimer_next;                                   // the earliest timeout
+    eos_u8_t hrtimer_count;
+#endif
+
+#if (EOS_USE_REQUEST != 0)
+    eos_request_t request[EOS_MAX_REQUEST];
+    eos_time_t request_timeout_min;
+    eos_u8_t request_count;
+    eos_u8_t request_free;
+    eos_u8_t request_seq;
+#endif
+
+#if (EOS_USE_DELAY != 0)
+    eos_time_t delay_timeout[EOS_MAX_ACTORS];
+    eos_time_t delay_timeout_min;
+    eos_sub_t delay_actor;                                    // actors waiting for a delay
+    eos_u8_t actor_current;                                   // the running actor, or EOS_MAX_ACTORS
+#endif
+
+#if (EOS_USE_TOPIC_FILTER != 0)
+    eos_filter_t filter[EOS_MAX_TOPIC_FILTER];
+    eos_time_t filter_timeout_min;
+    eos_u8_t filter_count;
+#endif
+
+#if (EOS_USE_EVENT_BLOCK != 0)
+    eos_topic_t unblocked[EOS_MAX_UNBLOCKED];
+    eos_u8_t unblocked_count;
+#if (EOS_USE_DELAY != 0)
+    eos_sub_t delay_unblock;                                  // unblocked when the delay ends
+#endif
+#endif
+
+#if (EOS_USE_EDF != 0)
+    eos_u16_t *deadline;                                      // relative deadline of each topic
+    eos_topic_t deadline_count;
+    eos_deadline_stats_t deadline_stats[EOS_MAX_ACTORS];
+#endif
+
+#if (EOS_USE_PREEMPT != 0)
+    eos_s8_t prio_ceiling;                                    // only actors above it may run, -1 when idle
+    eos_s8_t ceiling_sm;                                      // the highest state machine, sharing the cache
+    eos_u8_t isr_nest;                                        // nesting of the interrupts
 #endif
 
     eos_u8_t enabled                        : 1;
@@ -180,19 +372,24 @@ eos_s8_t eos_once(void);
 eos_s8_t eos_event_pub_ret(eos_topic_t topic, void *data, eos_u32_t size);
 void * eos_get_framework(void);
 void eos_event_pub_time(eos_topic_t topic, eos_u32_t time_ms, eos_bool_t oneshoot);
-void eos_set_time(eos_u32_t time_ms);
+void eos_set_time(eos_time_t time_ms);
 // **eos end** -----------------------------------------------------------------
 
 static eos_t eos;
 
 // data ------------------------------------------------------------------------
 #if (EOS_USE_SM_MODE != 0)
+#if (EOS_USE_REQUEST != 0)
+#define EOS_EVENT_SYS(_topic)               { _topic, EOS_NULL, 0, 0 }
+#else
+#define EOS_EVENT_SYS(_topic)               { _topic, EOS_NULL, 0 }
+#endif
 static const eos_event_t eos_event_table[Event_User] = {
-    {Event_Null, 0},
-    {Event_Enter, 0},
-    {Event_Exit, 0},
+    EOS_EVENT_SYS(Event_Null),
+    EOS_EVENT_SYS(Event_Enter),
+    EOS_EVENT_SYS(Event_Exit),
 #if (EOS_USE_HSM_MODE != 0)
-    {Event_Init, 0},
+    EOS_EVENT_SYS(Event_Init),
 #endif
 };
 #endif
@@ -206,23 +403,136 @@ static const eos_event_t eos_event_table[Event_User] = {
 // static function -------------------------------------------------------------
 #if (EOS_USE_SM_MODE != 0)
 static void eos_sm_dispath(eos_sm_t * const me, eos_event_t const * const e);
+static void eos_sm_start_state(eos_sm_t * const me, eos_state_handler state_init);
+#if (EOS_USE_SM_REGION != 0)
+static void eos_sm_dispath_state(eos_sm_t * const me, eos_event_t const * const e);
+#endif
 #if (EOS_USE_HSM_MODE != 0)
-static eos_s32_t eos_sm_tran(eos_sm_t * const me, eos_state_handler path[EOS_MAX_HSM_NEST_DEPTH]);
+static eos_state_handler eos_sm_super(eos_sm_t * const me, eos_state_handler state);
+static void eos_sm_enter(eos_sm_t * const me, eos_state_handler t, eos_state_handler target);
+static void eos_sm_tran(eos_sm_t * const me, eos_state_handler s, eos_state_handler target);
+#endif
+#endif
+#if (EOS_USE_SM_DESC != 0)
+static void eos_dsm_dispath(eos_dsm_t * const me, eos_event_t const * const e);
+#endif
+#if (EOS_USE_SM_TABLE != 0)
+static void eos_tsm_dispath(eos_tsm_t * const me, eos_event_t const * const e);
+#endif
+#if (EOS_USE_REACTOR_TABLE != 0)
+static eos_event_handler eos_reactor_handler(eos_reactor_table_t const *table, eos_topic_t topic);
+#endif
+static eos_s8_t eos_once_dispatch(void);
+static eos_s8_t eos_once_event(eos_actor_t * const actor, eos_u8_t priority, eos_event_inner_t *e);
+static eos_s8_t eos_event_pub_id(eos_topic_t topic, eos_u16_t id, void *data, eos_u32_t size);
+#if (EOS_USE_EDF == 0 || EOS_USE_EVENT_ID != 0)
+static eos_s8_t eos_event_put(  eos_topic_t topic, eos_sub_t sub, eos_u16_t id,
+                                void *data, eos_u32_t size);
+#endif
+#if (EOS_USE_EDF != 0)
+static eos_s8_t eos_event_pub_edf(  eos_topic_t topic, eos_u16_t id, void *data, eos_u32_t size,
+                                    eos_u32_t deadline_ms);
+static eos_s8_t eos_event_put_edf(  eos_topic_t topic, eos_sub_t sub, eos_u16_t id,
+                                    void *data, eos_u32_t size, eos_u32_t deadline_ms);
+static eos_u32_t eos_topic_deadline_get(eos_topic_t topic);
+static eos_time_t eos_deadline_abs(eos_u32_t deadline_ms);
+static void eos_deadline_queue(eos_event_inner_t const *e, eos_sub_t sub);
+static void eos_deadline_count(eos_u8_t priority, eos_time_t deadline);
+#if (EOS_USE_TIME_64BIT == 0)
+static void eos_deadline_rebase(eos_u32_t offset);
+#endif
 #endif
+#if (EOS_USE_REQUEST != 0)
+static void eos_request_clear(void);
+static void eos_evtrequest(void);
+#endif
+#if (EOS_USE_DELAY != 0)
+static void eos_delay_clear(void);
+static void eos_evtdelay(void);
+#endif
+#if (EOS_USE_TOPIC_FILTER != 0)
+static void eos_filter_clear(void);
+static eos_bool_t eos_filter_input(eos_topic_t topic, void *data, eos_u32_t size);
+static void eos_evtfilter(void);
+#endif
+#if (EOS_USE_EVENT_BLOCK != 0)
+static void eos_block_clear(void);
+static eos_bool_t eos_event_unblocked(eos_topic_t topic);
+#endif
+#if (EOS_USE_HSM_CACHE != 0)
+static void eos_sm_cache_reset(void);
+#endif
+#if (EOS_USE_TIMER_HANDLE != 0)
+static void eos_timer_handle_clear(void);
+#endif
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+static void eos_etimer_data_release(eos_u16_t index);
+#endif
+#if (EOS_USE_TIMER_WHEEL != 0)
+static void eos_wheel_rebuild(eos_time_t time);
+static void eos_wheel_link(eos_u16_t index);
+static void eos_wheel_unlink(eos_u16_t index);
+static void eos_wheel_remove(eos_u16_t index);
+static eos_time_t eos_wheel_next(void);
+static void eos_wheel_advance(eos_time_t system_time);
+#endif
+#if (EOS_USE_HRTIMER != 0)
+static void eos_evthrtimer(void);
+static void eos_hrtimer_cancel(eos_topic_t topic);
 #endif
 #if (EOS_USE_EVENT_DATA != 0)
 void eos_heap_init(eos_heap_t * const me);
 void * eos_heap_malloc(eos_heap_t * const me, eos_u32_t size);
+void * eos_heap_alloc(eos_heap_t * const me, eos_u32_t size);
+void eos_heap_queue(eos_heap_t * const me, void *data);
 void eos_heap_free(eos_heap_t * const me, void * data);
 void *eos_heap_get_block(eos_heap_t * const me, eos_u8_t priority);
 void eos_heap_gc(eos_heap_t * const me, void *data);
+static void eos_heap_release(eos_heap_t * const me, void *data);
+static void eos_heap_sub_update(eos_heap_t * const me);
+#if (EOS_USE_EDF != 0)
+static void eos_heap_deadline_update(eos_heap_t * const me, eos_u8_t priority);
+#endif
 #endif
 
 // eventos ---------------------------------------------------------------------
 static void eos_clear(void)
 {
 #if (EOS_USE_TIME_EVENT != 0)
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+    for (eos_u16_t i = 0; i < eos.timer_count; i ++) {
+        eos_etimer_data_release(i);
+    }
+#endif
     eos.timer_count = 0;
+    eos.timeout_min = EOS_TIME_MAX;
+#if (EOS_USE_HRTIMER != 0)
+    eos.hrtimer_count = 0;
+#endif
+#if (EOS_USE_TIMER_HANDLE != 0)
+    eos_timer_handle_clear();
+#endif
+#if (EOS_USE_TIMER_SLACK != 0)
+    eos.timer_phase = 0;
+#endif
+#if (EOS_USE_TIMER_WHEEL != 0)
+    eos_wheel_rebuild(eos.time);
+#endif
+#endif
+#if (EOS_USE_REQUEST != 0)
+    eos_request_clear();
+#endif
+#if (EOS_USE_TOPIC_FILTER != 0)
+    eos_filter_clear();
+#endif
+#if (EOS_USE_DELAY != 0)
+    eos_delay_clear();
+#endif
+#if (EOS_USE_EVENT_BLOCK != 0)
+    eos_block_clear();
+#endif
+#if (EOS_USE_HSM_CACHE != 0)
+    eos_sm_cache_reset();
 #endif
 }
 
@@ -244,6 +554,18 @@ void eos_init(void)
 #if (EOS_USE_EVENT_DATA != 0)
     eos_heap_init(&eos.heap);
 #endif
+#if (EOS_USE_EDF != 0)
+    eos.deadline = EOS_NULL;
+    eos.deadline_count = 0;
+    for (eos_u32_t i = 0; i < EOS_MAX_ACTORS; i ++) {
+        eos.deadline_stats[i] = (eos_deadline_stats_t) { 0, 0, 0, 0 };
+    }
+#endif
+#if (EOS_USE_PREEMPT != 0)
+    eos.prio_ceiling = -1;
+    eos.ceiling_sm = -1;
+    eos.isr_nest = 0;
+#endif
 
     eos.init_end = 1;
 #if (EOS_USE_TIME_EVENT != 0)
@@ -262,10 +584,275 @@ void eos_sub_init(eos_mcu_t *flag_sub, eos_topic_t topic_max)
 #endif
 
 #if (EOS_USE_TIME_EVENT != 0)
+#if (EOS_USE_TIMER_HANDLE != 0)
+static void eos_timer_handle_clear(void)
+{
+    for (eos_u16_t i = 0; i < EOS_MAX_TIME_EVENT; i ++) {
+        eos.timer_handle[i].index = i + 1;
+        if (eos.timer_handle[i].seq == 0) {
+            eos.timer_handle[i].seq = 1;
+        }
+    }
+    eos.timer_free = 0;
+}
+
+// 为etimer[index]分配句柄
+static void eos_timer_handle_alloc(eos_u16_t index)
+{
+    eos_u16_t id = eos.timer_free;
+
+    eos.timer_free = eos.timer_handle[id].index;
+    eos.timer_handle[id].index = index;
+    eos.etimer[index].id = id;
+}
+
+// 释放etimer[index]的句柄，改变序号，使已发出的句柄失效。
+static void eos_timer_handle_free(eos_u16_t index)
+{
+    eos_u16_t id = eos.etimer[index].id;
+    eos_timer_handle_t *handle = &eos.timer_handle[id];
+
+    handle->seq = (handle->seq == EOS_U16_MAX) ? 1 : (handle->seq + 1);
+    handle->index = eos.timer_free;
+    eos.timer_free = id;
+}
+
+// 句柄对应的定时器在etimer中的位置，句柄已失效时返回EOS_TIMER_NONE。
+static eos_u16_t eos_timer_handle_index(eos_timer_t timer)
+{
+    eos_u16_t id = (eos_u16_t)(timer & 0xffff);
+
+    if (id >= EOS_MAX_TIME_EVENT || eos.timer_handle[id].seq != (timer >> 16))
+        return EOS_TIMER_NONE;
+
+    return eos.timer_handle[id].index;
+}
+#endif
+
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+// 时间事件不再持有其数据块。数据块仍在事件队列中时，由事件处理完毕后的回收释放。
+static void eos_etimer_data_release(eos_u16_t index)
+{
+    eos_event_timer_t *timer = &eos.etimer[index];
+    if (timer->data == EOS_HEAP_MAX)
+        return;
+
+    eos_block_t *block = (eos_block_t *)(eos.heap.data + timer->data);
+    eos_port_critical_enter();
+    block->pinned = 0;
+    if (block->queued == 0) {
+        eos_heap_free(&eos.heap, (void *)((eos_pointer_t)block + sizeof(eos_block_t)));
+    }
+    eos_port_critical_exit();
+    timer->data = EOS_HEAP_MAX;
+}
+
+// 将时间事件持有的数据块直接放入事件队列，不再申请内存与复制数据。上一次投递尚未处理完时，
+// 两次到期合并为一次。
+static void eos_etimer_data_put(eos_event_timer_t * const timer, eos_sub_t sub)
+{
+    eos_block_t *block = (eos_block_t *)(eos.heap.data + timer->data);
+    eos_event_inner_t *e = (eos_event_inner_t *)((eos_pointer_t)block + sizeof(eos_block_t));
+
+    eos_port_critical_enter();
+#if (EOS_USE_EDF != 0)
+    // 合并到尚未处理完的投递时，已在等待此事件的Actor不再计数。
+    eos_sub_t sub_new = (block->queued == 0) ? sub : (sub & ~e->sub);
+#endif
+    e->sub |= sub;
+    eos.heap.sub_general |= sub;
+    if (block->queued == 0) {
+#if (EOS_USE_EVENT_BLOCK != 0)
+        block->urgent = eos_event_unblocked(e->topic);
+#endif
+#if (EOS_USE_EDF != 0)
+        // 数据块被重复使用，每次入队时按主题重新设置截止时刻。
+        e->deadline = eos_deadline_abs(eos_topic_deadline_get(e->topic));
+#endif
+        eos_heap_queue(&eos.heap, e);
+    }
+#if (EOS_USE_EDF != 0)
+    eos_deadline_queue(e, sub_new);
+#endif
+#if (EOS_USE_EVENT_BLOCK != 0)
+    if (block->urgent != 0) {
+        eos.heap.sub_urgent |= sub;
+    }
+#endif
+    eos_port_critical_exit();
+#if (EOS_USE_TICKLESS != 0)
+    eos_hook_wakeup();
+#endif
+}
+#endif
+
+// 发布到期的时间事件
+static void eos_etimer_pub(eos_u16_t index)
+{
+    eos_event_timer_t *timer = &eos.etimer[index];
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+    if (timer->data != EOS_HEAP_MAX || timer->actor != EOS_MAX_ACTORS) {
+        eos_sub_t sub;
+        if (timer->actor != EOS_MAX_ACTORS) {
+            sub = (1 << timer->actor);
+        }
+        else {
+#if (EOS_USE_PUB_SUB != 0)
+            sub = eos.sub_table[timer->topic];
+#else
+            sub = eos.actor_exist;
+#endif
+        }
+        if (sub == 0)
+            return;
+        if (timer->data != EOS_HEAP_MAX) {
+            eos_etimer_data_put(timer, sub);
+            return;
+        }
+        eos_s8_t ret = eos_event_put(timer->topic, sub, EOS_EVENT_ID_DIRECT, EOS_NULL, 0);
+        EOS_ASSERT(ret >= 0);
+        (void)ret;
+        return;
+    }
+#endif
+    eos_event_pub_topic(timer->topic);
+}
+
+#if (EOS_USE_TIMER_EXACT != 0)
+// 合并多次到期的事件，携带合并的到期次数。
+static void eos_etimer_pub_count(eos_u16_t index, eos_u32_t count)
+{
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+    eos_event_timer_t *timer = &eos.etimer[index];
+    if (timer->actor != EOS_MAX_ACTORS) {
+        eos_s8_t ret = eos_event_put(timer->topic, (1 << timer->actor), EOS_EVENT_ID_DIRECT,
+                                     &count, sizeof(eos_u32_t));
+        EOS_ASSERT(ret >= 0);
+        (void)ret;
+        return;
+    }
+#endif
+    eos_event_pub(eos.etimer[index].topic, &count, sizeof(eos_u32_t));
+}
+#endif
+
+#if (EOS_USE_TIMER_SLACK != 0)
+// 在[nominal, nominal + slack]之内，选择低位连续为0最多的时刻作为实际的到期时刻。各定时器的
+// 到期时刻因此聚集到2的幂次的边界上，在同一次唤醒中处理。
+static eos_time_t eos_etimer_align(eos_u16_t index, eos_time_t nominal)
+{
+    eos_event_timer_t *timer = &eos.etimer[index];
+    eos_time_t limit = nominal + timer->slack;
+    eos_time_t mask = nominal ^ limit;
+    // 保留最高的不同位，清除其下的所有位。
+    while ((mask & (mask - 1)) != 0) {
+        mask &= (mask - 1);
+    }
+    eos_time_t timeout = (mask == 0) ? nominal : (limit & ~(mask - 1));
+    timer->shift = (eos_u16_t)(timeout - nominal);
+
+    return timeout;
+}
+#endif
+
+// 周期事件到期，发布事件并推进到下一个截止时刻。
+static void eos_etimer_period(eos_u16_t index, eos_time_t system_time)
+{
+    eos_event_timer_t *timer = &eos.etimer[index];
+    eos_time_t nominal = timer->timeout_ms;
+#if (EOS_USE_TIMER_SLACK != 0)
+    nominal -= timer->shift;
+#endif
+#if (EOS_USE_TIMER_EXACT != 0)
+    // 截止时刻按精确的周期推进，不受处理时刻的影响，迟到的周期按追赶策略处理。迟到时间从实际的
+    // 到期时刻算起，不包含松弛量。
+    eos_time_t late = system_time - timer->timeout_ms;
+    eos_u32_t count = (eos_u32_t)((system_time - nominal) / timer->period_ms) + 1;
+    nominal += (eos_time_t)count * timer->period_ms;
+#if (EOS_USE_TIMER_SLACK != 0)
+    timer->timeout_ms = eos_etimer_align(index, nominal);
+#else
+    timer->timeout_ms = nominal;
+#endif
+
+    eos_timer_stats_t *stats = &timer->stats;
+    stats->count ++;
+    if (late > stats->late_max) {
+        stats->late_max = (late > EOS_U32_MAX) ? EOS_U32_MAX : (eos_u32_t)late;
+    }
+    stats->late_total += (eos_u32_t)late;
+    if (timer->catchup == EosTimerCatchUp_All) {
+        for (eos_u32_t i = 0; i < count; i ++) {
+            eos_etimer_pub(index);
+        }
+        return;
+    }
+    stats->missed += (count - 1);
+    if (timer->catchup == EosTimerCatchUp_Coalesce) {
+        eos_etimer_pub_count(index, count);
+        return;
+    }
+    eos_etimer_pub(index);
+#else
+    (void)system_time;
+    eos_etimer_pub(index);
+    nominal += timer->period * timer_unit[timer->unit];
+#if (EOS_USE_TIMER_SLACK != 0)
+    timer->timeout_ms = eos_etimer_align(index, nominal);
+#else
+    timer->timeout_ms = nominal;
+#endif
+#endif
+}
+
+// 删除etimer[index]，用最后一个定时器填补空位。
+static void eos_etimer_remove(eos_u16_t index)
+{
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+    eos_etimer_data_release(index);
+#endif
+#if (EOS_USE_TIMER_HANDLE != 0)
+    eos_timer_handle_free(index);
+#endif
+    eos.timer_count -= 1;
+    if (index == eos.timer_count)
+        return;
+
+    eos.etimer[index] = eos.etimer[eos.timer_count];
+#if (EOS_USE_TIMER_HANDLE != 0)
+    eos.timer_handle[eos.etimer[index].id].index = index;
+#endif
+}
+
+#if (EOS_USE_TIMER_WHEEL != 0)
+eos_s32_t eos_evttimer(void)
+{
+    // 获取当前时间，检查时间轮
+    eos_time_t system_time = eos_time();
+
+    if (eos.timer_count == 0)
+        return EosTimer_Empty;
+
+    // 时间未到达
+    if (system_time < eos.timeout_min)
+        return EosTimer_NotTimeout;
+    // 推进时间轮，到期的事件在推进过程中发布。
+    eos_wheel_advance(system_time);
+    if (eos.timer_count == 0) {
+        eos.timeout_min = EOS_TIME_MAX;
+        return EosTimer_ChangeToEmpty;
+    }
+
+    // 下一个需要处理的时刻（到期或者降级），不晚于最早的超时时间。
+    eos.timeout_min = eos_wheel_next();
+
+    return EosRun_OK;
+}
+#else
 eos_s32_t eos_evttimer(void)
 {
     // 获取当前时间，检查延时事件队列
-    eos_u32_t system_time = eos.time;
+    eos_time_t system_time = eos_time();
     
     if (eos.etimer[0].topic == Event_Null)
         return EosTimer_Empty;
@@ -277,29 +864,23 @@ eos_s32_t eos_evttimer(void)
     for (eos_u32_t i = 0; i < eos.timer_count; i ++) {
         if (eos.etimer[i].timeout_ms > system_time)
             continue;
-        eos_event_pub_topic(eos.etimer[i].topic);
         // 清零标志位
         if (eos.etimer[i].oneshoot == EOS_True) {
-            if (i == (eos.timer_count - 1)) {
-                eos.timer_count -= 1;
-                break;
-            }
-            eos.etimer[i] = eos.etimer[eos.timer_count - 1];
-            eos.timer_count -= 1;
+            eos_etimer_pub(i);
+            eos_etimer_remove(i);
             i --;
         }
         else {
-            eos_u32_t period = eos.etimer[i].period * timer_unit[eos.etimer[i].unit];
-            eos.etimer[i].timeout_ms += period;
+            eos_etimer_period(i, system_time);
         }
     }
     if (eos.timer_count == 0) {
-        eos.timeout_min = EOS_U32_MAX;
+        eos.timeout_min = EOS_TIME_MAX;
         return EosTimer_ChangeToEmpty;
     }
 
     // 寻找到最小的时间定时器
-    eos_u32_t min_time_out_ms = EOS_U32_MAX;
+    eos_time_t min_time_out_ms = EOS_TIME_MAX;
     for (eos_u32_t i = 0; i < eos.timer_count; i ++) {
         if (min_time_out_ms <= eos.etimer[i].timeout_ms)
             continue;
@@ -310,6 +891,73 @@ eos_s32_t eos_evttimer(void)
     return EosRun_OK;
 }
 #endif
+#endif
+
+#if (EOS_USE_EVENT_BATCH != 0)
+// 批量送达：在临界区内被调用，e为已取出的最老的事件。继续取出此Actor其余的事件，退出临界区后
+// 一次交给批处理函数，再一并回收，订阅集合只重新生成一次。
+static eos_s8_t eos_once_batch(eos_reactor_t * const me, eos_u8_t priority, eos_event_inner_t *e)
+{
+    eos_event_inner_t *inner[EOS_MAX_EVENT_BATCH];
+    eos_event_t event[EOS_MAX_EVENT_BATCH];
+#if (EOS_USE_EDF != 0)
+    eos_time_t deadline[EOS_MAX_EVENT_BATCH];
+#endif
+    eos_u32_t count = 0;
+
+    inner[count ++] = e;
+    while (count < EOS_MAX_EVENT_BATCH) {
+        e = eos_heap_get_block(&eos.heap, priority);
+        if (e == EOS_NULL)
+            break;
+        inner[count ++] = e;
+    }
+    eos_port_critical_exit();
+
+    eos_u32_t num = 0;
+    for (eos_u32_t i = 0; i < count; i ++) {
+        e = inner[i];
+#if (EOS_USE_PUB_SUB != 0)
+        // 进入队列之后取消了订阅的事件，不再送达
+        if ((eos.sub_table[e->topic] & (1 << priority)) == 0
+#if (EOS_USE_EVENT_ID != 0)
+            && (e->id & EOS_EVENT_ID_DIRECT) == 0
+#endif
+            ) {
+            continue;
+        }
+#endif
+        eos_block_t *block = (eos_block_t *)((eos_pointer_t)e - sizeof(eos_block_t));
+        event[num].topic = e->topic;
+        event[num].data = (void *)((eos_pointer_t)e + sizeof(eos_event_inner_t));
+        event[num].size = block->size - block->offset - sizeof(eos_event_inner_t);
+#if (EOS_USE_REQUEST != 0)
+        event[num].id = (e->id & (~EOS_EVENT_ID_DIRECT));
+#endif
+#if (EOS_USE_EDF != 0)
+        deadline[num] = e->deadline;
+#endif
+        num ++;
+    }
+    if (num != 0) {
+        me->batch_handler(me, event, num);
+    }
+#if (EOS_USE_EDF != 0)
+    for (eos_u32_t i = 0; i < num; i ++) {
+        eos_deadline_count(priority, deadline[i]);
+    }
+#endif
+
+    eos_port_critical_enter();
+    for (eos_u32_t i = 0; i < count; i ++) {
+        eos_heap_release(&eos.heap, inner[i]);
+    }
+    eos_heap_sub_update(&eos.heap);
+    eos_port_critical_exit();
+
+    return (eos_s8_t)EosRun_OK;
+}
+#endif
 
 eos_s8_t eos_once(void)
 {
@@ -333,46 +981,141 @@ eos_s8_t eos_once(void)
         return (eos_s8_t)EosRun_NoActor;
     }
 
+#if (EOS_USE_PREEMPT != 0)
+    // 时间事件等服务的处理期间，中断退出时不抢占。
+    eos_s8_t ceiling = eos_sched_lock(EOS_MAX_ACTORS - 1);
+#endif
 #if (EOS_USE_TIME_EVENT != 0)
     eos_evttimer();
 #endif
+#if (EOS_USE_HRTIMER != 0)
+    eos_evthrtimer();
+#endif
+#if (EOS_USE_REQUEST != 0)
+    eos_evtrequest();
+#endif
+#if (EOS_USE_TOPIC_FILTER != 0)
+    eos_evtfilter();
+#endif
+#if (EOS_USE_DELAY != 0)
+    eos_evtdelay();
+#endif
+#if (EOS_USE_PREEMPT != 0)
+    // 其间就绪的Actor随后由eos_once_dispatch执行，不必抢占。
+    eos.prio_ceiling = ceiling;
+#endif
+
+    return eos_once_dispatch();
+}
 
+// 寻找到优先级最高（抢占式内核中须高于天花板），且有事件需要处理的Actor，送达其最老的事件。
+// 选出Actor与取出事件在同一个临界区内，其间的中断不会抢先处理同一个事件。
+static eos_s8_t eos_once_dispatch(void)
+{
     if (eos.heap.empty == EOS_True) {
         return (eos_s8_t)EosRun_NoEvent;
     }
 
-    // 寻找到优先级最高，且有事件需要处理的Actor
+    eos_port_critical_enter();
+    eos_sub_t sub_ready = eos.heap.sub_general;
+#if (EOS_USE_EVENT_BLOCK != 0)
+    // 被屏蔽的Actor只接收不可阻塞事件，其余事件留在队列中，不必逐个扫描。
+    sub_ready &= ~(eos.heap.sub_blocked & ~eos.heap.sub_urgent);
+#endif
     eos_actor_t *actor = eos.actor[0];
     eos_u8_t priority = EOS_MAX_ACTORS;
+#if (EOS_USE_EDF != 0)
+    // 选出最早截止的Actor，由高到低扫描，截止时刻相同时保留优先级高的。
+    eos_time_t deadline = EOS_TIME_MAX;
+#endif
     for (eos_s8_t i = (eos_s8_t)(EOS_MAX_ACTORS - 1); i >= 0; i --) {
+#if (EOS_USE_PREEMPT != 0)
+        if (i <= eos.prio_ceiling)
+            break;
+#endif
         if ((eos.actor_exist & (1 << i)) == 0)
             continue;
-        if ((eos.heap.sub_general & (1 << i)) == 0)
+        if ((sub_ready & (1 << i)) == 0)
+            continue;
+#if (EOS_USE_EDF != 0)
+        if (priority != EOS_MAX_ACTORS && eos.heap.deadline[i] >= deadline)
             continue;
+        deadline = eos.heap.deadline[i];
+        actor = eos.actor[i];
+        priority = i;
+#else
         actor = eos.actor[i];
         priority = i;
         break;
+#endif
     }
     // 如果没有找到，返回
     if (priority == EOS_MAX_ACTORS) {
+        eos_port_critical_exit();
+#if (EOS_USE_EVENT_BLOCK != 0)
+        // 只剩被屏蔽的事件，按空闲处理。
+        if (eos.heap.sub_general != 0) {
+            return (eos_s8_t)EosRun_NoEvent;
+        }
+#endif
         return (eos_s8_t)EosRun_NoActorSub;
     }
 
     // 寻找当前Actor的最老的事件
-    eos_port_critical_enter();
     eos_event_inner_t * e = eos_heap_get_block(&eos.heap, priority);
     EOS_ASSERT(e != EOS_NULL);
+#if (EOS_USE_EVENT_BLOCK != 0 && EOS_USE_DELAY != 0)
+    // eos_delay_unsub_event的延时结束，此后按原有顺序送达被保留的事件。
+    if ((eos.delay_unblock & (1 << priority)) != 0 &&
+        e->topic == Event_Null && (e->id & EOS_EVENT_ID_DIRECT) != 0) {
+        eos.delay_unblock &= ~(1 << priority);
+        eos.heap.sub_blocked &= ~(1 << priority);
+    }
+#endif
 
-    eos_port_critical_exit();
-    eos_event_t event;
+#if (EOS_USE_PREEMPT != 0)
+    // 处理期间只有更高优先级的Actor可以抢占
+    eos_s8_t ceiling = eos.prio_ceiling;
+    eos.prio_ceiling = (eos_s8_t)priority;
+    eos_s8_t ret = eos_once_event(actor, priority, e);
+    eos.prio_ceiling = ceiling;
+
+    return ret;
+#else
+    return eos_once_event(actor, priority, e);
+#endif
+}
+
+// 在临界区内被调用，将已取出的事件交给Actor处理，然后回收。
+static eos_s8_t eos_once_event(eos_actor_t * const actor, eos_u8_t priority, eos_event_inner_t *e)
+{
+#if (EOS_USE_EVENT_BATCH == 0 && EOS_USE_DELAY == 0 && EOS_USE_EDF == 0)
+    (void)priority;
+#endif
+#if (EOS_USE_EVENT_BATCH != 0)
+    if (actor->mode == EOS_Mode_Reactor && ((eos_reactor_t *)actor)->batch_handler != EOS_NULL) {
+        return eos_once_batch((eos_reactor_t *)actor, priority, e);
+    }
+#endif
+
+    eos_port_critical_exit();
+    eos_event_t event;
     event.topic = e->topic;
     event.data = (void *)((eos_pointer_t)e + sizeof(eos_event_inner_t));
     eos_block_t *block = (eos_block_t *)((eos_pointer_t)e - sizeof(eos_block_t));
     event.size = block->size - block->offset - sizeof(eos_event_inner_t);
+#if (EOS_USE_REQUEST != 0)
+    event.id = (e->id & (~EOS_EVENT_ID_DIRECT));
+#endif
 
-    // 对事件进行执行
+    // 对事件进行执行，定向发送的事件（回复、超时与定向的时间事件）不检查订阅表。按状态订阅时，事件
+    // 进入队列之后的状态转移可能取消了订阅，这样的事件有意不送达，与已处理的事件一样销毁。
 #if (EOS_USE_PUB_SUB != 0)
-    if ((eos.sub_table[e->topic] & (1 << actor->priority)) != 0)
+    if ((eos.sub_table[e->topic] & (1 << actor->priority)) != 0
+#if (EOS_USE_EVENT_ID != 0)
+        || (e->id & EOS_EVENT_ID_DIRECT) != 0
+#endif
+        )
 #endif
     {
 #if (EOS_USE_SM_MODE != 0)
@@ -382,17 +1125,53 @@ eos_s8_t eos_once(void)
             eos_sm_dispath(sm, &event);
         }
         else 
+#endif
+#if (EOS_USE_SM_DESC != 0)
+        if (actor->mode == EOS_Mode_Descriptor) {
+            eos_dsm_dispath((eos_dsm_t *)actor, &event);
+        }
+        else
+#endif
+#if (EOS_USE_SM_TABLE != 0)
+        if (actor->mode == EOS_Mode_Table) {
+            eos_tsm_dispath((eos_tsm_t *)actor, &event);
+        }
+        else
 #endif
         {
             eos_reactor_t *reactor = (eos_reactor_t *)actor;
-            reactor->event_handler(reactor, &event);
+            eos_event_handler handler = reactor->event_handler;
+#if (EOS_USE_REACTOR_TABLE != 0)
+            // 按主题直接取出处理函数
+            if (reactor->table != EOS_NULL) {
+                handler = eos_reactor_handler(reactor->table, event.topic);
+            }
+#endif
+            if (handler != EOS_NULL) {
+#if (EOS_USE_DELAY != 0 && EOS_USE_PREEMPT != 0)
+                // 可能抢占了另一个Reactor，处理后恢复
+                eos_u8_t current = eos.actor_current;
+                eos.actor_current = priority;
+                handler(reactor, &event);
+                eos.actor_current = current;
+#elif (EOS_USE_DELAY != 0)
+                eos.actor_current = priority;
+                handler(reactor, &event);
+                eos.actor_current = EOS_MAX_ACTORS;
+#else
+                handler(reactor, &event);
+#endif
+            }
         }
     }
-#if (EOS_USE_PUB_SUB != 0)
+#if (EOS_USE_PUB_SUB != 0 && EOS_USE_STATE_SUB == 0)
     else {
         return (eos_s8_t)EosRunErr_ActorNotSub;
     }
 #endif
+#if (EOS_USE_EDF != 0)
+    eos_deadline_count(priority, e->deadline);
+#endif
 #if (EOS_USE_EVENT_DATA != 0)
     // 销毁过期事件与其携带的参数
     eos_port_critical_enter();
@@ -450,30 +1229,202 @@ void eos_stop(void)
     eos_hook_stop();
 }
 
+#if (EOS_USE_PREEMPT != 0)
+// 执行所有优先级高于天花板的就绪Actor，它们与被抢占的Actor共用同一个栈。
+static void eos_preempt(void)
+{
+    if (eos.init_end == 0 || eos.enabled == EOS_False) {
+        return;
+    }
+#if (EOS_USE_PUB_SUB != 0)
+    if (eos.sub_table == EOS_NULL) {
+        return;
+    }
+#endif
+
+    while (eos_once_dispatch() == EosRun_OK) {
+    }
+}
+
+void eos_isr_enter(void)
+{
+    eos_port_critical_enter();
+    eos.isr_nest ++;
+    eos_port_critical_exit();
+}
+
+void eos_isr_exit(void)
+{
+    eos_port_critical_enter();
+    EOS_ASSERT(eos.isr_nest != 0);
+    eos.isr_nest --;
+    eos_u8_t nest = eos.isr_nest;
+    eos_port_critical_exit();
+
+    // 最外层的中断退出时，执行中断中发布的高优先级事件。
+    if (nest == 0) {
+        eos_preempt();
+    }
+}
+
+eos_s8_t eos_sched_lock(eos_u8_t ceiling)
+{
+    EOS_ASSERT(ceiling < EOS_MAX_ACTORS);
+
+    eos_port_critical_enter();
+    eos_s8_t lock = eos.prio_ceiling;
+    if ((eos_s8_t)ceiling > lock) {
+        eos.prio_ceiling = (eos_s8_t)ceiling;
+    }
+    eos_port_critical_exit();
+
+    return lock;
+}
+
+void eos_sched_unlock(eos_s8_t lock)
+{
+    eos_port_critical_enter();
+    eos.prio_ceiling = lock;
+    eos_port_critical_exit();
+
+    // 锁定期间就绪、且高于当前Actor的Actor，此时抢占。空闲时由eos_run执行。
+    if (lock >= 0 && eos.isr_nest == 0) {
+        eos_preempt();
+    }
+}
+#endif
+
 #if (EOS_USE_TIME_EVENT != 0)
-eos_u32_t eos_time(void)
+eos_time_t eos_time(void)
 {
+#if (EOS_USE_TIME_64BIT != 0)
+    // 64位的时间在32位及以下的MCU上不能一次读出，需避免与滴答中断中的更新交错。
+    eos_port_critical_enter();
+    eos_time_t time = eos.time;
+    eos_port_critical_exit();
+
+    return time;
+#else
     return eos.time;
+#endif
 }
 
 void eos_tick(void)
 {
-    eos_u32_t system_time = eos.time, system_time_bkp = eos.time;
-    eos_u32_t offset = EOS_MS_NUM_30DAY - 1 + EOS_TICK_MS;
-    system_time = ((system_time + EOS_TICK_MS) % EOS_MS_NUM_30DAY);
-    if (system_time_bkp >= (EOS_MS_NUM_30DAY - EOS_TICK_MS) && system_time < EOS_TICK_MS) {
-        eos_port_critical_enter();
-        EOS_ASSERT(eos.timeout_min >= offset);
-        eos.timeout_min -= offset;
-        for (eos_u32_t i = 0; i < eos.timer_count; i ++) {
-            EOS_ASSERT(eos.etimer[i].timeout_ms >= offset);
-            eos.etimer[i].timeout_ms -= offset;
-        }
-        eos_port_critical_exit();
+    eos_tick_advance(EOS_TICK_MS);
+}
+
+#if (EOS_USE_TIME_64BIT != 0)
+// 64位的时间不会溢出，超时时间保持不变，不需要重新计算。
+void eos_tick_advance(eos_u32_t elapsed_ms)
+{
+    eos_port_critical_enter();
+    eos.time += elapsed_ms;
+    eos_port_critical_exit();
+}
+#else
+// 时间溢出时，超时时间减去offset，已超时但尚未处理的，记为0时刻，在下一次处理时到期。
+static eos_u32_t eos_time_rebase(eos_u32_t timeout_ms, eos_u32_t offset)
+{
+    return (timeout_ms >= offset) ? (timeout_ms - offset) : 0;
+}
+
+void eos_tick_advance(eos_u32_t elapsed_ms)
+{
+    EOS_ASSERT(elapsed_ms < EOS_MS_NUM_30DAY);
+
+    eos_u32_t system_time = eos.time;
+    // 未到30天，直接累加。
+    if (elapsed_ms < (EOS_MS_NUM_30DAY - system_time)) {
+        eos.time = system_time + elapsed_ms;
+        return;
+    }
+
+    // 时间溢出，所有的超时时间减去30天。
+    eos_u32_t offset = EOS_MS_NUM_30DAY;
+    system_time = elapsed_ms - (EOS_MS_NUM_30DAY - system_time);
+    eos_port_critical_enter();
+    for (eos_u32_t i = 0; i < eos.timer_count; i ++) {
+        eos.etimer[i].timeout_ms = eos_time_rebase(eos.etimer[i].timeout_ms, offset);
+    }
+#if (EOS_USE_TIMER_WHEEL != 0)
+    // 时间轮中的槽位与绝对时间相关，需要重建。
+    eos_wheel_rebuild(system_time);
+    eos.timeout_min = (eos.timer_count == 0) ? EOS_TIME_MAX : eos_wheel_next();
+#else
+    if (eos.timeout_min != EOS_TIME_MAX) {
+        eos.timeout_min = eos_time_rebase(eos.timeout_min, offset);
+    }
+#endif
+#if (EOS_USE_REQUEST != 0)
+    if (eos.request_count != 0) {
+        eos.request_timeout_min = eos_time_rebase(eos.request_timeout_min, offset);
+    }
+    for (eos_u32_t i = 0; i < EOS_MAX_REQUEST; i ++) {
+        if (eos.request[i].id == 0)
+            continue;
+        eos.request[i].timeout_ms = eos_time_rebase(eos.request[i].timeout_ms, offset);
+    }
+#endif
+#if (EOS_USE_TOPIC_FILTER != 0)
+    if (eos.filter_timeout_min != EOS_TIME_MAX) {
+        eos.filter_timeout_min = eos_time_rebase(eos.filter_timeout_min, offset);
+    }
+    for (eos_u32_t i = 0; i < EOS_MAX_TOPIC_FILTER; i ++) {
+        if (eos.filter[i].active == 0)
+            continue;
+        eos.filter[i].timeout_ms = eos_time_rebase(eos.filter[i].timeout_ms, offset);
+    }
+#endif
+#if (EOS_USE_DELAY != 0)
+    if (eos.delay_actor != 0) {
+        eos.delay_timeout_min = eos_time_rebase(eos.delay_timeout_min, offset);
+    }
+    for (eos_u32_t i = 0; i < EOS_MAX_ACTORS; i ++) {
+        if ((eos.delay_actor & (1 << i)) == 0)
+            continue;
+        eos.delay_timeout[i] = eos_time_rebase(eos.delay_timeout[i], offset);
     }
+#endif
+#if (EOS_USE_EDF != 0)
+    eos_deadline_rebase(offset);
+#endif
     eos.time = system_time;
+    eos_port_critical_exit();
+}
+#endif
+
+#if (EOS_USE_TICKLESS != 0)
+eos_u32_t eos_time_deadline(void)
+{
+    eos_time_t timeout_min = (eos.timer_count == 0) ? EOS_TIME_MAX : eos.timeout_min;
+#if (EOS_USE_REQUEST != 0)
+    if (eos.request_count != 0 && timeout_min > eos.request_timeout_min) {
+        timeout_min = eos.request_timeout_min;
+    }
+#endif
+#if (EOS_USE_TOPIC_FILTER != 0)
+    if (timeout_min > eos.filter_timeout_min) {
+        timeout_min = eos.filter_timeout_min;
+    }
+#endif
+#if (EOS_USE_DELAY != 0)
+    if (eos.delay_actor != 0 && timeout_min > eos.delay_timeout_min) {
+        timeout_min = eos.delay_timeout_min;
+    }
+#endif
+
+    if (timeout_min == EOS_TIME_MAX)
+        return EOS_U32_MAX;
+    eos_time_t time = eos_time();
+    if (timeout_min <= time)
+        return 0;
+
+    // 延时不超过timer_threshold，差值在32位的范围之内。
+    return (eos_u32_t)(timeout_min - time);
 }
 #endif
+#endif
 
 // 关于Reactor -----------------------------------------------------------------
 static void eos_actor_init( eos_actor_t * const me,
@@ -515,6 +1466,15 @@ void eos_reactor_init(  eos_reactor_t * const me,
 {
     eos_actor_init(&me->super, priority, parameter);
     me->super.mode = EOS_Mode_Reactor;
+#if (EOS_USE_DELAY != 0)
+    me->pt = 0;
+#endif
+#if (EOS_USE_REACTOR_TABLE != 0)
+    me->table = EOS_NULL;
+#endif
+#if (EOS_USE_EVENT_BATCH != 0)
+    me->batch_handler = EOS_NULL;
+#endif
 }
 
 void eos_reactor_start(eos_reactor_t * const me, eos_event_handler event_handler)
@@ -524,6 +1484,216 @@ void eos_reactor_start(eos_reactor_t * const me, eos_event_handler event_handler
     eos.actor_enabled |= (1 << me->super.priority);
 }
 
+#if (EOS_USE_EVENT_BATCH != 0)
+void eos_reactor_start_batch(eos_reactor_t * const me, eos_batch_handler batch_handler)
+{
+    EOS_ASSERT(batch_handler != EOS_NULL);
+
+    me->batch_handler = batch_handler;
+    eos_reactor_start(me, EOS_NULL);
+}
+#endif
+
+#if (EOS_USE_REACTOR_TABLE != 0)
+void eos_reactor_start_table(eos_reactor_t * const me, eos_reactor_table_t const * const table)
+{
+    EOS_ASSERT(table != EOS_NULL && table->handler != EOS_NULL && table->size != 0);
+    // 散列表的大小须为2的幂
+    EOS_ASSERT(table->topic == EOS_NULL || (table->size & (table->size - 1)) == 0);
+
+    me->table = table;
+    eos_reactor_start(me, table->handler_default);
+}
+
+void eos_reactor_table_add( eos_topic_t *topic, eos_event_handler *handler, eos_u16_t size,
+                            eos_topic_t key, eos_event_handler event_handler)
+{
+    EOS_ASSERT(size != 0 && (size & (size - 1)) == 0);
+    EOS_ASSERT(key != Event_Null);
+
+    eos_u16_t index = (eos_u16_t)(key & (size - 1));
+    for (eos_u16_t i = 0; i < size; i ++) {
+        if (topic[index] == Event_Null || topic[index] == key) {
+            topic[index] = key;
+            handler[index] = event_handler;
+            return;
+        }
+        index = (eos_u16_t)((index + 1) & (size - 1));
+    }
+    // 散列表已满
+    EOS_ASSERT(0);
+}
+
+// 取出主题的处理函数，没有登记时为handler_default。
+static eos_event_handler eos_reactor_handler(eos_reactor_table_t const *table, eos_topic_t topic)
+{
+    eos_event_handler handler = EOS_NULL;
+
+    if (table->topic == EOS_NULL) {
+        // topic小于topic_min时，无符号减法回绕，同样超出范围
+        eos_u32_t index = (eos_u32_t)topic - table->topic_min;
+        if (index < table->size) {
+            handler = table->handler[index];
+        }
+    }
+    else if (topic != Event_Null) {
+        eos_u16_t index = (eos_u16_t)(topic & (table->size - 1));
+        for (eos_u16_t i = 0; i < table->size; i ++) {
+            if (table->topic[index] == topic) {
+                handler = table->handler[index];
+                break;
+            }
+            if (table->topic[index] == Event_Null)
+                break;
+            index = (eos_u16_t)((index + 1) & (table->size - 1));
+        }
+    }
+
+    return (handler == EOS_NULL) ? table->handler_default : handler;
+}
+#endif
+
+#if (EOS_USE_DELAY != 0)
+static void eos_delay_clear(void)
+{
+    eos.delay_actor = 0;
+    eos.delay_timeout_min = EOS_TIME_MAX;
+    eos.actor_current = EOS_MAX_ACTORS;
+}
+
+void eos_delay(eos_u32_t time_ms)
+{
+    // 只有Reactor可以延时，状态机使用Event_Null查询父状态。
+    eos_u8_t priority = eos.actor_current;
+    EOS_ASSERT(priority < EOS_MAX_ACTORS);
+    EOS_ASSERT(eos.actor[priority]->mode == EOS_Mode_Reactor);
+    EOS_ASSERT(time_ms != 0);
+    EOS_ASSERT(time_ms <= timer_threshold[EosTimerUnit_Minute]);
+
+    eos_port_critical_enter();
+    eos_time_t timeout = eos.time + time_ms;
+    eos.delay_timeout[priority] = timeout;
+    eos.delay_actor |= (1 << priority);
+    // 重新计时只会推迟截止时刻，保留原有的delay_timeout_min。
+    if (eos.delay_timeout_min > timeout) {
+        eos.delay_timeout_min = timeout;
+    }
+    eos_port_critical_exit();
+}
+
+static void eos_evtdelay(void)
+{
+    eos_time_t system_time = eos_time();
+
+    // 最早的截止时刻未到达时，不必遍历各Actor。
+    if (eos.delay_actor == 0 || system_time < eos.delay_timeout_min)
+        return;
+
+    eos_time_t timeout_min = EOS_TIME_MAX;
+    for (eos_u32_t i = 0; i < EOS_MAX_ACTORS; i ++) {
+        if ((eos.delay_actor & (1 << i)) == 0)
+            continue;
+        if (eos.delay_timeout[i] > system_time) {
+            if (timeout_min > eos.delay_timeout[i]) {
+                timeout_min = eos.delay_timeout[i];
+            }
+            continue;
+        }
+
+        // 延时结束，将Event_Null直接发送给该Actor。
+        eos.delay_actor &= ~(1 << i);
+        eos_s8_t ret = eos_event_put(Event_Null, (1 << i), EOS_EVENT_ID_DIRECT, EOS_NULL, 0);
+        EOS_ASSERT(ret >= 0);
+        (void)ret;
+    }
+    eos.delay_timeout_min = timeout_min;
+}
+#endif
+
+// event block -----------------------------------------------------------------
+#if (EOS_USE_EVENT_BLOCK != 0)
+static void eos_block_clear(void)
+{
+    eos.unblocked_count = 0;
+#if (EOS_USE_DELAY != 0)
+    eos.delay_unblock = 0;
+#endif
+}
+
+// 框架内部定向发送的Event_Null（延时结束）总是不可阻塞。
+static eos_bool_t eos_event_unblocked(eos_topic_t topic)
+{
+    if (topic == Event_Null)
+        return EOS_True;
+    for (eos_u8_t i = 0; i < eos.unblocked_count; i ++) {
+        if (eos.unblocked[i] == topic)
+            return EOS_True;
+    }
+
+    return EOS_False;
+}
+
+void eos_event_set_unblocked(eos_topic_t topic)
+{
+    eos_port_critical_enter();
+    if (eos_event_unblocked(topic) == EOS_False) {
+        EOS_ASSERT(eos.unblocked_count < EOS_MAX_UNBLOCKED);
+        eos.unblocked[eos.unblocked_count ++] = topic;
+    }
+    eos_port_critical_exit();
+}
+
+void eos_actor_block(eos_actor_t * const me)
+{
+    eos_port_critical_enter();
+    eos.heap.sub_blocked |= (1 << me->priority);
+    eos_port_critical_exit();
+}
+
+void eos_actor_unblock(eos_actor_t * const me)
+{
+    eos_port_critical_enter();
+    eos.heap.sub_blocked &= ~(1 << me->priority);
+#if (EOS_USE_DELAY != 0)
+    eos.delay_unblock &= ~(1 << me->priority);
+#endif
+    eos_port_critical_exit();
+#if (EOS_USE_TICKLESS != 0)
+    eos_hook_wakeup();
+#endif
+}
+
+#if (EOS_USE_DELAY != 0)
+void eos_delay_unsub_event(eos_u32_t time_ms)
+{
+    eos_u8_t priority = eos.actor_current;
+    eos_delay(time_ms);
+
+    eos_port_critical_enter();
+    eos.heap.sub_blocked |= (1 << priority);
+    eos.delay_unblock |= (1 << priority);
+    eos_port_critical_exit();
+}
+#endif
+#endif
+
+// 未开启的延时功能保留接口，调用即断言。
+#if (EOS_USE_DELAY == 0)
+void eos_delay(eos_u32_t time_ms)
+{
+    (void)time_ms;
+    EOS_ASSERT(0);
+}
+#endif
+
+#if (EOS_USE_DELAY == 0 || EOS_USE_EVENT_BLOCK == 0)
+void eos_delay_unsub_event(eos_u32_t time_ms)
+{
+    (void)time_ms;
+    EOS_ASSERT(0);
+}
+#endif
+
 // state machine ---------------------------------------------------------------
 #if (EOS_USE_SM_MODE != 0)
 void eos_sm_init(   eos_sm_t * const me,
@@ -533,18 +1703,62 @@ void eos_sm_init(   eos_sm_t * const me,
     eos_actor_init(&me->super, priority, parameter);
     me->super.mode = EOS_Mode_StateMachine;
     me->state = eos_state_top;
+#if (EOS_USE_PREEMPT != 0)
+    if ((eos_s8_t)priority > eos.ceiling_sm) {
+        eos.ceiling_sm = (eos_s8_t)priority;
+    }
+#endif
+#if (EOS_USE_SM_REGION != 0)
+    me->region = EOS_NULL;
+    me->region_count = 0;
+    me->region_current = 0;
+#endif
 }
 
 void eos_sm_start(eos_sm_t * const me, eos_state_handler state_init)
 {
-#if (EOS_USE_HSM_MODE != 0)
-    eos_state_handler path[EOS_MAX_HSM_NEST_DEPTH];
+    me->super.enabled = EOS_True;
+    eos.actor_enabled |= (1 << me->super.priority);
+    eos_sm_start_state(me, state_init);
+}
+
+#if (EOS_USE_SM_REGION != 0)
+void eos_sm_region_init(eos_sm_t * const me, eos_region_t * const region, eos_u8_t count)
+{
+    EOS_ASSERT(region != EOS_NULL || count == 0);
+
+    for (eos_u8_t i = 0; i < count; i ++) {
+        region[i].state = EOS_NULL;
+    }
+    me->region = region;
+    me->region_count = count;
+}
+
+void eos_sm_region_start(eos_sm_t * const me, eos_u8_t index, eos_state_handler state_init)
+{
+    EOS_ASSERT(index >= 1 && index <= me->region_count);
+    EOS_ASSERT(me->region[index - 1].state == EOS_NULL);
+
+    // 借用state执行区域的初始转移
+    eos_state_handler state = me->state;
+    me->region_current = index;
+    eos_sm_start_state(me, state_init);
+    me->region[index - 1].state = me->state;
+    me->region_current = 0;
+    me->state = state;
+}
+
+eos_u8_t eos_sm_region(eos_sm_t * const me)
+{
+    return me->region_current;
+}
 #endif
+
+static void eos_sm_start_state(eos_sm_t * const me, eos_state_handler state_init)
+{
     eos_state_handler t;
 
     me->state = state_init;
-    me->super.enabled = EOS_True;
-    eos.actor_enabled |= (1 << me->super.priority);
 
     // 进入初始状态，执行TRAN动作。这也意味着，进入初始状态，必须无条件执行Tran动作。
     t = me->state;
@@ -557,27 +1771,10 @@ void eos_sm_start(eos_sm_t * const me, eos_state_handler state_init)
     t = eos_state_top;
     // 由初始状态转移，引发的各层状态的进入
     // 每一个循环，都代表着一个Event_Init的执行
-    eos_s32_t ip = 0;
-    ret = EOS_Ret_Null;
     do {
-        // 由当前层，探测需要进入的各层父状态
-        path[0] = me->state;
-        // 一层一层的探测，一直探测到原状态
-        HSM_TRIG_(me->state, Event_Null);
-        while (me->state != t) {
-            ++ ip;
-            EOS_ASSERT(ip < EOS_MAX_HSM_NEST_DEPTH);
-            path[ip] = me->state;
-            HSM_TRIG_(me->state, Event_Null);
-        }
-        me->state = path[0];
-
-        // 各层状态的进入
-        do {
-            HSM_TRIG_(path[ip --], Event_Enter);
-        } while (ip >= 0);
-
-        t = path[0];
+        eos_state_handler target = me->state;
+        eos_sm_enter(me, t, target);
+        t = target;
 
         ret = HSM_TRIG_(t, Event_Init);
     } while (ret == EOS_Ret_Tran);
@@ -590,10 +1787,30 @@ void eos_sm_start(eos_sm_t * const me, eos_state_handler state_init)
 // event -----------------------------------------------------------------------
 eos_s8_t eos_event_pub_ret(eos_topic_t topic, void *data, eos_u32_t size)
 {
-    if (eos.init_end == 0) {
-        return (eos_s8_t)EosRunErr_NotInitEnd;
+#if (EOS_USE_TOPIC_FILTER != 0)
+    // 被过滤器暂存或者丢弃的事件，不进入事件队列。
+    if (eos.filter_count != 0 && eos_filter_input(topic, data, size) == EOS_True) {
+        return (eos_s8_t)EosRun_OK;
     }
-
+#endif
+    return eos_event_pub_id(topic, 0, data, size);
+}
+
+static eos_s8_t eos_event_pub_id(eos_topic_t topic, eos_u16_t id, void *data, eos_u32_t size)
+#if (EOS_USE_EDF != 0)
+{
+    return eos_event_pub_edf(topic, id, data, size, eos_topic_deadline_get(topic));
+}
+
+// 同eos_event_pub_id，deadline_ms为事件的相对截止时间，0为没有截止时间。
+static eos_s8_t eos_event_pub_edf(  eos_topic_t topic, eos_u16_t id, void *data, eos_u32_t size,
+                                    eos_u32_t deadline_ms)
+#endif
+{
+    if (eos.init_end == 0) {
+        return (eos_s8_t)EosRunErr_NotInitEnd;
+    }
+
 #if (EOS_USE_PUB_SUB != 0)
     if (eos.sub_table == EOS_NULL) {
         return (eos_s8_t)EosRunErr_SubTableNull;
@@ -620,6 +1837,37 @@ eos_s8_t eos_event_pub_ret(eos_topic_t topic, void *data, eos_u32_t size)
     }
 #endif
 
+#if (EOS_USE_PUB_SUB != 0)
+    eos_sub_t sub = eos.sub_table[topic];
+#else
+    eos_sub_t sub = eos.actor_exist;
+#endif
+#if (EOS_USE_EDF != 0)
+    return eos_event_put_edf(topic, sub, id, data, size, deadline_ms);
+#else
+    return eos_event_put(topic, sub, id, data, size);
+#endif
+}
+
+#if (EOS_USE_EDF != 0)
+#if (EOS_USE_EVENT_ID != 0)
+// 将事件放入事件队列，sub为接收此事件的Actor的集合
+static eos_s8_t eos_event_put(  eos_topic_t topic, eos_sub_t sub, eos_u16_t id,
+                                void *data, eos_u32_t size)
+{
+    return eos_event_put_edf(topic, sub, id, data, size, eos_topic_deadline_get(topic));
+}
+#endif
+
+// 同eos_event_put，deadline_ms为事件的相对截止时间，0为没有截止时间。
+static eos_s8_t eos_event_put_edf(  eos_topic_t topic, eos_sub_t sub, eos_u16_t id,
+                                    void *data, eos_u32_t size, eos_u32_t deadline_ms)
+#else
+// 将事件放入事件队列，sub为接收此事件的Actor的集合
+static eos_s8_t eos_event_put(  eos_topic_t topic, eos_sub_t sub, eos_u16_t id,
+                                void *data, eos_u32_t size)
+#endif
+{
     eos_port_critical_enter();
     // 申请事件空间
     eos_event_inner_t *e = eos_heap_malloc(&eos.heap, (size + sizeof(eos_event_inner_t)));
@@ -628,17 +1876,32 @@ eos_s8_t eos_event_pub_ret(eos_topic_t topic, void *data, eos_u32_t size)
         return (eos_s8_t)EosRunErr_MallocFail;
     }
     e->topic = topic;
-#if (EOS_USE_PUB_SUB != 0)
-    e->sub = eos.sub_table[e->topic];
+    e->sub = sub;
+#if (EOS_USE_EVENT_ID != 0)
+    e->id = id;
 #else
-    e->sub = eos.actor_exist;
+    (void)id;
 #endif
     eos.heap.sub_general |= e->sub;
+#if (EOS_USE_EDF != 0)
+    e->deadline = eos_deadline_abs(deadline_ms);
+    eos_deadline_queue(e, sub);
+#endif
+#if (EOS_USE_EVENT_BLOCK != 0)
+    eos_block_t *block = (eos_block_t *)((eos_pointer_t)e - sizeof(eos_block_t));
+    block->urgent = eos_event_unblocked(topic);
+    if (block->urgent != 0) {
+        eos.heap.sub_urgent |= e->sub;
+    }
+#endif
     eos_u8_t *e_data = (eos_u8_t *)e + sizeof(eos_event_inner_t);
     for (eos_u32_t i = 0; i < size; i ++) {
         e_data[i] = ((eos_u8_t *)data)[i];
     }
     eos_port_critical_exit();
+#if (EOS_USE_TICKLESS != 0)
+    eos_hook_wakeup();
+#endif
 
     return (eos_s8_t)EosRun_OK;
 }
@@ -659,31 +1922,143 @@ void eos_event_pub(eos_topic_t topic, void *data, eos_u32_t size)
 }
 #endif
 
+// EDF -------------------------------------------------------------------------
+#if (EOS_USE_EDF != 0)
+void eos_deadline_init(eos_u16_t *deadline, eos_topic_t topic_max)
+{
+    eos.deadline = deadline;
+    eos.deadline_count = topic_max;
+    for (eos_u32_t i = 0; i < topic_max; i ++) {
+        eos.deadline[i] = 0;
+    }
+}
+
+void eos_topic_deadline(eos_topic_t topic, eos_u16_t deadline_ms)
+{
+    EOS_ASSERT(eos.deadline != EOS_NULL);
+    EOS_ASSERT(topic < eos.deadline_count);
+
+    eos.deadline[topic] = deadline_ms;
+}
+
+void eos_event_pub_deadline(eos_topic_t topic, void *data, eos_u32_t size, eos_u16_t deadline_ms)
+{
+    EOS_ASSERT(deadline_ms != 0);
+
+    eos_s8_t ret = eos_event_pub_edf(topic, 0, data, size, deadline_ms);
+    EOS_ASSERT(ret >= 0);
+    (void)ret;
+}
+
+void eos_deadline_stats(eos_actor_t const * const me, eos_deadline_stats_t * const stats)
+{
+    *stats = eos.deadline_stats[me->priority];
+}
+
+// 主题的相对截止时间，没有设置时为0。
+static eos_u32_t eos_topic_deadline_get(eos_topic_t topic)
+{
+    if (topic >= eos.deadline_count)
+        return 0;
+
+    return eos.deadline[topic];
+}
+
+// 相对截止时间对应的截止时刻，0为没有截止时间。
+static eos_time_t eos_deadline_abs(eos_u32_t deadline_ms)
+{
+    return (deadline_ms == 0) ? EOS_TIME_MAX : (eos.time + deadline_ms);
+}
+
+// 事件放入队列时，更新接收它的各Actor最早的截止时刻，以及在此时刻截止的事件数。在临界区内调用。
+static void eos_deadline_queue(eos_event_inner_t const *e, eos_sub_t sub)
+{
+    for (eos_u32_t i = 0; i < EOS_MAX_ACTORS; i ++) {
+        if ((sub & (1 << i)) == 0)
+            continue;
+        if (eos.heap.deadline[i] > e->deadline) {
+            eos.heap.deadline[i] = e->deadline;
+            eos.heap.deadline_num[i] = 1;
+        }
+        else if (eos.heap.deadline[i] == e->deadline) {
+            eos.heap.deadline_num[i] ++;
+        }
+    }
+}
+
+// 事件处理完成时，统计是否错过了截止时刻。
+static void eos_deadline_count(eos_u8_t priority, eos_time_t deadline)
+{
+    if (deadline == EOS_TIME_MAX)
+        return;
+
+    eos_deadline_stats_t *stats = &eos.deadline_stats[priority];
+    eos_time_t time = eos_time();
+    stats->count ++;
+    if (time <= deadline)
+        return;
+
+    eos_u32_t late = (eos_u32_t)(time - deadline);
+    stats->missed ++;
+    stats->late_max = (late > stats->late_max) ? late : stats->late_max;
+    stats->late_total += late;
+}
+
+#if (EOS_USE_TIME_64BIT == 0)
+// 时间溢出时，队列中事件的截止时刻减去offset，再重新求取各Actor最早的截止时刻（减去offset时小于
+// offset的截止时刻归零，原本不同的截止时刻可能相同）。
+static void eos_deadline_rebase(eos_u32_t offset)
+{
+    eos_u16_t next = eos.heap.queue;
+    eos_u16_t loop_count = 0;
+    while (next != EOS_HEAP_MAX && loop_count < eos.heap.count) {
+        eos_block_t *block = (eos_block_t *)((eos_pointer_t)eos.heap.data + next);
+        eos_event_inner_t *e = (eos_event_inner_t *)((eos_pointer_t)block + sizeof(eos_block_t));
+        if (e->deadline != EOS_TIME_MAX) {
+            e->deadline = eos_time_rebase(e->deadline, offset);
+        }
+        next = block->q_next;
+        loop_count ++;
+    }
+    for (eos_u8_t i = 0; i < EOS_MAX_ACTORS; i ++) {
+        eos_heap_deadline_update(&eos.heap, i);
+    }
+}
+#endif
+#endif
+
 #if (EOS_USE_PUB_SUB != 0)
 void eos_event_sub(eos_actor_t * const me, eos_topic_t topic)
 {
+#if (EOS_USE_PREEMPT != 0)
+    eos_port_critical_enter();
+    eos.sub_table[topic] |= (1 << me->priority);
+    eos_port_critical_exit();
+#else
     eos.sub_table[topic] |= (1 << me->priority);
+#endif
 }
 
 void eos_event_unsub(eos_actor_t * const me, eos_topic_t topic)
 {
+#if (EOS_USE_PREEMPT != 0)
+    eos_port_critical_enter();
+    eos.sub_table[topic] &= ~(1 << me->priority);
+    eos_port_critical_exit();
+#else
     eos.sub_table[topic] &= ~(1 << me->priority);
+#endif
 }
 #endif
 
 #if (EOS_USE_TIME_EVENT != 0)
-void eos_event_pub_time(eos_topic_t topic, eos_u32_t time_ms, eos_bool_t oneshoot)
+// 从当前时刻开始计时，计算etimer[index]的时间单位、周期与超时时间，并放入时间轮。
+static void eos_etimer_set(eos_u16_t index, eos_u32_t time_ms)
 {
     EOS_ASSERT(time_ms != 0);
     EOS_ASSERT(time_ms <= timer_threshold[EosTimerUnit_Minute]);
-    EOS_ASSERT(eos.timer_count < EOS_MAX_TIME_EVENT);
-
-    // 检查重复，不允许重复发送。
-    for (eos_u32_t i = 0; i < eos.timer_count; i ++) {
-        EOS_ASSERT(topic != eos.etimer[i].topic);
-    }
 
-    eos_u32_t system_ms = eos.time;
+    eos_time_t system_ms = eos_time();
     eos_u8_t unit = EosTimerUnit_Ms;
     eos_u16_t period;
     for (eos_u8_t i = 0; i < EosTimerUnit_Max; i ++) {
@@ -698,294 +2073,1687 @@ void eos_event_pub_time(eos_topic_t topic, eos_u32_t time_ms, eos_bool_t oneshoo
         period = (time_ms + (timer_unit[i] >> 1)) / timer_unit[i];
         break;
     }
-    eos_u32_t timeout = (system_ms + time_ms);
-    eos.etimer[eos.timer_count ++] = (eos_event_timer_t) {
-        topic, oneshoot, unit, period, timeout
-    };
-    
-    if (eos.timeout_min > timeout) {
-        eos.timeout_min = timeout;
+    eos_time_t timeout = (system_ms + time_ms);
+#if (EOS_USE_TIMER_SLACK != 0)
+    timeout = eos_etimer_align(index, timeout);
+#endif
+    eos.etimer[index].unit = unit;
+    eos.etimer[index].period = period;
+    eos.etimer[index].timeout_ms = timeout;
+#if (EOS_USE_TIMER_EXACT != 0)
+    eos.etimer[index].period_ms = time_ms;
+#endif
+#if (EOS_USE_TIMER_WHEEL != 0)
+    eos_wheel_link(index);
+#endif
+    
+    if (eos.timeout_min > timeout) {
+        eos.timeout_min = timeout;
+    }
+#if (EOS_USE_TICKLESS != 0)
+    // 到期时刻可能提前，唤醒休眠，重新计算休眠时长。
+    eos_hook_wakeup();
+#endif
+}
+
+static eos_u16_t eos_etimer_start(eos_topic_t topic, eos_u32_t time_ms, eos_bool_t oneshoot)
+{
+    EOS_ASSERT(eos.timer_count < EOS_MAX_TIME_EVENT);
+
+#if (EOS_USE_TIMER_WHEEL != 0)
+    // 时间轮为空时，其时刻可能已远远落后，直接与系统时间同步。
+    if (eos.timer_count == 0) {
+        eos.wheel_time = eos_time();
+    }
+#endif
+    eos_u16_t index = eos.timer_count ++;
+    eos.etimer[index].topic = topic;
+    eos.etimer[index].oneshoot = oneshoot;
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+    eos.etimer[index].data = EOS_HEAP_MAX;
+    eos.etimer[index].actor = EOS_MAX_ACTORS;
+#endif
+#if (EOS_USE_TIMER_EXACT != 0)
+    eos.etimer[index].catchup = EosTimerCatchUp_All;
+    eos.etimer[index].stats = (eos_timer_stats_t) { 0, 0, 0, 0 };
+#endif
+#if (EOS_USE_TIMER_SLACK != 0)
+    eos.etimer[index].slack = 0;
+    eos.etimer[index].shift = 0;
+#endif
+#if (EOS_USE_TIMER_HANDLE != 0)
+    eos_timer_handle_alloc(index);
+#endif
+    eos_etimer_set(index, time_ms);
+
+    return index;
+}
+
+void eos_event_pub_time(eos_topic_t topic, eos_u32_t time_ms, eos_bool_t oneshoot)
+{
+#if (EOS_USE_PREEMPT != 0)
+    eos_s8_t lock = eos_sched_lock(EOS_MAX_ACTORS - 1);
+#endif
+    // 检查重复，不允许重复发送。
+#if (EOS_USE_ASSERT != 0)
+    for (eos_u32_t i = 0; i < eos.timer_count; i ++) {
+        EOS_ASSERT(topic != eos.etimer[i].topic);
+    }
+#endif
+
+    eos_etimer_start(topic, time_ms, oneshoot);
+#if (EOS_USE_PREEMPT != 0)
+    eos_sched_unlock(lock);
+#endif
+}
+
+void eos_event_pub_delay(eos_topic_t topic, eos_u32_t time_ms)
+{
+    eos_event_pub_time(topic, time_ms, EOS_True);
+}
+
+void eos_event_pub_period(eos_topic_t topic, eos_u32_t time_ms_period)
+{
+    eos_event_pub_time(topic, time_ms_period, EOS_False);
+}
+
+#if (EOS_USE_TIMER_WHEEL != 0)
+void eos_event_time_cancel(eos_topic_t topic)
+{
+#if (EOS_USE_PREEMPT != 0)
+    eos_s8_t lock = eos_sched_lock(EOS_MAX_ACTORS - 1);
+#endif
+    for (eos_u32_t i = 0; i < eos.timer_count; i ++) {
+        if (topic != eos.etimer[i].topic)
+            continue;
+        eos_wheel_unlink(i);
+        eos_wheel_remove(i);
+        i --;
+    }
+#if (EOS_USE_HRTIMER != 0)
+    eos_hrtimer_cancel(topic);
+#endif
+    // 保留原有的timeout_min，它仍然不晚于剩余定时器的超时时间。
+    if (eos.timer_count == 0) {
+        eos.timeout_min = EOS_TIME_MAX;
+    }
+#if (EOS_USE_PREEMPT != 0)
+    eos_sched_unlock(lock);
+#endif
+}
+#else
+void eos_event_time_cancel(eos_topic_t topic)
+{
+#if (EOS_USE_PREEMPT != 0)
+    eos_s8_t lock = eos_sched_lock(EOS_MAX_ACTORS - 1);
+#endif
+    eos_time_t timeout_min = EOS_TIME_MAX;
+    for (eos_u32_t i = 0; i < eos.timer_count; i ++) {
+        if (topic != eos.etimer[i].topic) {
+            timeout_min =   timeout_min > eos.etimer[i].timeout_ms ?
+                            eos.etimer[i].timeout_ms :
+                            timeout_min;
+            continue;
+        }
+        eos_etimer_remove(i);
+        i --;
+    }
+
+    eos.timeout_min = timeout_min;
+#if (EOS_USE_HRTIMER != 0)
+    eos_hrtimer_cancel(topic);
+#endif
+#if (EOS_USE_PREEMPT != 0)
+    eos_sched_unlock(lock);
+#endif
+}
+#endif
+
+#if (EOS_USE_TIMER_HANDLE != 0)
+static eos_timer_t eos_timer_start(eos_topic_t topic, eos_u32_t time_ms, eos_bool_t oneshoot)
+{
+#if (EOS_USE_PREEMPT != 0)
+    eos_s8_t lock = eos_sched_lock(EOS_MAX_ACTORS - 1);
+#endif
+    eos_u16_t id = eos.etimer[eos_etimer_start(topic, time_ms, oneshoot)].id;
+    eos_timer_t timer = (((eos_timer_t)eos.timer_handle[id].seq << 16) | id);
+#if (EOS_USE_PREEMPT != 0)
+    eos_sched_unlock(lock);
+#endif
+
+    return timer;
+}
+
+eos_timer_t eos_timer_delay(eos_topic_t topic, eos_u32_t delay_ms)
+{
+    return eos_timer_start(topic, delay_ms, EOS_True);
+}
+
+eos_timer_t eos_timer_period(eos_topic_t topic, eos_u32_t period_ms)
+{
+    return eos_timer_start(topic, period_ms, EOS_False);
+}
+
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+static eos_timer_t eos_timer_start_data(eos_actor_t * const actor,
+                                        eos_topic_t topic, eos_u32_t time_ms, eos_bool_t oneshoot,
+                                        void const *data, eos_u32_t size)
+{
+    // 数据在启动时存入事件堆，到期时整块投递。
+    eos_u16_t block_data = EOS_HEAP_MAX;
+    if (size != 0) {
+        eos_port_critical_enter();
+        eos_event_inner_t *e = eos_heap_alloc(&eos.heap, (size + sizeof(eos_event_inner_t)));
+        eos_port_critical_exit();
+        if (e == EOS_NULL)
+            return 0;
+
+        e->sub = 0;
+        e->topic = topic;
+        e->id = (actor == EOS_NULL) ? 0 : EOS_EVENT_ID_DIRECT;
+#if (EOS_USE_EDF != 0)
+        e->deadline = EOS_TIME_MAX;
+#endif
+        eos_u8_t *e_data = (eos_u8_t *)e + sizeof(eos_event_inner_t);
+        for (eos_u32_t i = 0; i < size; i ++) {
+            e_data[i] = ((eos_u8_t *)data)[i];
+        }
+        eos_block_t *block = (eos_block_t *)((eos_pointer_t)e - sizeof(eos_block_t));
+        block->pinned = 1;
+        block->queued = 0;
+        block_data = (eos_u16_t)((eos_pointer_t)block - (eos_pointer_t)eos.heap.data);
+    }
+
+#if (EOS_USE_PREEMPT != 0)
+    eos_s8_t lock = eos_sched_lock(EOS_MAX_ACTORS - 1);
+#endif
+    eos_u16_t index = eos_etimer_start(topic, time_ms, oneshoot);
+    eos.etimer[index].data = block_data;
+    eos.etimer[index].actor = (actor == EOS_NULL) ? EOS_MAX_ACTORS : actor->priority;
+    eos_u16_t id = eos.etimer[index].id;
+    eos_timer_t timer = (((eos_timer_t)eos.timer_handle[id].seq << 16) | id);
+#if (EOS_USE_PREEMPT != 0)
+    eos_sched_unlock(lock);
+#endif
+
+    return timer;
+}
+
+eos_timer_t eos_timer_delay_data(   eos_actor_t * const actor,
+                                    eos_topic_t topic, eos_u32_t delay_ms,
+                                    void const *data, eos_u32_t size)
+{
+    return eos_timer_start_data(actor, topic, delay_ms, EOS_True, data, size);
+}
+
+eos_timer_t eos_timer_period_data(  eos_actor_t * const actor,
+                                    eos_topic_t topic, eos_u32_t period_ms,
+                                    void const *data, eos_u32_t size)
+{
+    return eos_timer_start_data(actor, topic, period_ms, EOS_False, data, size);
+}
+#endif
+
+void eos_timer_cancel(eos_timer_t timer)
+{
+#if (EOS_USE_PREEMPT != 0)
+    eos_s8_t lock = eos_sched_lock(EOS_MAX_ACTORS - 1);
+#endif
+    eos_u16_t index = eos_timer_handle_index(timer);
+    if (index != EOS_TIMER_NONE) {
+#if (EOS_USE_TIMER_WHEEL != 0)
+        eos_wheel_unlink(index);
+        eos_wheel_remove(index);
+#else
+        eos_etimer_remove(index);
+#endif
+        // 保留原有的timeout_min，它仍然不晚于剩余定时器的超时时间。
+        if (eos.timer_count == 0) {
+            eos.timeout_min = EOS_TIME_MAX;
+        }
+    }
+#if (EOS_USE_PREEMPT != 0)
+    eos_sched_unlock(lock);
+#endif
+}
+
+eos_bool_t eos_timer_restart(eos_timer_t timer, eos_u32_t time_ms)
+{
+#if (EOS_USE_PREEMPT != 0)
+    eos_s8_t lock = eos_sched_lock(EOS_MAX_ACTORS - 1);
+#endif
+    eos_u16_t index = eos_timer_handle_index(timer);
+    if (index != EOS_TIMER_NONE) {
+#if (EOS_USE_TIMER_WHEEL != 0)
+        eos_wheel_unlink(index);
+#endif
+        // 推迟到期时，timeout_min保持不变，仍不晚于最早的超时时间。
+        eos_etimer_set(index, time_ms);
+    }
+#if (EOS_USE_PREEMPT != 0)
+    eos_sched_unlock(lock);
+#endif
+
+    return (index != EOS_TIMER_NONE) ? EOS_True : EOS_False;
+}
+
+#if (EOS_USE_TIMER_EXACT != 0)
+eos_bool_t eos_timer_set_catchup(eos_timer_t timer, eos_u8_t catchup)
+{
+    EOS_ASSERT(catchup < EosTimerCatchUp_Max);
+
+    eos_u16_t index = eos_timer_handle_index(timer);
+    if (index == EOS_TIMER_NONE)
+        return EOS_False;
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+    // 携带数据的时间事件，其数据块不能再携带到期次数。
+    EOS_ASSERT(catchup != EosTimerCatchUp_Coalesce || eos.etimer[index].data == EOS_HEAP_MAX);
+#endif
+    eos.etimer[index].catchup = catchup;
+
+    return EOS_True;
+}
+
+eos_bool_t eos_timer_stats(eos_timer_t timer, eos_timer_stats_t * const stats)
+{
+    eos_u16_t index = eos_timer_handle_index(timer);
+    if (index == EOS_TIMER_NONE)
+        return EOS_False;
+    *stats = eos.etimer[index].stats;
+
+    return EOS_True;
+}
+#endif
+
+#if (EOS_USE_TIMER_SLACK != 0)
+// 以nominal为名义截止时刻，重新放置etimer[index]。
+static void eos_etimer_move(eos_u16_t index, eos_time_t nominal)
+{
+#if (EOS_USE_TIMER_WHEEL != 0)
+    eos_wheel_unlink(index);
+#endif
+    eos_time_t timeout = eos_etimer_align(index, nominal);
+    eos.etimer[index].timeout_ms = timeout;
+#if (EOS_USE_TIMER_WHEEL != 0)
+    eos_wheel_link(index);
+#endif
+
+    if (eos.timeout_min > timeout) {
+        eos.timeout_min = timeout;
+    }
+#if (EOS_USE_TICKLESS != 0)
+    eos_hook_wakeup();
+#endif
+}
+
+eos_bool_t eos_timer_set_slack(eos_timer_t timer, eos_u16_t slack_ms)
+{
+#if (EOS_USE_PREEMPT != 0)
+    eos_s8_t lock = eos_sched_lock(EOS_MAX_ACTORS - 1);
+#endif
+    eos_u16_t index = eos_timer_handle_index(timer);
+    if (index != EOS_TIMER_NONE) {
+        // 名义截止时刻不变，按新的松弛量重新对齐。
+        eos_event_timer_t *etimer = &eos.etimer[index];
+        eos_time_t nominal = etimer->timeout_ms - etimer->shift;
+        etimer->slack = slack_ms;
+        eos_etimer_move(index, nominal);
+    }
+#if (EOS_USE_PREEMPT != 0)
+    eos_sched_unlock(lock);
+#endif
+
+    return (index != EOS_TIMER_NONE) ? EOS_True : EOS_False;
+}
+
+eos_bool_t eos_timer_stagger(eos_timer_t timer)
+{
+#if (EOS_USE_PREEMPT != 0)
+    eos_s8_t lock = eos_sched_lock(EOS_MAX_ACTORS - 1);
+#endif
+    eos_u16_t index = eos_timer_handle_index(timer);
+    if (index != EOS_TIMER_NONE) {
+        eos_event_timer_t *etimer = &eos.etimer[index];
+        EOS_ASSERT(etimer->oneshoot == EOS_False);
+#if (EOS_USE_TIMER_EXACT != 0)
+        eos_u32_t period = etimer->period_ms;
+#else
+        eos_u32_t period = etimer->period * timer_unit[etimer->unit];
+#endif
+        // 黄金分割序列（2^32 / phi）：每次调用得到的相位都落在已有相位之间最大的空隙附近，
+        // 任意个数的定时器都近似均匀地分布在周期之内。
+        eos.timer_phase += 0x9E3779B9U;
+        eos_u32_t phase = (eos_u32_t)(((eos_u64_t)eos.timer_phase * period) >> 32);
+        eos_etimer_move(index, eos_time() + 1 + phase);
+    }
+#if (EOS_USE_PREEMPT != 0)
+    eos_sched_unlock(lock);
+#endif
+
+    return (index != EOS_TIMER_NONE) ? EOS_True : EOS_False;
+}
+#endif
+#endif
+
+#if (EOS_USE_TIMER_WHEEL != 0)
+// timer wheel -----------------------------------------------------------------
+// 分层时间轮，每层32个槽位，第n层的一个槽位跨度为32^n毫秒。定时器按照距离时间轮当前时刻的
+// 远近放入对应的层，高层的槽位到达时，其中的定时器降级到低层，第0层的槽位到达时即到期。
+// 定时器仍存放在etimer数组中（删除时用最后一个填补空位），槽位只记录链表头。每层使用一个
+// 32位的位图记录非空槽位，可以直接跳到下一个需要处理的时刻，而不必逐毫秒推进。
+static const eos_u8_t wheel_debruijn[32] = {
+    0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+    31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+};
+
+// 从第start位（含）开始循环查找置位的位，返回其与start的距离，map不能为0。
+static eos_u32_t eos_wheel_distance(eos_u32_t map, eos_u32_t start)
+{
+    if (start != 0) {
+        map = (map >> start) | (map << (32 - start));
+    }
+
+    return wheel_debruijn[((map & (~map + 1)) * 0x077CB531U) >> 27];
+}
+
+// 根据超时时间计算槽位
+static eos_u16_t eos_wheel_slot(eos_time_t timeout_ms)
+{
+    eos_time_t time = eos.wheel_time;
+    // 已超时的定时器，放入当前时刻的槽位，在下一次推进时到期。
+    if (timeout_ms < time) {
+        return (eos_u16_t)(time & EOS_WHEEL_MASK);
+    }
+
+    eos_time_t delta = timeout_ms - time;
+    eos_u32_t level = 0;
+    while (level < (EOS_WHEEL_LEVEL - 1) &&
+           delta >= ((eos_u32_t)1 << ((level + 1) * EOS_WHEEL_BITS))) {
+        level ++;
+    }
+    // 超出最高层跨度的定时器，会在最高层循环降级，直至进入其跨度之内。
+    eos_u32_t index = (eos_u32_t)(timeout_ms >> (level * EOS_WHEEL_BITS)) & EOS_WHEEL_MASK;
+
+    return (eos_u16_t)(level * EOS_WHEEL_SIZE + index);
+}
+
+static void eos_wheel_insert(eos_u16_t index, eos_u16_t slot)
+{
+    eos_event_timer_t *timer = &eos.etimer[index];
+    eos_u16_t head = eos.wheel[slot];
+
+    timer->slot = slot;
+    timer->last = EOS_WHEEL_NONE;
+    timer->next = head;
+    if (head != EOS_WHEEL_NONE) {
+        eos.etimer[head].last = index;
+    }
+    eos.wheel[slot] = index;
+    if (slot != EOS_WHEEL_DUE) {
+        eos.wheel_map[slot >> EOS_WHEEL_BITS] |= (1U << (slot & EOS_WHEEL_MASK));
+    }
+}
+
+static void eos_wheel_link(eos_u16_t index)
+{
+    eos_wheel_insert(index, eos_wheel_slot(eos.etimer[index].timeout_ms));
+}
+
+static void eos_wheel_unlink(eos_u16_t index)
+{
+    eos_event_timer_t *timer = &eos.etimer[index];
+
+    if (timer->last != EOS_WHEEL_NONE) {
+        eos.etimer[timer->last].next = timer->next;
+    }
+    else {
+        eos.wheel[timer->slot] = timer->next;
+        if (timer->next == EOS_WHEEL_NONE && timer->slot != EOS_WHEEL_DUE) {
+            eos.wheel_map[timer->slot >> EOS_WHEEL_BITS] &=
+                ~(1U << (timer->slot & EOS_WHEEL_MASK));
+        }
+    }
+    if (timer->next != EOS_WHEEL_NONE) {
+        eos.etimer[timer->next].last = timer->last;
+    }
+}
+
+// 删除已经从时间轮中摘下的定时器，用最后一个定时器填补空位，并修正其链表。
+static void eos_wheel_remove(eos_u16_t index)
+{
+    eos_etimer_remove(index);
+    if (index == eos.timer_count)
+        return;
+
+    eos_event_timer_t *timer = &eos.etimer[index];
+    if (timer->last != EOS_WHEEL_NONE) {
+        eos.etimer[timer->last].next = index;
+    }
+    else {
+        eos.wheel[timer->slot] = index;
+    }
+    if (timer->next != EOS_WHEEL_NONE) {
+        eos.etimer[timer->next].last = index;
+    }
+}
+
+static void eos_wheel_rebuild(eos_time_t time)
+{
+    for (eos_u32_t i = 0; i <= EOS_WHEEL_DUE; i ++) {
+        eos.wheel[i] = EOS_WHEEL_NONE;
+    }
+    for (eos_u32_t i = 0; i < EOS_WHEEL_LEVEL; i ++) {
+        eos.wheel_map[i] = 0;
+    }
+    eos.wheel_time = time;
+    for (eos_u16_t i = 0; i < eos.timer_count; i ++) {
+        eos_wheel_link(i);
+    }
+}
+
+// 下一个需要处理（到期或者降级）的时刻，时间轮为空时返回EOS_TIME_MAX。
+static eos_time_t eos_wheel_next(void)
+{
+    eos_time_t time = eos.wheel_time;
+    eos_time_t next = EOS_TIME_MAX;
+
+    for (eos_u32_t level = 0; level < EOS_WHEEL_LEVEL; level ++) {
+        if (eos.wheel_map[level] == 0)
+            continue;
+
+        eos_u32_t shift = level * EOS_WHEEL_BITS;
+        eos_time_t base = (time >> shift) << shift;
+        eos_u32_t index = (eos_u32_t)(time >> shift) & EOS_WHEEL_MASK;
+        eos_u32_t distance;
+        // 第0层，或者恰好位于本层槽位的边界，当前槽位本身就需要处理。
+        if (level == 0 || base == time) {
+            distance = eos_wheel_distance(eos.wheel_map[level], index);
+        }
+        // 否则当前槽位中的定时器属于下一圈。
+        else {
+            distance = 1 + eos_wheel_distance(eos.wheel_map[level],
+                                               (index + 1) & EOS_WHEEL_MASK);
+        }
+        eos_time_t time_slot = base + (distance << shift);
+        if (next > time_slot) {
+            next = time_slot;
+        }
+    }
+
+    return next;
+}
+
+// 将槽位整体摘下，挂到到期链表上，以便逐个处理时可以安全地重新插入定时器。
+static void eos_wheel_detach(eos_u16_t slot)
+{
+    eos_u16_t head = eos.wheel[slot];
+    if (head == EOS_WHEEL_NONE)
+        return;
+
+    for (eos_u16_t i = head; i != EOS_WHEEL_NONE; i = eos.etimer[i].next) {
+        eos.etimer[i].slot = EOS_WHEEL_DUE;
+    }
+    eos.wheel[EOS_WHEEL_DUE] = head;
+    eos.wheel[slot] = EOS_WHEEL_NONE;
+    eos.wheel_map[slot >> EOS_WHEEL_BITS] &= ~(1U << (slot & EOS_WHEEL_MASK));
+}
+
+// 推进时间轮至system_time，只在需要处理的时刻停留。
+static void eos_wheel_advance(eos_time_t system_time)
+{
+    while (eos.timer_count != 0) {
+        eos_time_t time = eos_wheel_next();
+        if (time > system_time)
+            break;
+        eos.wheel_time = time;
+
+        // 从高层到低层，将到达边界的槽位降级。
+        for (eos_u32_t level = (EOS_WHEEL_LEVEL - 1); level > 0; level --) {
+            eos_u32_t shift = level * EOS_WHEEL_BITS;
+            if ((time & (((eos_u32_t)1 << shift) - 1)) != 0)
+                continue;
+            eos_wheel_detach(level * EOS_WHEEL_SIZE + ((eos_u32_t)(time >> shift) & EOS_WHEEL_MASK));
+            while (eos.wheel[EOS_WHEEL_DUE] != EOS_WHEEL_NONE) {
+                eos_u16_t index = eos.wheel[EOS_WHEEL_DUE];
+                eos_wheel_unlink(index);
+                eos_wheel_link(index);
+            }
+        }
+
+        // 第0层的槽位到期
+        eos_wheel_detach(time & EOS_WHEEL_MASK);
+        eos.wheel_time = time + 1;
+        while (eos.wheel[EOS_WHEEL_DUE] != EOS_WHEEL_NONE) {
+            eos_u16_t index = eos.wheel[EOS_WHEEL_DUE];
+            eos_event_timer_t *timer = &eos.etimer[index];
+            eos_wheel_unlink(index);
+            if (timer->oneshoot == EOS_True) {
+                eos_etimer_pub(index);
+                eos_wheel_remove(index);
+            }
+            else {
+                eos_etimer_period(index, system_time);
+                eos_wheel_link(index);
+            }
+        }
+    }
+
+    if (eos.wheel_time <= system_time) {
+        eos.wheel_time = system_time + 1;
+    }
+}
+#endif
+#endif
+
+// high-resolution timer -------------------------------------------------------
+#if (EOS_USE_HRTIMER != 0)
+// 计数器会溢出回绕，以差值的符号判断两个时刻的先后。
+#define EOS_HRTIME_BEFORE(a_, b_)           ((eos_s32_t)((a_) - (b_)) < 0)
+
+// 重新计算最早的到期时刻
+static void eos_hrtimer_update(void)
+{
+    if (eos.hrtimer_count == 0)
+        return;
+
+    eos_u32_t next = eos.hrtimer[0].timeout;
+    for (eos_u32_t i = 1; i < eos.hrtimer_count; i ++) {
+        if (EOS_HRTIME_BEFORE(eos.hrtimer[i].timeout, next)) {
+            next = eos.hrtimer[i].timeout;
+        }
+    }
+    eos.hrtimer_next = next;
+}
+
+static void eos_event_pub_hrtime(eos_topic_t topic, eos_u32_t time_us, eos_bool_t oneshoot)
+{
+    // 向上取整为计数器的计数
+    eos_u32_t count = (time_us / EOS_HRTIMER_RES_US) +
+                      (((time_us % EOS_HRTIMER_RES_US) != 0) ? 1 : 0);
+    EOS_ASSERT(count != 0);
+    EOS_ASSERT(count < 0x80000000);
+#if (EOS_USE_PREEMPT != 0)
+    eos_s8_t lock = eos_sched_lock(EOS_MAX_ACTORS - 1);
+#endif
+    EOS_ASSERT(eos.hrtimer_count < EOS_MAX_HRTIMER);
+
+    // 检查重复，不允许重复发送。
+#if (EOS_USE_ASSERT != 0)
+    for (eos_u32_t i = 0; i < eos.hrtimer_count; i ++) {
+        EOS_ASSERT(topic != eos.hrtimer[i].topic);
+    }
+#endif
+
+    eos_hrtimer_t *timer = &eos.hrtimer[eos.hrtimer_count ++];
+    timer->topic = topic;
+    timer->period = (oneshoot == EOS_True) ? 0 : count;
+    timer->timeout = eos_port_hrtime() + count;
+    if (eos.hrtimer_count == 1 || EOS_HRTIME_BEFORE(timer->timeout, eos.hrtimer_next)) {
+        eos.hrtimer_next = timer->timeout;
+    }
+#if (EOS_USE_PREEMPT != 0)
+    eos_sched_unlock(lock);
+#endif
+#if (EOS_USE_TICKLESS != 0)
+    eos_hook_wakeup();
+#endif
+}
+
+void eos_event_pub_delay_us(eos_topic_t topic, eos_u32_t delay_us)
+{
+    eos_event_pub_hrtime(topic, delay_us, EOS_True);
+}
+
+void eos_event_pub_period_us(eos_topic_t topic, eos_u32_t period_us)
+{
+    eos_event_pub_hrtime(topic, period_us, EOS_False);
+}
+
+static void eos_hrtimer_cancel(eos_topic_t topic)
+{
+    for (eos_u32_t i = 0; i < eos.hrtimer_count; i ++) {
+        if (topic != eos.hrtimer[i].topic)
+            continue;
+        eos.hrtimer[i] = eos.hrtimer[eos.hrtimer_count - 1];
+        eos.hrtimer_count --;
+        break;
+    }
+    eos_hrtimer_update();
+}
+
+static void eos_evthrtimer(void)
+{
+    if (eos.hrtimer_count == 0)
+        return;
+
+    // 最早的截止时刻未到达
+    eos_u32_t now = eos_port_hrtime();
+    if (EOS_HRTIME_BEFORE(now, eos.hrtimer_next))
+        return;
+
+    for (eos_u32_t i = 0; i < eos.hrtimer_count; i ++) {
+        eos_hrtimer_t *timer = &eos.hrtimer[i];
+        if (EOS_HRTIME_BEFORE(now, timer->timeout))
+            continue;
+        eos_event_pub_topic(timer->topic);
+        if (timer->period == 0) {
+            eos.hrtimer[i] = eos.hrtimer[eos.hrtimer_count - 1];
+            eos.hrtimer_count --;
+            i --;
+            continue;
+        }
+        // 按截止时刻推进，不累积误差；错过了多个周期时，跳过它们并保持相位。
+        timer->timeout += timer->period;
+        if (!EOS_HRTIME_BEFORE(now, timer->timeout)) {
+            eos_u32_t missed = (now - timer->timeout) / timer->period + 1;
+            timer->timeout += missed * timer->period;
+        }
+    }
+    eos_hrtimer_update();
+}
+
+eos_u32_t eos_time_deadline_us(void)
+{
+    if (eos.hrtimer_count == 0)
+        return EOS_U32_MAX;
+
+    eos_u32_t now = eos_port_hrtime();
+    if (!EOS_HRTIME_BEFORE(now, eos.hrtimer_next))
+        return 0;
+
+    eos_u32_t count = eos.hrtimer_next - now;
+    if (count >= (EOS_U32_MAX / EOS_HRTIMER_RES_US))
+        return (EOS_U32_MAX - 1);
+
+    return (count * EOS_HRTIMER_RES_US);
+}
+#endif
+
+// request & reply -------------------------------------------------------------
+#if (EOS_USE_REQUEST != 0)
+static void eos_request_clear(void)
+{
+    for (eos_u32_t i = 0; i < EOS_MAX_REQUEST; i ++) {
+        eos.request[i].id = 0;
+        eos.request[i].next = (i == (EOS_MAX_REQUEST - 1)) ? EOS_REQUEST_NONE : (i + 1);
+    }
+    eos.request_free = 0;
+    eos.request_count = 0;
+    eos.request_seq = 0;
+    eos.request_timeout_min = EOS_TIME_MAX;
+}
+
+// 释放请求的槽位，需在临界区内调用。
+static void eos_request_free(eos_u8_t slot)
+{
+    eos.request[slot].id = 0;
+    eos.request[slot].next = eos.request_free;
+    eos.request_free = slot;
+    eos.request_count --;
+    if (eos.request_count == 0) {
+        eos.request_timeout_min = EOS_TIME_MAX;
+    }
+}
+
+// 由关联ID查找槽位，ID无效或请求已结束时，返回EOS_REQUEST_NONE。需在临界区内调用。
+static eos_u8_t eos_request_find(eos_u16_t id)
+{
+    eos_u8_t slot = (eos_u8_t)(id & 0xff);
+
+    if (id == 0 || slot >= EOS_MAX_REQUEST || eos.request[slot].id != id) {
+        return EOS_REQUEST_NONE;
+    }
+
+    return slot;
+}
+
+eos_u16_t eos_request(  eos_actor_t * const me,
+                        eos_topic_t topic, void *data, eos_u32_t size,
+                        eos_topic_t topic_timeout, eos_u32_t timeout_ms)
+{
+    EOS_ASSERT(me != (eos_actor_t *)0);
+    EOS_ASSERT(timeout_ms != 0);
+    EOS_ASSERT(timeout_ms <= timer_threshold[EosTimerUnit_Minute]);
+
+    // 从空闲链表中申请槽位，请求表已满时，请求失败。
+    eos_port_critical_enter();
+    eos_u8_t slot = eos.request_free;
+    if (slot == EOS_REQUEST_NONE) {
+        eos_port_critical_exit();
+        return 0;
+    }
+    eos.request_free = eos.request[slot].next;
+    eos.request_count ++;
+    eos.request_seq = (eos.request_seq >= EOS_REQUEST_ID_SEQ_MAX) ? 1 : (eos.request_seq + 1);
+    eos_u16_t id = (eos_u16_t)((eos.request_seq << 8) | slot);
+    eos_time_t timeout = eos.time + timeout_ms;
+    eos.request[slot].id = id;
+    eos.request[slot].priority = me->priority;
+    eos.request[slot].topic_timeout = topic_timeout;
+    eos.request[slot].timeout_ms = timeout;
+    if (eos.request_timeout_min > timeout) {
+        eos.request_timeout_min = timeout;
+    }
+    eos_port_critical_exit();
+
+    // 发布请求事件，没有Actor接收此请求时，请求失败。
+    if (eos_event_pub_id(topic, id, data, size) != EosRun_OK) {
+        eos_port_critical_enter();
+        eos_request_free(slot);
+        eos_port_critical_exit();
+        return 0;
+    }
+
+    return id;
+}
+
+eos_bool_t eos_reply(eos_u16_t id, eos_topic_t topic, void *data, eos_u32_t size)
+{
+    eos_port_critical_enter();
+    eos_u8_t slot = eos_request_find(id);
+    if (slot == EOS_REQUEST_NONE) {
+        eos_port_critical_exit();
+        return EOS_False;
+    }
+    eos_u8_t priority = eos.request[slot].priority;
+    eos_request_free(slot);
+    eos_port_critical_exit();
+
+    // 回复事件直接发送给请求者
+    eos_s8_t ret = eos_event_put(   topic, (1 << priority),
+                                    (id | EOS_EVENT_ID_DIRECT), data, size);
+    EOS_ASSERT(ret >= 0);
+    (void)ret;
+
+    return EOS_True;
+}
+
+void eos_request_cancel(eos_u16_t id)
+{
+    eos_port_critical_enter();
+    eos_u8_t slot = eos_request_find(id);
+    if (slot != EOS_REQUEST_NONE) {
+        eos_request_free(slot);
+    }
+    eos_port_critical_exit();
+}
+
+static void eos_evtrequest(void)
+{
+    eos_time_t system_time = eos_time();
+
+    // 最早的截止时间未到达时，不必遍历请求表。
+    eos_port_critical_enter();
+    if (eos.request_count == 0 || system_time < eos.request_timeout_min) {
+        eos_port_critical_exit();
+        return;
+    }
+
+    // 遍历在临界区内进行，只在发送超时事件时退出。最早的截止时间在遍历中重新求取，遍历期间
+    // 新加入的请求由eos_request一同更新。
+    eos.request_timeout_min = EOS_TIME_MAX;
+    for (eos_u32_t i = 0; i < EOS_MAX_REQUEST; i ++) {
+        eos_request_t *request = &eos.request[i];
+        if (request->id == 0)
+            continue;
+        if (request->timeout_ms > system_time) {
+            if (eos.request_timeout_min > request->timeout_ms) {
+                eos.request_timeout_min = request->timeout_ms;
+            }
+            continue;
+        }
+
+        // 请求超时，将超时事件直接发送给请求者。
+        eos_u16_t id = request->id;
+        eos_topic_t topic = request->topic_timeout;
+        eos_sub_t sub = (1 << request->priority);
+        eos_request_free((eos_u8_t)i);
+        eos_port_critical_exit();
+        eos_s8_t ret = eos_event_put(topic, sub, (id | EOS_EVENT_ID_DIRECT), EOS_NULL, 0);
+        EOS_ASSERT(ret >= 0);
+        (void)ret;
+        eos_port_critical_enter();
+    }
+    eos_port_critical_exit();
+}
+#endif
+
+// topic filter ----------------------------------------------------------------
+#if (EOS_USE_TOPIC_FILTER != 0)
+static void eos_filter_clear(void)
+{
+    for (eos_u32_t i = 0; i < EOS_MAX_TOPIC_FILTER; i ++) {
+        eos.filter[i].topic = Event_Null;
+        eos.filter[i].active = 0;
+        eos.filter[i].pending = 0;
+    }
+    eos.filter_count = 0;
+    eos.filter_timeout_min = EOS_TIME_MAX;
+}
+
+// 查找主题的过滤器，没有时返回EOS_NULL。需在临界区内调用。
+static eos_filter_t *eos_filter_find(eos_topic_t topic)
+{
+    for (eos_u32_t i = 0; i < EOS_MAX_TOPIC_FILTER; i ++) {
+        if (eos.filter[i].topic == topic) {
+            return &eos.filter[i];
+        }
+    }
+
+    return EOS_NULL;
+}
+
+// 从当前时刻开始计时，需在临界区内调用。
+static void eos_filter_start(eos_filter_t * const filter)
+{
+    eos_time_t timeout = eos.time + filter->interval_ms;
+    filter->timeout_ms = timeout;
+    filter->active = 1;
+    if (eos.filter_timeout_min > timeout) {
+        eos.filter_timeout_min = timeout;
+    }
+}
+
+eos_bool_t eos_topic_filter(eos_topic_t topic, eos_u8_t mode, eos_u32_t interval_ms)
+{
+    EOS_ASSERT(topic != Event_Null);
+    EOS_ASSERT(mode < EosFilter_Max);
+    EOS_ASSERT(interval_ms != 0);
+    EOS_ASSERT(interval_ms <= timer_threshold[EosTimerUnit_Minute]);
+
+    eos_port_critical_enter();
+    eos_filter_t *filter = eos_filter_find(topic);
+    if (filter == EOS_NULL) {
+        filter = eos_filter_find(Event_Null);
+        if (filter == EOS_NULL) {
+            eos_port_critical_exit();
+            return EOS_False;
+        }
+        filter->topic = topic;
+        filter->active = 0;
+        filter->pending = 0;
+        eos.filter_count ++;
+    }
+    // 新的间隔从下一次计时开始生效。
+    filter->mode = mode;
+    filter->interval_ms = interval_ms;
+    eos_port_critical_exit();
+
+    return EOS_True;
+}
+
+void eos_topic_filter_cancel(eos_topic_t topic)
+{
+    EOS_ASSERT(topic != Event_Null);
+
+    eos_port_critical_enter();
+    eos_filter_t *filter = eos_filter_find(topic);
+    if (filter != EOS_NULL) {
+        // 保留原有的filter_timeout_min，它仍然不晚于其余过滤器的截止时刻。
+        filter->topic = Event_Null;
+        filter->active = 0;
+        filter->pending = 0;
+        eos.filter_count --;
+        if (eos.filter_count == 0) {
+            eos.filter_timeout_min = EOS_TIME_MAX;
+        }
+    }
+    eos_port_critical_exit();
+}
+
+// 发布的事件经过过滤器，返回EOS_True表示事件已被暂存，不再发布。
+static eos_bool_t eos_filter_input(eos_topic_t topic, void *data, eos_u32_t size)
+{
+    eos_port_critical_enter();
+    eos_filter_t *filter = eos_filter_find(topic);
+    if (filter == EOS_NULL) {
+        eos_port_critical_exit();
+        return EOS_False;
+    }
+#if (EOS_USE_EVENT_DATA != 0)
+    // 数据放不进过滤器的事件不经过过滤，直接发布，不影响暂存的事件与计时。
+    if (size > EOS_TOPIC_FILTER_DATA) {
+        eos_port_critical_exit();
+        return EOS_False;
+    }
+#endif
+    // 节流窗口之外的事件，立即发布，并开启窗口。
+    if (filter->mode == EosFilter_Throttle && filter->active == 0) {
+        eos_filter_start(filter);
+        eos_port_critical_exit();
+        return EOS_False;
+    }
+
+    // 暂存事件，覆盖之前暂存的事件。防抖时重新开始计时。
+#if (EOS_USE_EVENT_DATA != 0)
+    for (eos_u32_t i = 0; i < size; i ++) {
+        filter->data[i] = ((eos_u8_t *)data)[i];
+    }
+    filter->size = (eos_u8_t)size;
+#else
+    (void)data;
+    (void)size;
+#endif
+    filter->pending = 1;
+    if (filter->mode == EosFilter_Debounce) {
+        eos_filter_start(filter);
+    }
+    eos_port_critical_exit();
+#if (EOS_USE_TICKLESS != 0)
+    // 截止时刻可能提前，唤醒休眠，重新计算休眠时长。
+    eos_hook_wakeup();
+#endif
+
+    return EOS_True;
+}
+
+static void eos_evtfilter(void)
+{
+    eos_time_t system_time = eos_time();
+
+    // 最早的截止时刻未到达时，不必遍历过滤器。
+    if (eos.filter_count == 0 || system_time < eos.filter_timeout_min)
+        return;
+
+    eos_time_t timeout_min = EOS_TIME_MAX;
+    for (eos_u32_t i = 0; i < EOS_MAX_TOPIC_FILTER; i ++) {
+        eos_filter_t *filter = &eos.filter[i];
+        eos_port_critical_enter();
+        if (filter->active == 0) {
+            eos_port_critical_exit();
+            continue;
+        }
+        if (filter->timeout_ms > system_time) {
+            if (timeout_min > filter->timeout_ms) {
+                timeout_min = filter->timeout_ms;
+            }
+            eos_port_critical_exit();
+            continue;
+        }
+
+        // 到期，没有暂存的事件时结束计时。
+        filter->active = 0;
+        if (filter->pending == 0) {
+            eos_port_critical_exit();
+            continue;
+        }
+        // 发布暂存的事件，节流时开启下一个窗口。
+        filter->pending = 0;
+        eos_topic_t topic = filter->topic;
+#if (EOS_USE_EVENT_DATA != 0)
+        eos_u8_t data[EOS_TOPIC_FILTER_DATA];
+        eos_u32_t size = filter->size;
+        for (eos_u32_t j = 0; j < size; j ++) {
+            data[j] = filter->data[j];
+        }
+#endif
+        if (filter->mode == EosFilter_Throttle) {
+            eos_filter_start(filter);
+            if (timeout_min > filter->timeout_ms) {
+                timeout_min = filter->timeout_ms;
+            }
+        }
+        eos_port_critical_exit();
+#if (EOS_USE_EVENT_DATA != 0)
+        eos_s8_t ret = eos_event_pub_id(topic, 0, data, size);
+#else
+        eos_s8_t ret = eos_event_pub_id(topic, 0, EOS_NULL, 0);
+#endif
+        EOS_ASSERT(ret >= 0);
+        (void)ret;
+    }
+    // 遍历期间新开始的计时已更新了filter_timeout_min，取两者中较早的一个。
+    eos_port_critical_enter();
+    if (eos.filter_timeout_min <= system_time || eos.filter_timeout_min > timeout_min) {
+        eos.filter_timeout_min = timeout_min;
+    }
+    eos_port_critical_exit();
+}
+#endif
+
+// state tran ------------------------------------------------------------------
+#if (EOS_USE_SM_MODE != 0)
+eos_ret_t eos_tran(eos_sm_t * const me, eos_state_handler state)
+{
+    me->state = state;
+
+    return EOS_Ret_Tran;
+}
+
+eos_ret_t eos_super(eos_sm_t * const me, eos_state_handler state)
+{
+    me->state = state;
+
+    return EOS_Ret_Super;
+}
+
+eos_ret_t eos_state_top(eos_sm_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    (void)e;
+
+    return EOS_Ret_Null;
+}
+#endif
+
+// static function -------------------------------------------------------------
+#if (EOS_USE_SM_MODE != 0)
+#if (EOS_USE_SM_REGION != 0)
+// 事件依次交给各区域处理，各区域的当前状态轮流放入state。
+static void eos_sm_dispath(eos_sm_t * const me, eos_event_t const * const e)
+{
+    eos_sm_dispath_state(me, e);
+    if (me->region_count == 0)
+        return;
+
+    eos_state_handler state = me->state;
+    for (eos_u8_t i = 0; i < me->region_count; i ++) {
+        if (me->region[i].state == EOS_NULL)
+            continue;
+        me->region_current = i + 1;
+        me->state = me->region[i].state;
+        eos_sm_dispath_state(me, e);
+        me->region[i].state = me->state;
+    }
+    me->region_current = 0;
+    me->state = state;
+}
+
+static void eos_sm_dispath_state(eos_sm_t * const me, eos_event_t const * const e)
+#else
+static void eos_sm_dispath(eos_sm_t * const me, eos_event_t const * const e)
+#endif
+{
+    eos_ret_t r;
+
+    EOS_ASSERT(e != (eos_event_t *)0);
+
+#if (EOS_USE_HSM_MODE == 0)
+    eos_state_handler s = me->state;
+    eos_state_handler t;
+    
+    r = s(me, e);
+    if (r == EOS_Ret_Tran) {
+        t = me->state;
+        r = s(me, &eos_event_table[Event_Exit]);
+        EOS_ASSERT(r == EOS_Ret_Handled || r == EOS_Ret_Super);
+        r = t(me, &eos_event_table[Event_Enter]);
+        EOS_ASSERT(r == EOS_Ret_Handled || r == EOS_Ret_Super);
+        me->state = t;
+    }
+    else {
+        me->state = s;
+    }
+#else
+    eos_state_handler t = me->state;
+    eos_state_handler s;
+
+    // 层次化的处理事件
+    // 注：分为两种情况：
+    // (1) 当该状态存在数据时，处理此事件。
+    // (2) 当该状态不存在该事件时，到StateTop状态下处理此事件。
+    do {
+        s = me->state;
+        r = (*s)(me, e);                              // 执行状态S下的事件处理
+    } while (r == EOS_Ret_Super);
+
+    // 如果不存在状态转移
+    if (r != EOS_Ret_Tran) {
+        me->state = t;                                  // 更新当前状态
+        return;
+    }
+
+    // 如果存在状态转移
+    eos_state_handler target = me->state;           // 保存目标状态
+
+    // 由当前状态逐层退出，直至处理此事件的状态s
+    while (t != s) {
+        (void)HSM_TRIG_(t, Event_Exit);
+        t = eos_sm_super(me, t);
+    }
+
+    // 由s退出至最近公共祖先（LCA），再进入目标状态
+    eos_sm_tran(me, s, target);
+    t = target;
+
+    // 一级一级的钻入各层
+    while (HSM_TRIG_(t, Event_Init) == EOS_Ret_Tran) {
+        target = me->state;
+        eos_sm_enter(me, t, target);
+        t = target;
+    }
+
+    me->state = t;                                  // 更新当前状态
+#endif
+}
+
+#if (EOS_USE_HSM_MODE != 0)
+#if (EOS_USE_HSM_CACHE != 0)
+// 状态函数地址的乘法散列，由散列值的高位映射到缓存的位置。冲突时线性探测，直至空位；缓存已满
+// 时替换第一个位置。
+#define EOS_HSM_HASH(state_)                                                   \
+    ((eos_u32_t)((eos_u32_t)(eos_pointer_t)(state_) * 2654435761U))
+#define EOS_HSM_INDEX(hash_, size_)                                            \
+    ((eos_u32_t)(((eos_u64_t)(hash_) * (size_)) >> 32))
+
+// 各状态机共用结构缓存。抢占式内核中，只在查找与填入缓存时以最高的状态机优先级为天花板，状态
+// 函数在锁外执行，状态机之间仍可相互抢占。
+static eos_s8_t eos_sm_cache_lock(void)
+{
+#if (EOS_USE_PREEMPT != 0)
+    return eos_sched_lock((eos.ceiling_sm < 0) ? 0 : (eos_u8_t)eos.ceiling_sm);
+#else
+    return 0;
+#endif
+}
+
+static void eos_sm_cache_unlock(eos_s8_t lock)
+{
+#if (EOS_USE_PREEMPT != 0)
+    eos_sched_unlock(lock);
+#else
+    (void)lock;
+#endif
+}
+
+// 只清除键值，由框架的初始化调用，此时没有状态机在运行。
+static void eos_sm_cache_reset(void)
+{
+    for (eos_u32_t i = 0; i < EOS_HSM_CACHE_STATE; i ++) {
+        eos.hsm_state[i] = EOS_NULL;
+    }
+    for (eos_u32_t i = 0; i < EOS_HSM_CACHE_TRAN; i ++) {
+        eos.hsm_tran[i].source = EOS_NULL;
+    }
+}
+
+void eos_sm_cache_clear(void)
+{
+    eos_s8_t lock = eos_sm_cache_lock();
+    eos_sm_cache_reset();
+    eos_sm_cache_unlock(lock);
+}
+
+// 在缓存中查找父状态，找到时返回EOS_True。
+static eos_bool_t eos_sm_cache_super(eos_state_handler state, eos_state_handler *super)
+{
+    eos_bool_t found = EOS_False;
+    eos_u32_t home = EOS_HSM_INDEX(EOS_HSM_HASH(state), EOS_HSM_CACHE_STATE);
+    eos_s8_t lock = eos_sm_cache_lock();
+    for (eos_u32_t i = 0; i < EOS_HSM_CACHE_STATE; i ++) {
+        eos_u32_t probe = (home + i) % EOS_HSM_CACHE_STATE;
+        if (eos.hsm_state[probe] == state) {
+            *super = eos.hsm_super[probe];
+            found = EOS_True;
+            break;
+        }
+        if (eos.hsm_state[probe] == EOS_NULL)
+            break;
+    }
+    eos_sm_cache_unlock(lock);
+
+    return found;
+}
+
+// 将父状态填入缓存。查找之后可能已被其他状态机填入，重新探测。
+static void eos_sm_cache_super_put(eos_state_handler state, eos_state_handler super)
+{
+    eos_u32_t home = EOS_HSM_INDEX(EOS_HSM_HASH(state), EOS_HSM_CACHE_STATE);
+    eos_u32_t index = home;
+    eos_s8_t lock = eos_sm_cache_lock();
+    for (eos_u32_t i = 0; i < EOS_HSM_CACHE_STATE; i ++) {
+        eos_u32_t probe = (home + i) % EOS_HSM_CACHE_STATE;
+        if (eos.hsm_state[probe] == state || eos.hsm_state[probe] == EOS_NULL) {
+            index = probe;
+            break;
+        }
+    }
+    eos.hsm_state[index] = state;
+    eos.hsm_super[index] = super;
+    eos_sm_cache_unlock(lock);
+}
+
+// 在缓存中查找转移(s, target)的LCA，找到时返回EOS_True。
+static eos_bool_t eos_sm_cache_tran(eos_state_handler s, eos_state_handler target,
+                                    eos_state_handler *lca)
+{
+    eos_bool_t found = EOS_False;
+    eos_u32_t hash = EOS_HSM_HASH(s) ^ EOS_HSM_HASH((eos_pointer_t)target * 31);
+    eos_u32_t home = EOS_HSM_INDEX(hash, EOS_HSM_CACHE_TRAN);
+    eos_s8_t lock = eos_sm_cache_lock();
+    for (eos_u32_t i = 0; i < EOS_HSM_CACHE_TRAN; i ++) {
+        eos_hsm_tran_t *probe = &eos.hsm_tran[(home + i) % EOS_HSM_CACHE_TRAN];
+        if (probe->source == s && probe->target == target) {
+            *lca = probe->lca;
+            found = EOS_True;
+            break;
+        }
+        if (probe->source == EOS_NULL)
+            break;
+    }
+    eos_sm_cache_unlock(lock);
+
+    return found;
+}
+
+static void eos_sm_cache_tran_put(  eos_state_handler s, eos_state_handler target,
+                                    eos_state_handler lca)
+{
+    eos_u32_t hash = EOS_HSM_HASH(s) ^ EOS_HSM_HASH((eos_pointer_t)target * 31);
+    eos_u32_t home = EOS_HSM_INDEX(hash, EOS_HSM_CACHE_TRAN);
+    eos_hsm_tran_t *slot = &eos.hsm_tran[home];
+    eos_s8_t lock = eos_sm_cache_lock();
+    for (eos_u32_t i = 0; i < EOS_HSM_CACHE_TRAN; i ++) {
+        eos_hsm_tran_t *probe = &eos.hsm_tran[(home + i) % EOS_HSM_CACHE_TRAN];
+        if ((probe->source == s && probe->target == target) || probe->source == EOS_NULL) {
+            slot = probe;
+            break;
+        }
+    }
+    slot->source = s;
+    slot->target = target;
+    slot->lca = lca;
+    eos_sm_cache_unlock(lock);
+}
+#endif
+
+// 状态的父状态，eos_state_top没有父状态，返回EOS_NULL。
+static eos_state_handler eos_sm_super(eos_sm_t * const me, eos_state_handler state)
+{
+    eos_state_handler super = EOS_NULL;
+#if (EOS_USE_HSM_CACHE != 0)
+    if (eos_sm_cache_super(state, &super) == EOS_True) {
+        return super;
+    }
+#endif
+
+    // 用Event_Null探测父状态，不改变状态机的当前状态。
+    eos_state_handler state_bkp = me->state;
+    if (HSM_TRIG_(state, Event_Null) == EOS_Ret_Super) {
+        super = me->state;
+    }
+    me->state = state_bkp;
+
+#if (EOS_USE_HSM_CACHE != 0)
+    eos_sm_cache_super_put(state, super);
+#endif
+
+    return super;
+}
+
+// 由状态t进入其子孙状态target，自上而下进入中间的各层状态。
+static void eos_sm_enter(eos_sm_t * const me, eos_state_handler t, eos_state_handler target)
+{
+    eos_state_handler path[EOS_MAX_HSM_NEST_DEPTH];
+    eos_s32_t ip = 0;
+
+    path[0] = target;
+    for (eos_state_handler s = eos_sm_super(me, target); s != t; s = eos_sm_super(me, s)) {
+        // 层数不能大于EOS_MAX_HSM_NEST_DEPTH，target也必须是t的子孙状态
+        EOS_ASSERT(s != EOS_NULL);
+        ++ ip;
+        EOS_ASSERT(ip < EOS_MAX_HSM_NEST_DEPTH);
+        path[ip] = s;
+    }
+
+    for (; ip >= 0; ip --) {
+        (void)HSM_TRIG_(path[ip], Event_Enter);
     }
 }
 
-void eos_event_pub_delay(eos_topic_t topic, eos_u32_t time_ms)
+// 状态的层数，eos_state_top为0。
+static eos_u32_t eos_sm_depth(eos_sm_t * const me, eos_state_handler state)
 {
-    eos_event_pub_time(topic, time_ms, EOS_True);
+    eos_u32_t depth = 0;
+
+    for (state = eos_sm_super(me, state); state != EOS_NULL; state = eos_sm_super(me, state)) {
+        depth ++;
+        EOS_ASSERT(depth <= EOS_MAX_HSM_NEST_DEPTH);
+    }
+
+    return depth;
 }
 
-void eos_event_pub_period(eos_topic_t topic, eos_u32_t time_ms_period)
+// 源状态s与目标状态t的最近公共祖先（LCA），转移时由s退出至LCA，再由LCA进入t。转移到自身时，
+// 退出并重新进入，LCA为其父状态；s是t的父状态时，不退出s；t是s的父状态时，不重新进入t。
+static eos_state_handler eos_sm_lca(eos_sm_t * const me, eos_state_handler s, eos_state_handler t)
 {
-    eos_event_pub_time(topic, time_ms_period, EOS_False);
+    if (s == t)
+        return eos_sm_super(me, s);
+
+    // 先上溯到同一层，再同步上溯，不需要与层数相关的缓冲区。
+    eos_u32_t depth_s = eos_sm_depth(me, s);
+    eos_u32_t depth_t = eos_sm_depth(me, t);
+    for (; depth_s > depth_t; depth_s --) {
+        s = eos_sm_super(me, s);
+    }
+    for (; depth_t > depth_s; depth_t --) {
+        t = eos_sm_super(me, t);
+    }
+    while (s != t) {
+        s = eos_sm_super(me, s);
+        t = eos_sm_super(me, t);
+    }
+
+    return s;
 }
 
-void eos_event_time_cancel(eos_topic_t topic)
+static void eos_sm_tran(eos_sm_t * const me, eos_state_handler s, eos_state_handler target)
 {
-    eos_u32_t timeout_min = EOS_U32_MAX;
-    for (eos_u32_t i = 0; i < eos.timer_count; i ++) {
-        if (topic != eos.etimer[i].topic) {
-            timeout_min =   timeout_min > eos.etimer[i].timeout_ms ?
-                            eos.etimer[i].timeout_ms :
-                            timeout_min;
-            continue;
-        }
-        if (i == (eos.timer_count - 1)) {
-            eos.timer_count --;
-            break;
-        }
-        else {
-            eos.etimer[i] = eos.etimer[eos.timer_count - 1];
-            eos.timer_count -= 1;
-            i --;
-        }
+    eos_state_handler lca;
+#if (EOS_USE_HSM_CACHE != 0)
+    // LCA在锁外求取，查找与填入时各自加锁。
+    if (eos_sm_cache_tran(s, target, &lca) == EOS_False) {
+        lca = eos_sm_lca(me, s, target);
+        eos_sm_cache_tran_put(s, target, lca);
     }
+#else
+    lca = eos_sm_lca(me, s, target);
+#endif
 
-    eos.timeout_min = timeout_min;
+    for (; s != lca; s = eos_sm_super(me, s)) {
+        (void)HSM_TRIG_(s, Event_Exit);
+    }
+    if (target != lca) {
+        eos_sm_enter(me, lca, target);
+    }
 }
 #endif
+#endif
 
-// state tran ------------------------------------------------------------------
-#if (EOS_USE_SM_MODE != 0)
-eos_ret_t eos_tran(eos_sm_t * const me, eos_state_handler state)
+// descriptor state machine ----------------------------------------------------
+#if (EOS_USE_SM_DESC != 0)
+void eos_dsm_init(  eos_dsm_t * const me,
+                    eos_u8_t priority,
+                    void const * const parameter)
 {
-    me->state = state;
+    eos_actor_init(&me->super, priority, parameter);
+    me->super.mode = EOS_Mode_Descriptor;
+    me->state = EOS_NULL;
+    me->target = EOS_NULL;
+}
+
+eos_ret_t eos_dsm_tran(eos_dsm_t * const me, eos_state_t const * const state)
+{
+    me->target = state;
 
     return EOS_Ret_Tran;
 }
 
-eos_ret_t eos_super(eos_sm_t * const me, eos_state_handler state)
+// 状态的层数，最外层的状态为1。
+static eos_u32_t eos_dsm_depth(eos_state_t const *state)
 {
-    me->state = state;
+    eos_u32_t depth = 0;
 
-    return EOS_Ret_Super;
+    for (; state != EOS_NULL; state = state->parent) {
+        depth ++;
+        EOS_ASSERT(depth <= EOS_MAX_HSM_NEST_DEPTH);
+    }
+
+    return depth;
 }
 
-eos_ret_t eos_state_top(eos_sm_t * const me, eos_event_t const * const e)
+#if (EOS_USE_STATE_SUB != 0)
+// 订阅状态state处理的主题。
+static void eos_dsm_sub(eos_dsm_t * const me, eos_state_t const *state)
 {
-    (void)me;
-    (void)e;
+    for (eos_u32_t i = 0; i < state->topic_count; i ++) {
+        eos_event_sub(&me->super, state->topics[i]);
+    }
+}
 
-    return EOS_Ret_Null;
+// 退出状态state时取消订阅其处理的主题，仍被保留的状态kept（LCA）及其外层处理的主题除外。
+static void eos_dsm_unsub(eos_dsm_t * const me, eos_state_t const *state, eos_state_t const *kept)
+{
+    for (eos_u32_t i = 0; i < state->topic_count; i ++) {
+        eos_bool_t handled = EOS_False;
+        for (eos_state_t const *s = kept; s != EOS_NULL && handled == EOS_False; s = s->parent) {
+            for (eos_u32_t j = 0; j < s->topic_count; j ++) {
+                if (s->topics[j] == state->topics[i]) {
+                    handled = EOS_True;
+                    break;
+                }
+            }
+        }
+        if (handled == EOS_False) {
+            eos_event_unsub(&me->super, state->topics[i]);
+        }
+    }
 }
 #endif
 
-// static function -------------------------------------------------------------
-#if (EOS_USE_SM_MODE != 0)
-static void eos_sm_dispath(eos_sm_t * const me, eos_event_t const * const e)
+// 由状态t（EOS_NULL为最外层之外）进入其子孙状态target，再沿init钻入，返回最终的状态。
+static eos_state_t const *eos_dsm_enter(eos_dsm_t * const me,
+                                        eos_state_t const *t, eos_state_t const *target)
 {
-#if (EOS_USE_HSM_MODE != 0)
-    eos_state_handler path[EOS_MAX_HSM_NEST_DEPTH];
-#endif
-    eos_ret_t r;
+    eos_state_t const *path[EOS_MAX_HSM_NEST_DEPTH];
 
-    EOS_ASSERT(e != (eos_event_t *)0);
+    while (1) {
+        eos_s32_t ip = 0;
+        for (eos_state_t const *s = target; s != t; s = s->parent) {
+            // target必须是t的子孙状态
+            EOS_ASSERT(s != EOS_NULL);
+            EOS_ASSERT(ip < EOS_MAX_HSM_NEST_DEPTH);
+            path[ip ++] = s;
+        }
+        while (ip > 0) {
+            eos_state_t const *s = path[-- ip];
+#if (EOS_USE_STATE_SUB != 0)
+            eos_dsm_sub(me, s);
+#endif
+            if (s->entry != EOS_NULL) {
+                s->entry(me);
+            }
+        }
 
-#if (EOS_USE_HSM_MODE == 0)
-    eos_state_handler s = me->state;
-    eos_state_handler t;
-    
-    r = s(me, e);
-    if (r == EOS_Ret_Tran) {
-        t = me->state;
-        r = s(me, &eos_event_table[Event_Exit]);
-        EOS_ASSERT(r == EOS_Ret_Handled || r == EOS_Ret_Super);
-        r = t(me, &eos_event_table[Event_Enter]);
-        EOS_ASSERT(r == EOS_Ret_Handled || r == EOS_Ret_Super);
-        me->state = t;
-    }
-    else {
-        me->state = s;
+        if (target->init == EOS_NULL)
+            return target;
+        t = target;
+        target = target->init;
     }
-#else
-    eos_state_handler t = me->state;
-    eos_state_handler s;
+}
 
-    // 层次化的处理事件
-    // 注：分为两种情况：
-    // (1) 当该状态存在数据时，处理此事件。
-    // (2) 当该状态不存在该事件时，到StateTop状态下处理此事件。
-    do {
-        s = me->state;
-        r = (*s)(me, e);                              // 执行状态S下的事件处理
-    } while (r == EOS_Ret_Super);
+void eos_dsm_start(eos_dsm_t * const me, eos_state_t const * const state_init)
+{
+    EOS_ASSERT(state_init != EOS_NULL);
 
-    // 如果不存在状态转移
-    if (r != EOS_Ret_Tran) {
-        me->state = t;                                  // 更新当前状态
-        return;
+    me->super.enabled = EOS_True;
+    eos.actor_enabled |= (1 << me->super.priority);
+    me->state = eos_dsm_enter(me, EOS_NULL, state_init);
+}
+
+static void eos_dsm_dispath(eos_dsm_t * const me, eos_event_t const * const e)
+{
+    // 由当前状态向外层传递事件
+    eos_state_t const *s = me->state;
+    eos_ret_t r = EOS_Ret_Null;
+    for (; s != EOS_NULL; s = s->parent) {
+        if (s->handler == EOS_NULL)
+            continue;
+        r = s->handler(me, e);
+        if (r == EOS_Ret_Handled || r == EOS_Ret_Tran)
+            break;
     }
+    if (r != EOS_Ret_Tran)
+        return;
 
-    // 如果存在状态转移
-    path[0] = me->state;    // 保存目标状态
-    path[1] = t;
-    path[2] = s;
+    // 计算LCA，只比较描述符。转移到自身时，退出并重新进入。
+    eos_state_t const *target = me->target;
+    eos_state_t const *lca_s = (s == target) ? s->parent : s;
+    eos_state_t const *lca_t = target;
+    if (s != target) {
+        eos_u32_t depth_s = eos_dsm_depth(lca_s);
+        eos_u32_t depth_t = eos_dsm_depth(lca_t);
+        for (; depth_s > depth_t; depth_s --) {
+            lca_s = lca_s->parent;
+        }
+        for (; depth_t > depth_s; depth_t --) {
+            lca_t = lca_t->parent;
+        }
+        while (lca_s != lca_t) {
+            lca_s = lca_s->parent;
+            lca_t = lca_t->parent;
+        }
+    }
 
-    // exit current state to transition source s...
-    while (t != s) {
-        // exit handled?
-        if (HSM_TRIG_(t, Event_Exit) == EOS_Ret_Handled) {
-            (void)HSM_TRIG_(t, Event_Null); // find superstate of t
+    // 由当前状态逐层退出至LCA，再进入目标状态
+    for (eos_state_t const *t = me->state; t != lca_s; t = t->parent) {
+        if (t->exit != EOS_NULL) {
+            t->exit(me);
         }
-        t = me->state; // stateTgt_ holds the superstate
+#if (EOS_USE_STATE_SUB != 0)
+        // 只更新退出与进入的状态的订阅，LCA及其外层的订阅保持不变
+        eos_dsm_unsub(me, t, lca_s);
+#endif
+    }
+    if (target == lca_s) {
+        // 转移到父状态，不重新进入，仍沿init钻入
+        me->state = (target->init == EOS_NULL) ? target : eos_dsm_enter(me, target, target->init);
+    }
+    else {
+        me->state = eos_dsm_enter(me, lca_s, target);
     }
+}
+#endif
 
-    eos_s32_t ip = eos_sm_tran(me, path); // take the HSM transition
+// table state machine ---------------------------------------------------------
+#if (EOS_USE_SM_TABLE != 0)
+void eos_tsm_init(  eos_tsm_t * const me,
+                    eos_u8_t priority,
+                    void const * const parameter)
+{
+    eos_actor_init(&me->super, priority, parameter);
+    me->super.mode = EOS_Mode_Table;
+    me->table = EOS_NULL;
+    me->state = EOS_TSM_NONE;
+    me->target = EOS_TSM_NONE;
+}
 
-    // retrace the entry path in reverse (desired) order...
-    for (; ip >= 0; --ip) {
-        HSM_TRIG_(path[ip], Event_Enter); // enter path[ip]
+#if (EOS_USE_STATE_SUB != 0)
+// 由状态from转移到状态to，按二者的主题位图只订阅与取消订阅有变化的主题。from为EOS_TSM_NONE时
+// 订阅to的全部主题。
+static void eos_tsm_sub(eos_tsm_t * const me, eos_u8_t from, eos_u8_t to)
+{
+    eos_tsm_table_t const *table = me->table;
+    eos_u32_t words = ((eos_u32_t)table->topic_num + 31) / 32;
+
+    for (eos_u32_t w = 0; w < words; w ++) {
+        eos_u32_t map_from = (from == EOS_TSM_NONE) ? 0 : table->sub_map[from * words + w];
+        eos_u32_t map_to = table->sub_map[to * words + w];
+        eos_u32_t change = map_from ^ map_to;
+        for (eos_u32_t i = 0; change != 0; i ++, change >>= 1) {
+            if ((change & 1) == 0)
+                continue;
+            eos_topic_t topic = (eos_topic_t)(table->topic_min + w * 32 + i);
+            if ((map_to & (1U << i)) != 0) {
+                eos_event_sub(&me->super, topic);
+            }
+            else {
+                eos_event_unsub(&me->super, topic);
+            }
+        }
     }
-    t = path[0];    // stick the target into register
-    me->state = t; // update the next state
+}
+#endif
 
-    // 一级一级的钻入各层
-    while (HSM_TRIG_(t, Event_Init) == EOS_Ret_Tran) {
-        ip = 0;
-        path[0] = me->state;
-        (void)HSM_TRIG_(me->state, Event_Null);       // 获取其父状态
-        while (me->state != t) {
-            ip ++;
-            path[ip] = me->state;
-            (void)HSM_TRIG_(me->state, Event_Null);   // 获取其父状态
+void eos_tsm_start(eos_tsm_t * const me, eos_tsm_table_t const * const table, eos_u8_t state_init)
+{
+    EOS_ASSERT(table != EOS_NULL && table->next != EOS_NULL);
+    EOS_ASSERT(table->state_num != 0 && table->state_num < EOS_TSM_NONE);
+    EOS_ASSERT(state_init < table->state_num);
+    // 稀疏表的每一行都不越界，运行时只检查check
+    EOS_ASSERT((table->base == EOS_NULL) == (table->check == EOS_NULL));
+    if (table->base == EOS_NULL) {
+        EOS_ASSERT((eos_u32_t)table->state_num * table->topic_num <= table->size);
+    }
+    else {
+        for (eos_u32_t i = 0; i < table->state_num; i ++) {
+            EOS_ASSERT((eos_u32_t)table->base[i] + table->topic_num <= table->size);
         }
-        me->state = path[0];
-
-        // 层数不能大于MAX_NEST_DEPTH_
-        EOS_ASSERT(ip < EOS_MAX_HSM_NEST_DEPTH);
-
-        // retrace the entry path in reverse (correct) order...
-        do {
-            HSM_TRIG_(path[ip], Event_Enter);       // 进入path[ip]
-        } while (ip >= 0);
+    }
 
-        t = path[0];
+#if (EOS_USE_STATE_SUB != 0 && EOS_USE_ASSERT != 0)
+    // 主题位图与非空表项一致
+    if (table->sub_map != EOS_NULL) {
+        eos_u32_t words = ((eos_u32_t)table->topic_num + 31) / 32;
+        for (eos_u32_t s = 0; s < table->state_num; s ++) {
+            for (eos_u32_t i = 0; i < table->topic_num; i ++) {
+                eos_u32_t index = (table->base == EOS_NULL) ?
+                                  (s * table->topic_num + i) : (table->base[s] + i);
+                eos_bool_t used = (table->next[index] != EOS_TSM_NONE &&
+                                   (table->base == EOS_NULL || table->check[index] == s)) ?
+                                  EOS_True : EOS_False;
+                eos_bool_t mapped = ((table->sub_map[s * words + i / 32] >> (i % 32)) & 1) ?
+                                    EOS_True : EOS_False;
+                EOS_ASSERT(used == mapped);
+            }
+        }
     }
+#endif
 
-    me->state = t;                                  // 更新当前状态
+    me->table = table;
+    me->state = state_init;
+    me->target = state_init;
+    me->super.enabled = EOS_True;
+    eos.actor_enabled |= (1 << me->super.priority);
+#if (EOS_USE_STATE_SUB != 0)
+    if (table->sub_map != EOS_NULL) {
+        eos_tsm_sub(me, EOS_TSM_NONE, state_init);
+    }
 #endif
+    if (table->entry != EOS_NULL && table->entry[state_init] != EOS_NULL) {
+        table->entry[state_init](me);
+    }
 }
 
-#if (EOS_USE_HSM_MODE != 0)
-static eos_s32_t eos_sm_tran(eos_sm_t * const me, eos_state_handler path[EOS_MAX_HSM_NEST_DEPTH])
+void eos_tsm_tran(eos_tsm_t * const me, eos_u8_t state)
 {
-    // transition entry path index
-    eos_s32_t ip = -1;
-    eos_s32_t iq; // helper transition entry path index
-    eos_state_handler t = path[0];
-    eos_state_handler s = path[2];
-    eos_ret_t r;
-
-    // (a) 跳转到自身 s == t
-    if (s == t) {
-        HSM_TRIG_(s, Event_Exit);  // exit the source
-        return 0; // cause entering the target
-    }
+    EOS_ASSERT(state < me->table->state_num);
 
-    (void)HSM_TRIG_(t, Event_Null); // superstate of target
-    t = me->state;
-
-    // (b) check source == target->super
-    if (s == t)
-        return 0; // cause entering the target
+    me->target = state;
+}
 
-    (void)HSM_TRIG_(s, Event_Null); // superstate of src
+static void eos_tsm_dispath(eos_tsm_t * const me, eos_event_t const * const e)
+{
+    eos_tsm_table_t const *table = me->table;
+    eos_u32_t topic = (eos_u32_t)e->topic - table->topic_min;
+    // topic小于topic_min时，无符号减法回绕，同样超出范围
+    if (topic >= table->topic_num)
+        return;
 
-    // (c) check source->super == target->super
-    if (me->state == t) {
-        HSM_TRIG_(s, Event_Exit);  // exit the source
-        return 0; // cause entering the target
+    eos_u32_t index;
+    if (table->base == EOS_NULL) {
+        index = (eos_u32_t)me->state * table->topic_num + topic;
     }
-
-    // (d) check source->super == target
-    if (me->state == path[0]) {
-        HSM_TRIG_(s, Event_Exit); // exit the source
-        return -1;
+    else {
+        index = (eos_u32_t)table->base[me->state] + topic;
+        if (table->check[index] != me->state)
+            return;
     }
+    if (table->next[index] == EOS_TSM_NONE)
+        return;
 
-    // (e) check rest of source == target->super->super..
-    // and store the entry path along the way
-
-    // indicate that the LCA was not found
-    iq = 0;
-
-    // enter target and its superstate
-    ip = 1;
-    path[1] = t; // save the superstate of target
-    t = me->state; // save source->super
-
-    // find target->super->super
-    r = HSM_TRIG_(path[1], Event_Null);
-    while (r == EOS_Ret_Super) {
-        ++ ip;
-        path[ip] = me->state; // store the entry path
-        if (me->state == s) { // is it the source?
-            // indicate that the LCA was found
-            iq = 1;
-
-            // entry path must not overflow
-            EOS_ASSERT(ip < EOS_MAX_HSM_NEST_DEPTH);
-            --ip;  // do not enter the source
-            r = EOS_Ret_Handled; // terminate the loop
-        }
-        // it is not the source, keep going up
-        else
-            r = HSM_TRIG_(me->state, Event_Null);
+    me->target = table->next[index];
+    if (table->action != EOS_NULL && table->action[index] != EOS_NULL) {
+        table->action[index](me, e);
     }
+    eos_u8_t target = me->target;
+    if (target == me->state)
+        return;
 
-    // LCA found yet?
-    if (iq == 0) {
-        // entry path must not overflow
-        EOS_ASSERT(ip < EOS_MAX_HSM_NEST_DEPTH);
-
-        HSM_TRIG_(s, Event_Exit); // exit the source
-
-        // (f) check the rest of source->super
-        //                  == target->super->super...
-        iq = ip;
-        r = EOS_Ret_Null; // indicate LCA NOT found
-        do {
-            // is this the LCA?
-            if (t == path[iq]) {
-                r = EOS_Ret_Handled; // indicate LCA found
-                // do not enter LCA
-                ip = iq - 1;
-                // cause termination of the loop
-                iq = -1;
-            }
-            else
-                -- iq; // try lower superstate of target
-        } while (iq >= 0);
-
-        // LCA not found yet?
-        if (r != EOS_Ret_Handled) {
-            // (g) check each source->super->...
-            // for each target->super...
-            r = EOS_Ret_Null; // keep looping
-            do {
-                // exit t unhandled?
-                if (HSM_TRIG_(t, Event_Exit) == EOS_Ret_Handled) {
-                    (void)HSM_TRIG_(t, Event_Null);
-                }
-                t = me->state; //  set to super of t
-                iq = ip;
-                do {
-                    // is this LCA?
-                    if (t == path[iq]) {
-                        // do not enter LCA
-                        ip = iq - 1;
-                        // break out of inner loop
-                        iq = -1;
-                        r = EOS_Ret_Handled; // break outer loop
-                    }
-                    else
-                        --iq;
-                } while (iq >= 0);
-            } while (r != EOS_Ret_Handled);
-        }
+    if (table->exit != EOS_NULL && table->exit[me->state] != EOS_NULL) {
+        table->exit[me->state](me);
+    }
+#if (EOS_USE_STATE_SUB != 0)
+    if (table->sub_map != EOS_NULL) {
+        eos_tsm_sub(me, me->state, target);
     }
-
-    return ip;
-}
 #endif
+    me->state = target;
+    if (table->entry != EOS_NULL && table->entry[target] != EOS_NULL) {
+        table->entry[target](me);
+    }
+}
 #endif
 
 /* heap library ------------------------------------------------------------- */
@@ -1003,6 +3771,16 @@ void eos_heap_init(eos_heap_t * const me)
     me->size = EOS_SIZE_HEAP;
     me->empty = 1;
     me->sub_general = 0;
+#if (EOS_USE_EVENT_BLOCK != 0)
+    me->sub_blocked = 0;
+    me->sub_urgent = 0;
+#endif
+#if (EOS_USE_EDF != 0)
+    for (eos_u32_t i = 0; i < EOS_MAX_ACTORS; i ++) {
+        me->deadline[i] = EOS_TIME_MAX;
+        me->deadline_num[i] = 0;
+    }
+#endif
     me->current = EOS_HEAP_MAX;
 
     memset(me->data, 0, EOS_SIZE_HEAP);
@@ -1017,6 +3795,17 @@ void eos_heap_init(eos_heap_t * const me)
 }
 
 void * eos_heap_malloc(eos_heap_t * const me, eos_u32_t size)
+{
+    void *p = eos_heap_alloc(me, size);
+    if (p != EOS_NULL) {
+        eos_heap_queue(me, p);
+    }
+
+    return p;
+}
+
+// 申请内存块，但不放入事件队列。
+void * eos_heap_alloc(eos_heap_t * const me, eos_u32_t size)
 {
     eos_block_t * block;
     eos_s16_t remaining;
@@ -1065,9 +3854,25 @@ void * eos_heap_malloc(eos_heap_t * const me, eos_u32_t size)
         eos_block_t * block_next2 = (eos_block_t *)((eos_pointer_t)me->data + new_block->next);
         block_next2->last = (eos_u16_t)((eos_pointer_t)new_block - (eos_pointer_t)me->data);
     }
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+    block->pinned = 0;
+    block->queued = 0;
+#endif
+
+    me->error_id = 0;
+    void *p = (void *)((eos_pointer_t)block + (eos_u32_t)sizeof(eos_block_t));
+    me->count ++;
+
+    return p;
+}
+
+// 将已申请的内存块挂在事件队列的最后端。
+void eos_heap_queue(eos_heap_t * const me, void *data)
+{
+    eos_block_t * block = (eos_block_t *)((eos_pointer_t)data - sizeof(eos_block_t));
 
     /* 挂在Queue的最后端 */
-    next = me->queue;
+    eos_u16_t next = me->queue;
     eos_block_t * block_queue;
     if (me->queue == EOS_HEAP_MAX) {
         me->queue = (eos_u16_t)((eos_pointer_t)block - (eos_pointer_t)me->data);
@@ -1085,16 +3890,21 @@ void * eos_heap_malloc(eos_heap_t * const me, eos_u32_t size)
         block->q_next = EOS_HEAP_MAX;
         block->q_last = (eos_u16_t)((eos_pointer_t)block_queue - (eos_pointer_t)me->data);
     }
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+    block->queued = 1;
+#endif
 
-    me->error_id = 0;
     me->empty = 0;
-    void *p = (void *)((eos_pointer_t)block + (eos_u32_t)sizeof(eos_block_t));
-    me->count ++;
-
-    return p;
 }
 
 void eos_heap_gc(eos_heap_t * const me, void *data)
+{
+    eos_heap_release(me, data);
+    eos_heap_sub_update(me);
+}
+
+// 事件已送达所有订阅的Actor时，从Queue中删除并释放。
+static void eos_heap_release(eos_heap_t * const me, void *data)
 {
     eos_event_inner_t *e = (eos_event_inner_t *)data;
 
@@ -1129,11 +3939,22 @@ void eos_heap_gc(eos_heap_t * const me, void *data)
         }
 
         /* 释放这块内存 */
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+        // 时间事件仍持有的数据块，只从Queue中删除，下一次到期时再次投递。
+        block->queued = 0;
+        if (block->pinned == 0)
+#endif
         eos_heap_free(me, data);
     }
+}
 
-    /* 根据所有的sub重新生成sub_general */
+// 根据所有的sub重新生成sub_general。各Actor最早的截止时刻在事件入队与取出时更新，不在此处生成。
+static void eos_heap_sub_update(eos_heap_t * const me)
+{
     me->sub_general = 0;
+#if (EOS_USE_EVENT_BLOCK != 0)
+    me->sub_urgent = 0;
+#endif
     eos_u16_t next = me->queue;
     eos_u16_t loop_count = 0;
     eos_block_t *block;
@@ -1142,12 +3963,44 @@ void eos_heap_gc(eos_heap_t * const me, void *data)
         block = (eos_block_t *)((eos_pointer_t)me->data + next);
         evt = (eos_event_inner_t *)((eos_pointer_t)block + sizeof(eos_block_t));
         me->sub_general |= evt->sub;
+#if (EOS_USE_EVENT_BLOCK != 0)
+        if (block->urgent != 0) {
+            me->sub_urgent |= evt->sub;
+        }
+#endif
         next = block->q_next;
 
         loop_count ++;
     }
 }
 
+#if (EOS_USE_EDF != 0)
+// 重新求取Actor最早的截止时刻与在此时刻截止的事件数。只在此Actor最早截止的事件都已取出时调用，
+// 遍历一次队列。
+static void eos_heap_deadline_update(eos_heap_t * const me, eos_u8_t priority)
+{
+    me->deadline[priority] = EOS_TIME_MAX;
+    me->deadline_num[priority] = 0;
+    eos_u16_t next = me->queue;
+    eos_u16_t loop_count = 0;
+    while (next != EOS_HEAP_MAX && loop_count < me->count) {
+        eos_block_t *block = (eos_block_t *)((eos_pointer_t)me->data + next);
+        eos_event_inner_t *evt = (eos_event_inner_t *)((eos_pointer_t)block + sizeof(eos_block_t));
+        if ((evt->sub & (1 << priority)) != 0) {
+            if (me->deadline[priority] > evt->deadline) {
+                me->deadline[priority] = evt->deadline;
+                me->deadline_num[priority] = 1;
+            }
+            else if (me->deadline[priority] == evt->deadline) {
+                me->deadline_num[priority] ++;
+            }
+        }
+        next = block->q_next;
+        loop_count ++;
+    }
+}
+#endif
+
 void *eos_heap_get_block(eos_heap_t * const me, eos_u8_t priority)
 {
     eos_block_t * block = EOS_NULL;
@@ -1162,16 +4015,42 @@ void *eos_heap_get_block(eos_heap_t * const me, eos_u8_t priority)
         block = (eos_block_t *)((eos_pointer_t)me->data + next);
         EOS_ASSERT(block->free == 0);
         evt = (eos_event_inner_t *)((eos_pointer_t)block + sizeof(eos_block_t));
-        if ((evt->sub & (1 << priority)) == 0) {
+        // 被屏蔽的Actor只取不可阻塞的事件
+        if ((evt->sub & (1 << priority)) == 0
+#if (EOS_USE_EVENT_BLOCK != 0)
+            || (block->urgent == 0 && (me->sub_blocked & (1 << priority)) != 0)
+#endif
+            ) {
+            next = block->q_next;
+            loop_count ++;
+        }
+#if (EOS_USE_EDF != 0)
+        // 取最早截止的事件，截止时刻相同时取最老的。遇到此Actor最早的截止时刻即可停止。
+        else {
+            if (e == EOS_NULL || evt->deadline < e->deadline) {
+                e = evt;
+            }
+            if (evt->deadline == me->deadline[priority])
+                break;
             next = block->q_next;
             loop_count ++;
         }
+    }
+    if (e != EOS_NULL) {
+        e->sub &=~ (1 << priority);
+        // 被屏蔽时取出的可能是较晚截止的不可阻塞事件。最早截止的事件都已取出时，重新求取。
+        if (e->deadline == me->deadline[priority] && (-- me->deadline_num[priority]) == 0) {
+            eos_heap_deadline_update(me, priority);
+        }
+    }
+#else
         else {
             e = evt;
             evt->sub &=~ (1 << priority);
             break;
         }
     }
+#endif
 
     return (void *)e;
 }
@@ -1220,9 +4099,12 @@ void * eos_get_framework(void)
 }
 
 #if (EOS_USE_TIME_EVENT != 0)
-void eos_set_time(eos_u32_t time_ms)
+void eos_set_time(eos_time_t time_ms)
 {
     eos.time = time_ms;
+#if (EOS_USE_TIMER_WHEEL != 0)
+    eos_wheel_rebuild(time_ms);
+#endif
 }
 #endif
 
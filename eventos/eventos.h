@@ -58,22 +58,106 @@ extern "C" {
 #define EOS_USE_SM_MODE                         0       // 默认关闭状态机
 #endif
 
+#ifndef EOS_USE_HSM_CACHE
+#define EOS_USE_HSM_CACHE                       0       // 默认关闭层次状态机的结构缓存
+#endif
+
+#ifndef EOS_USE_SM_DESC
+#define EOS_USE_SM_DESC                         0       // 默认关闭描述符表驱动的层次状态机
+#endif
+
+#ifndef EOS_USE_SM_TABLE
+#define EOS_USE_SM_TABLE                        0       // 默认关闭转移表驱动的平面状态机
+#endif
+
+#ifndef EOS_USE_SM_REGION
+#define EOS_USE_SM_REGION                       0       // 默认关闭状态机的正交区域
+#endif
+
+#ifndef EOS_USE_REACTOR_TABLE
+#define EOS_USE_REACTOR_TABLE                   0       // 默认关闭Reactor的主题处理表
+#endif
+
 #ifndef EOS_USE_PUB_SUB
 #define EOS_USE_PUB_SUB                         0       // 默认关闭发布-订阅机制
 #endif
 
+#ifndef EOS_USE_STATE_SUB
+#define EOS_USE_STATE_SUB                       0       // 默认关闭状态机按状态自动订阅
+#endif
+
 #ifndef EOS_USE_TIME_EVENT
 #define EOS_USE_TIME_EVENT                      0       // 默认关闭时间事件
 #endif
 
+#ifndef EOS_USE_TIMER_WHEEL
+#define EOS_USE_TIMER_WHEEL                     0       // 默认使用线性的时间事件表
+#endif
+
+#ifndef EOS_USE_TIME_64BIT
+#define EOS_USE_TIME_64BIT                      0       // 默认使用32位的系统时间（30天回绕）
+#endif
+
+#ifndef EOS_USE_TIMER_HANDLE
+#define EOS_USE_TIMER_HANDLE                    0       // 默认关闭时间事件句柄
+#endif
+
+#ifndef EOS_USE_TIMER_PAYLOAD
+#define EOS_USE_TIMER_PAYLOAD                   0       // 默认关闭携带数据的时间事件
+#endif
+
+#ifndef EOS_USE_TIMER_EXACT
+#define EOS_USE_TIMER_EXACT                     0       // 默认周期按时间单位量化
+#endif
+
+#ifndef EOS_USE_TIMER_SLACK
+#define EOS_USE_TIMER_SLACK                     0       // 默认关闭定时器松弛与相位错开
+#endif
+
+#ifndef EOS_USE_DELAY
+#define EOS_USE_DELAY                           0       // 默认关闭延时与无栈协程
+#endif
+
+#ifndef EOS_USE_TICKLESS
+#define EOS_USE_TICKLESS                        0       // 默认关闭空闲休眠
+#endif
+
+#ifndef EOS_USE_HRTIMER
+#define EOS_USE_HRTIMER                         0       // 默认关闭高精度时间事件
+#endif
+
 #ifndef EOS_USE_EVENT_DATA
 #define EOS_USE_EVENT_DATA                      0       // 默认关闭时间事件
 #endif
 
+#ifndef EOS_USE_REQUEST
+#define EOS_USE_REQUEST                         0       // 默认关闭请求-回复机制
+#endif
+
+#ifndef EOS_USE_TOPIC_FILTER
+#define EOS_USE_TOPIC_FILTER                    0       // 默认关闭主题的防抖与节流
+#endif
+
+#ifndef EOS_USE_EVENT_BLOCK
+#define EOS_USE_EVENT_BLOCK                     0       // 默认关闭Actor的事件屏蔽
+#endif
+
+#ifndef EOS_USE_EVENT_BATCH
+#define EOS_USE_EVENT_BATCH                     0       // 默认关闭事件的批量送达
+#endif
+
 #ifndef EOS_USE_EVENT_BRIDGE
 #define EOS_USE_EVENT_BRIDGE                    0       // 默认关闭事件桥
 #endif
 
+#ifndef EOS_USE_PREEMPT
+#define EOS_USE_PREEMPT                         0       // 默认关闭抢占式内核，只在事件循环中调度
+#endif
+
+#ifndef EOS_USE_EDF
+#define EOS_USE_EDF                             0       // 默认按Actor的优先级调度
+#endif
+
 #include "eventos_def.h"
 
 /* data struct -------------------------------------------------------------- */
@@ -98,6 +182,49 @@ typedef eos_u8_t                        eos_topic_t;
 typedef eos_u16_t                       eos_topic_t;
 #endif
 
+// 系统时间（毫秒），64位时不会回绕。
+#if (EOS_USE_TIME_64BIT != 0)
+typedef eos_u64_t                       eos_time_t;
+#define EOS_TIME_MAX                    EOS_U64_MAX
+#else
+typedef eos_u32_t                       eos_time_t;
+#define EOS_TIME_MAX                    EOS_U32_MAX
+#endif
+
+#if (EOS_USE_TIMER_HANDLE != 0)
+// 时间事件的句柄，0为无效句柄。
+typedef eos_u32_t                       eos_timer_t;
+#endif
+
+#if (EOS_USE_TIMER_EXACT != 0)
+// 周期事件迟到（错过一个或多个周期）时的追赶策略
+enum {
+    EosTimerCatchUp_All = 0,                        // 补发所有错过的周期（默认）
+    EosTimerCatchUp_Skip,                           // 只发布一次，跳过错过的周期
+    EosTimerCatchUp_Coalesce,                       // 只发布一次，事件数据为合并的到期次数（eos_u32_t）
+
+    EosTimerCatchUp_Max
+};
+
+// 周期事件的时间质量统计，迟到为处理时刻与截止时刻之差（毫秒）。
+typedef struct eos_timer_stats {
+    eos_u32_t count;                                // 到期处理的次数
+    eos_u32_t missed;                               // 被跳过或者合并的周期数
+    eos_u32_t late_max;                             // 最大迟到
+    eos_u32_t late_total;                           // 累计迟到，除以count即为平均迟到
+} eos_timer_stats_t;
+#endif
+
+#if (EOS_USE_EDF != 0)
+// Actor的截止时间统计，迟到为事件处理完成的时刻与截止时刻之差（毫秒）。
+typedef struct eos_deadline_stats {
+    eos_u32_t count;                                // 处理的有截止时间的事件数
+    eos_u32_t missed;                               // 错过截止时间的事件数
+    eos_u32_t late_max;                             // 最大迟到
+    eos_u32_t late_total;                           // 累计迟到，除以missed即为平均迟到
+} eos_deadline_stats_t;
+#endif
+
 // 状态返回值的定义
 #if (EOS_USE_SM_MODE != 0)
 typedef enum eos_ret {
@@ -113,12 +240,34 @@ typedef struct eos_event {
     eos_topic_t topic;                      // 事件主题
     void *data;                             // 事件数据
     eos_u16_t size;                         // 数据长度
+#if (EOS_USE_REQUEST != 0)
+    eos_u16_t id;                           // 请求的关联ID，非请求事件为0
+#endif
 } eos_event_t;
 
 // 数据结构 - 行为树相关 --------------------------------------------------------
 // 事件处理句柄的定义
 struct eos_reactor;
 typedef void (* eos_event_handler)(struct eos_reactor *const me, eos_event_t const * const e);
+#if (EOS_USE_EVENT_BATCH != 0)
+// 批处理函数的定义，e为按发布顺序排列的count个事件
+typedef void (* eos_batch_handler)( struct eos_reactor *const me,
+                                    eos_event_t const * const e, eos_u32_t count);
+#endif
+
+#if (EOS_USE_REACTOR_TABLE != 0)
+// 主题处理表，事件按主题直接取出处理函数，不再经过处理函数中的switch。
+// 密集表：topic为EOS_NULL，handler以topic - topic_min为下标，一般定义为const，放在ROM中。
+// 散列表：topic与handler一一对应，大小为2的幂，以主题的低位为起点线性探测，Event_Null为空表项。
+//        主题稀疏时使用，由eos_reactor_table_add填入。
+typedef struct eos_reactor_table {
+    eos_topic_t const *topic;               // 散列表各表项的主题，密集表为EOS_NULL
+    eos_event_handler const *handler;       // 各表项的处理函数，EOS_NULL等同于没有登记
+    eos_event_handler handler_default;      // 没有登记的主题的处理函数，为EOS_NULL时忽略
+    eos_topic_t topic_min;                  // 密集表的第一个主题，散列表不使用
+    eos_u16_t size;                         // 表项的数量
+} eos_reactor_table_t;
+#endif
 
 #if (EOS_USE_SM_MODE != 0)
 // 状态函数句柄的定义
@@ -135,14 +284,12 @@ typedef struct eos_actor {
 #endif
 #if (EOS_MCU_TYPE == 32 || EOS_MCU_TYPE == 16)
     eos_u32_t priority              : 5;
-    eos_u32_t mode                  : 1;
+    eos_u32_t mode                  : 2;
     eos_u32_t enabled               : 1;
-    eos_u32_t reserve               : 1;
 #else
     eos_u8_t priority               : 5;
-    eos_u8_t mode                   : 1;
+    eos_u8_t mode                   : 2;
     eos_u8_t enabled                : 1;
-    eos_u8_t reserve                : 1;
 #endif
 } eos_actor_t;
 
@@ -150,16 +297,104 @@ typedef struct eos_actor {
 typedef struct eos_reactor {
     eos_actor_t super;
     eos_event_handler event_handler;
+#if (EOS_USE_DELAY != 0)
+    eos_u16_t pt;                           // 协程的续点，0为起点
+#endif
+#if (EOS_USE_REACTOR_TABLE != 0)
+    eos_reactor_table_t const *table;       // 主题处理表，没有时为EOS_NULL
+#endif
+#if (EOS_USE_EVENT_BATCH != 0)
+    eos_batch_handler batch_handler;        // 批处理函数，没有时为EOS_NULL
+#endif
 } eos_reactor_t;
 
 #if (EOS_USE_SM_MODE != 0)
+#if (EOS_USE_SM_REGION != 0)
+// 正交区域，只保存区域的当前状态
+typedef struct eos_region {
+    volatile eos_state_handler state;       // EOS_NULL为尚未启动
+} eos_region_t;
+#endif
+
 // 状态机类
 typedef struct eos_sm {
     eos_actor_t super;
     volatile eos_state_handler state;
+#if (EOS_USE_SM_REGION != 0)
+    eos_region_t *region;                   // 除0号区域（state）之外的正交区域
+    eos_u8_t region_count;
+    eos_u8_t region_current;                // 正在处理事件的区域
+#endif
 } eos_sm_t;
 #endif
 
+#if (EOS_USE_SM_DESC != 0)
+// 描述符表驱动的层次状态机类
+struct eos_dsm;
+typedef eos_ret_t (* eos_dsm_handler)(struct eos_dsm * const me, eos_event_t const * const e);
+typedef void (* eos_dsm_action)(struct eos_dsm * const me);
+
+// 状态描述符，一般定义为const，放在ROM中。状态的层次与进入、退出动作都是静态数据，转移时不再
+// 调用状态函数来探测。
+typedef struct eos_state {
+    struct eos_state const *parent;         // 父状态，最外层的状态为EOS_NULL
+    struct eos_state const *init;           // 进入后自动钻入的子孙状态，没有时为EOS_NULL
+    eos_dsm_action entry;                   // 进入动作，没有时为EOS_NULL
+    eos_dsm_action exit;                    // 退出动作，没有时为EOS_NULL
+    eos_dsm_handler handler;                // 事件处理，为EOS_NULL或未处理时交给父状态
+#if (EOS_USE_STATE_SUB != 0)
+    eos_topic_t const *topics;              // 此状态处理的主题，进入时订阅，退出时取消订阅
+    eos_u8_t topic_count;
+#endif
+} eos_state_t;
+
+typedef struct eos_dsm {
+    eos_actor_t super;
+    eos_state_t const *state;
+    eos_state_t const *target;              // 转移的目标，由eos_dsm_tran设置
+} eos_dsm_t;
+#endif
+
+#if (EOS_USE_SM_TABLE != 0)
+// 转移表驱动的平面状态机类
+struct eos_tsm;
+typedef void (* eos_tsm_action)(struct eos_tsm * const me, eos_event_t const * const e);
+typedef void (* eos_tsm_state_action)(struct eos_tsm * const me);
+
+#define EOS_TSM_NONE                            (0xff)  // 空表项，或者稀疏表中不属于任何状态
+
+// 转移表，一般定义为const，放在ROM中。以（状态，主题）为下标直接取出动作与下一个状态，不再调用
+// 状态函数。主题只覆盖[topic_min, topic_min + topic_num)，范围之外的事件被忽略。
+// 密集表：base为EOS_NULL，表项位于state * topic_num + (topic - topic_min)。
+// 稀疏表：按行位移压缩，各行的非空表项交错填入同一组数组，表项位于base[state] + (topic -
+//        topic_min)，check中记录表项所属的状态，不是当前状态时即为空表项。查找仍为O(1)。
+//        压缩可由tools/tsm_pack.py完成。
+typedef struct eos_tsm_table {
+    eos_u8_t const *next;                   // 下一个状态，EOS_TSM_NONE为空表项
+    eos_tsm_action const *action;           // 转移动作，整个表都没有动作时为EOS_NULL
+    eos_u16_t const *base;                  // 稀疏表各行的起始位置，密集表为EOS_NULL
+    eos_u8_t const *check;                  // 稀疏表各表项所属的状态，密集表为EOS_NULL
+    eos_tsm_state_action const *entry;      // 各状态的进入动作，没有时为EOS_NULL
+    eos_tsm_state_action const *exit;       // 各状态的退出动作，没有时为EOS_NULL
+    eos_u16_t size;                         // 表项的数量
+    eos_u8_t state_num;                     // 状态的数量，不超过254
+    eos_topic_t topic_min;
+    eos_topic_t topic_num;
+#if (EOS_USE_STATE_SUB != 0)
+    // 各状态的非空表项对应的主题的位图，每个状态(topic_num + 31) / 32个字，主题topic_min + i为
+    // 第i / 32个字的第i % 32位。不为EOS_NULL时按当前状态自动订阅，转移时只更新有变化的主题。
+    eos_u32_t const *sub_map;
+#endif
+} eos_tsm_table_t;
+
+typedef struct eos_tsm {
+    eos_actor_t super;
+    eos_tsm_table_t const *table;
+    eos_u8_t state;
+    eos_u8_t target;                        // 转移的目标，动作可用eos_tsm_tran修改
+} eos_tsm_t;
+#endif
+
 // api -------------------------------------------------------------------------
 // 对框架进行初始化，在各状态机初始化之前调用。
 void eos_init(void);
@@ -172,15 +407,40 @@ void eos_run(void);
 // 停止框架后，框架会在执行完当前状态机的当前事件后，清空各状态机事件队列，清空事件池，
 // 不再执行任何功能，直至框架被再次启动。
 void eos_stop(void);
-// 延时，不屏蔽事件接收（毫秒级延时，释放CPU控制权）
+// 延时（毫秒级，释放CPU控制权），只能在Reactor的事件处理函数中调用。time_ms之后，框架向该
+// Reactor发送Event_Null事件，期间仍正常接收其他事件。重复调用时重新计时。需开启EOS_USE_DELAY，
+// 未开启时调用即断言。
 void eos_delay(eos_u32_t time_ms);
-// 延时，屏蔽事件的接收（毫秒级延时，释放CPU控制权），直到延时完毕。
+// 延时，屏蔽事件的接收（不可阻塞事件除外），直到延时完毕。期间到来的事件保留在事件队列中，
+// 延时结束时先送达Event_Null，再按原有顺序送达被保留的事件。需开启EOS_USE_DELAY与
+// EOS_USE_EVENT_BLOCK，未开启时调用即断言。
 void eos_delay_unsub_event(eos_u32_t time_ms);
+#if (EOS_USE_PREEMPT != 0)
+// 抢占式内核 ------------------------------------------------------------------
+// 在发布事件的中断服务函数的开头与末尾调用。最外层的中断退出时，若中断中发布的事件使高于当前
+// Actor的Actor就绪，此Actor立即在同一个栈上执行（如同函数调用），处理完之后再回到被抢占的
+// Actor，被抢占的Actor的事件处理仍然是运行至完成的。
+void eos_isr_enter(void);
+void eos_isr_exit(void);
+// 优先级天花板：将抢占的门槛提升到ceiling，返回原来的门槛，交给eos_sched_unlock恢复。期间只有
+// 高于ceiling的Actor可以抢占，用于保护被多个不同优先级的Actor共用的用户数据。框架的各项服务
+// 在内部已有保护，可以直接在可抢占的Actor中调用。
+eos_s8_t eos_sched_lock(eos_u8_t ceiling);
+void eos_sched_unlock(eos_s8_t lock);
+#endif
 #if (EOS_USE_TIME_EVENT != 0)
 // 系统当前时间
-eos_u32_t eos_time(void);
+eos_time_t eos_time(void);
 // 系统滴答
 void eos_tick(void);
+// 系统时间前进elapsed_ms毫秒（32位时间时小于30天），用于休眠唤醒后一次性补偿流逝的时间。
+// 到期的时间事件在下一次事件循环中一并处理。
+void eos_tick_advance(eos_u32_t elapsed_ms);
+#if (EOS_USE_TICKLESS != 0)
+// 距离下一个到期时刻（时间事件或请求超时）的毫秒数，已到期时返回0，没有任何定时时返回
+// EOS_U32_MAX。在空闲回调函数中调用，以决定可以休眠多久，而不必每毫秒唤醒一次。
+eos_u32_t eos_time_deadline(void);
+#endif
 #endif
 
 // 关于Reactor -----------------------------------------------------------------
@@ -188,8 +448,50 @@ void eos_reactor_init(  eos_reactor_t * const me,
                         eos_u8_t priority,
                         void const * const parameter);
 void eos_reactor_start(eos_reactor_t * const me, eos_event_handler event_handler);
+#if (EOS_USE_REACTOR_TABLE != 0)
+// 以主题处理表启动Reactor，没有登记的主题（包括延时结束的Event_Null）交给表的handler_default。
+void eos_reactor_start_table(eos_reactor_t * const me, eos_reactor_table_t const * const table);
+// 向散列表的数组登记主题的处理函数，主题已登记时替换，表满时断言。topic须初始化为Event_Null。
+void eos_reactor_table_add( eos_topic_t *topic, eos_event_handler *handler, eos_u16_t size,
+                            eos_topic_t key, eos_event_handler event_handler);
+#endif
+#if (EOS_USE_EVENT_BATCH != 0)
+// 以批处理函数启动Reactor。每次调度时，在一次临界区内取出此Reactor最多EOS_MAX_EVENT_BATCH个
+// 待处理的事件，一次交给批处理函数，处理后一并回收。适用于高速率的数据流，如采样。事件数组位于
+// 栈上，批处理函数返回后即失效。批处理的Reactor不使用协程延时。
+void eos_reactor_start_batch(eos_reactor_t * const me, eos_batch_handler batch_handler);
+#endif
 #define EOS_HANDLER_CAST(handler)       ((eos_event_handler)(handler))
 
+#if (EOS_USE_DELAY != 0)
+// 关于无栈协程 ---------------------------------------------
+// Reactor的事件处理函数可以写成顺序执行的协程（Protothread），在延时或等待主题时返回，不阻塞
+// 其他Actor，下一个事件到来时从等待处继续执行。每个Reactor只保存2字节的续点，不占用栈，因此
+// 跨越等待的局部变量不会保留（需保存在Reactor中），协程内也不能使用switch语句，同一行内只能有
+// 一个等待。事件处理函数的参数须命名为me与e。EOS_PT_BEGIN之前的代码对每个事件都会执行，可以
+// 用来处理等待期间到来的其他事件。
+#define EOS_PT_BEGIN()                                                         \
+    switch (((eos_reactor_t *)me)->pt) { case 0:
+#define EOS_PT_END()                                                           \
+    } ((eos_reactor_t *)me)->pt = 0
+// 让出CPU，此后每个事件到来时检查条件，条件成立时继续执行。
+#define EOS_PT_WAIT(cond_)                                                     \
+    do {                                                                       \
+        ((eos_reactor_t *)me)->pt = __LINE__; return;                          \
+        case __LINE__: if (!(cond_)) return;                                   \
+    } while (0)
+// 延时结束时，Reactor收到定向发送的Event_Null事件。
+#define EOS_PT_DELAY(time_ms_)                                                 \
+    do { eos_delay(time_ms_); EOS_PT_WAIT(e->topic == Event_Null); } while (0)
+// 等待主题，Reactor需订阅该主题。
+#define EOS_PT_WAIT_TOPIC(topic_)       EOS_PT_WAIT(e->topic == (topic_))
+#if (EOS_USE_EVENT_BLOCK != 0)
+// 延时并屏蔽事件的接收，见eos_delay_unsub_event。
+#define EOS_PT_DELAY_UNSUB(time_ms_)                                           \
+    do { eos_delay_unsub_event(time_ms_); EOS_PT_WAIT(e->topic == Event_Null); } while (0)
+#endif
+#endif
+
 // 关于状态机 -----------------------------------------------
 #if (EOS_USE_SM_MODE != 0)
 // 状态机初始化函数
@@ -205,11 +507,69 @@ eos_ret_t eos_state_top(eos_sm_t * const me, eos_event_t const * const e);
 #define EOS_TRAN(target)            eos_tran((eos_sm_t * )me, (eos_state_handler)target)
 #define EOS_SUPER(super)            eos_super((eos_sm_t * )me, (eos_state_handler)super)
 #define EOS_STATE_CAST(state)       ((eos_state_handler)(state))
+
+#if (EOS_USE_SM_REGION != 0)
+// 关于正交区域 -------------------------------------------------
+// 一个状态机Actor可以包含多个正交区域，共用一个优先级与事件队列中的同一个事件，每个事件依次交给
+// 各区域的当前状态处理（0号区域为状态机本身，其后为region[0] ~ region[count - 1]）。各区域独立
+// 转移，状态函数中的EOS_TRAN只作用于当前的区域。订阅是Actor的，任一区域订阅的事件都会交给所有区域。
+// 设置区域数组，在eos_sm_init之后调用。
+void eos_sm_region_init(eos_sm_t * const me, eos_region_t * const region, eos_u8_t count);
+// 启动第index个区域（1 ~ count），与eos_sm_start相同，由初始状态进入。
+void eos_sm_region_start(eos_sm_t * const me, eos_u8_t index, eos_state_handler state_init);
+// 正在处理事件的区域，在状态函数中调用，用于多个区域共用的状态函数。
+eos_u8_t eos_sm_region(eos_sm_t * const me);
+#endif
+
+#if (EOS_USE_HSM_MODE != 0 && EOS_USE_HSM_CACHE != 0)
+// 层次状态机缓存各状态的父状态，以及每个转移（源状态，目标状态）的退出与进入序列，不再每次用
+// Event_Null调用各状态函数来探测层次结构。缓存由同一状态函数的各个状态机共用，其前提是状态的父
+// 状态固定不变。父状态依赖于运行时的变量，或者状态函数被替换时，须调用此函数清空缓存。
+void eos_sm_cache_clear(void);
+#endif
+#endif
+
+#if (EOS_USE_SM_DESC != 0)
+// 关于描述符表驱动的层次状态机 -------------------------------
+// 事件由当前状态向外层传递，直至某一层的handler返回EOS_Ret_Handled或者EOS_Ret_Tran。转移时由
+// 描述符计算LCA，只执行存在的退出与进入动作，最后沿init钻入。嵌套层数不超过EOS_MAX_HSM_NEST_DEPTH。
+// 开启EOS_USE_STATE_SUB时，状态的topics在进入动作之前订阅、退出动作之后取消订阅，当前状态及其
+// 外层都不处理的事件不再进入队列。由状态管理的主题，不要再以eos_event_sub手动订阅。
+void eos_dsm_init(  eos_dsm_t * const me,
+                    eos_u8_t priority,
+                    void const * const parameter);
+// 由最外层逐层进入初始状态，并沿init钻入。
+void eos_dsm_start(eos_dsm_t * const me, eos_state_t const * const state_init);
+eos_ret_t eos_dsm_tran(eos_dsm_t * const me, eos_state_t const * const state);
+
+#define EOS_DSM_TRAN(target)        eos_dsm_tran((eos_dsm_t *)me, &(target))
+#endif
+
+#if (EOS_USE_SM_TABLE != 0)
+// 关于转移表驱动的平面状态机 ---------------------------------
+// 事件到来时，先执行表项的动作，再转移到表项的下一个状态：退出当前状态，进入下一个状态。下一个
+// 状态与当前状态相同时为内部转移，不执行退出与进入动作。空表项对应的事件被忽略。
+// 开启EOS_USE_STATE_SUB且转移表有sub_map时，只订阅当前状态的非空表项对应的主题，空表项对应的
+// 事件不再进入队列。
+void eos_tsm_init(  eos_tsm_t * const me,
+                    eos_u8_t priority,
+                    void const * const parameter);
+// 检查转移表，并进入初始状态。
+void eos_tsm_start(eos_tsm_t * const me, eos_tsm_table_t const * const table, eos_u8_t state_init);
+// 在动作中调用，以运行时的条件改变下一个状态（如协议解析中按长度选择分支）。
+void eos_tsm_tran(eos_tsm_t * const me, eos_u8_t state);
 #endif
 
 // 关于事件 -------------------------------------------------
-// 设置不可阻塞事件（在延时时，此类事件进入，延时结束，对此类事件进行立即响应）
+#if (EOS_USE_EVENT_BLOCK != 0)
+// 设置不可阻塞事件，Actor屏蔽事件期间，此类事件仍立即送达。表已满时断言。
 void eos_event_set_unblocked(eos_topic_t topic);
+// 屏蔽Actor的事件接收（不可阻塞事件除外），不取消订阅，事件保留在事件队列中，不会丢失，
+// 也不会在每次调度时被重复扫描。
+void eos_actor_block(eos_actor_t * const me);
+// 解除屏蔽，被保留的事件按原有顺序送达。
+void eos_actor_unblock(eos_actor_t * const me);
+#endif
 #if (EOS_USE_PUB_SUB != 0)
 // 事件订阅
 void eos_event_sub(eos_actor_t * const me, eos_topic_t topic);
@@ -229,19 +589,120 @@ void eos_event_pub_topic(eos_topic_t topic);
 void eos_event_pub(eos_topic_t topic, void *data, eos_u32_t size);
 #endif
 
+#if (EOS_USE_EDF != 0)
+// 最早截止优先 ----------------------------------------------------------------
+// 事件可以带有相对的截止时间（毫秒），调度时选出持有最早截止的事件的Actor，并先送达它最早截止
+// 的事件，截止时刻相同时按优先级与发布顺序。没有截止时间的事件排在所有有截止时间的事件之后，
+// 全部没有截止时间时与按优先级调度相同。开启抢占式内核时，抢占仍按优先级。
+// 设置各主题的相对截止时间的数据空间，初始为0（没有截止时间）。
+void eos_deadline_init(eos_u16_t *deadline, eos_topic_t topic_max);
+// 设置主题的相对截止时间，此后发布的该主题的事件（包括时间事件与回复）都带有此截止时间。
+void eos_topic_deadline(eos_topic_t topic, eos_u16_t deadline_ms);
+// 发布带有截止时间的事件，deadline_ms代替主题的截止时间。不经过主题过滤，可以在中断中使用。
+void eos_event_pub_deadline(eos_topic_t topic, void *data, eos_u32_t size, eos_u16_t deadline_ms);
+// 读取Actor的截止时间统计
+void eos_deadline_stats(eos_actor_t const * const me, eos_deadline_stats_t * const stats);
+#endif
+
 #if (EOS_USE_TIME_EVENT != 0)
 // 发布延时事件
 void eos_event_pub_delay(eos_topic_t topic, eos_u32_t delay_time_ms);
 // 发布周期事件
 void eos_event_pub_period(eos_topic_t topic, eos_u32_t peroid_ms);
-// 取消延时事件或者周期事件的发布
+// 取消延时事件或者周期事件的发布（该主题的所有时间事件）
 void eos_event_time_cancel(eos_topic_t topic);
 #endif
 
+#if (EOS_USE_TIMER_HANDLE != 0)
+// 发布延时事件与周期事件，返回句柄。与上面的接口不同，同一主题可以同时存在多个时间事件，
+// 例如多个Actor在同一个主题上各自计时。
+eos_timer_t eos_timer_delay(eos_topic_t topic, eos_u32_t delay_ms);
+eos_timer_t eos_timer_period(eos_topic_t topic, eos_u32_t period_ms);
+// 按句柄取消，或者从当前时刻重新计时（如看门狗的喂狗），时间复杂度为O(1)。句柄已失效（单次
+// 事件已到期，或者已被取消）时，取消不做任何事，重新计时返回EOS_False。
+void eos_timer_cancel(eos_timer_t timer);
+eos_bool_t eos_timer_restart(eos_timer_t timer, eos_u32_t time_ms);
+#endif
+
+#if (EOS_USE_TIMER_EXACT != 0)
+// 周期事件按精确的周期（毫秒）对齐到绝对的截止时刻，不随处理时刻漂移。设置追赶策略，读取时间
+// 质量统计，句柄已失效时返回EOS_False。
+eos_bool_t eos_timer_set_catchup(eos_timer_t timer, eos_u8_t catchup);
+eos_bool_t eos_timer_stats(eos_timer_t timer, eos_timer_stats_t * const stats);
+#endif
+
+#if (EOS_USE_TIMER_SLACK != 0)
+// 设置松弛量：定时器可以在截止时刻之后的slack_ms之内到期，框架在此范围内选择对齐的时刻，使临近
+// 的多个到期合并为一次唤醒。周期事件的名义截止时刻仍按周期推进，松弛量应小于周期。
+eos_bool_t eos_timer_set_slack(eos_timer_t timer, eos_u16_t slack_ms);
+// 错开相位：将周期事件的下一次到期移到(0, 周期]之内的某个时刻，依次调用的多个相同周期的定时器
+// 均匀地分布在周期之内，避免同时到期。句柄已失效时返回EOS_False。
+eos_bool_t eos_timer_stagger(eos_timer_t timer);
+#endif
+
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+// 发布携带数据的延时事件与周期事件，返回句柄（事件堆不足时返回0）。数据在启动时复制到事件堆中，
+// 只复制这一次，到期时直接投递该数据块，周期事件每个周期投递同一个数据块（上一次尚未处理完时，
+// 合并为一次）。actor不为EOS_NULL时，事件只发送给该Actor，不经过订阅表。数据块在单次事件
+// 处理完毕、或者时间事件被取消后释放。
+eos_timer_t eos_timer_delay_data(   eos_actor_t * const actor,
+                                    eos_topic_t topic, eos_u32_t delay_ms,
+                                    void const *data, eos_u32_t size);
+eos_timer_t eos_timer_period_data(  eos_actor_t * const actor,
+                                    eos_topic_t topic, eos_u32_t period_ms,
+                                    void const *data, eos_u32_t size);
+#endif
+
+#if (EOS_USE_HRTIMER != 0)
+// 发布微秒级的延时事件与周期事件，由移植层的自由计数器eos_port_hrtime()驱动，不依赖滴答中断。
+// 时间按EOS_HRTIMER_RES_US向上取整，最长为2^31个计数。周期事件按截止时刻推进，不累积误差。
+// 使用eos_event_time_cancel取消。
+void eos_event_pub_delay_us(eos_topic_t topic, eos_u32_t delay_us);
+void eos_event_pub_period_us(eos_topic_t topic, eos_u32_t period_us);
+// 距离下一个高精度时间事件到期的微秒数，已到期时返回0，没有时返回EOS_U32_MAX。
+eos_u32_t eos_time_deadline_us(void);
+#endif
+
+#if (EOS_USE_REQUEST != 0)
+// 关于请求与回复 ---------------------------------------------
+// 发布请求事件，返回关联ID（失败时返回0）。若在timeout_ms内未收到回复，框架会将超时事件
+// topic_timeout直接发送给请求者，超时事件与回复事件均携带与请求相同的关联ID。
+eos_u16_t eos_request(  eos_actor_t * const me,
+                        eos_topic_t topic, void *data, eos_u32_t size,
+                        eos_topic_t topic_timeout, eos_u32_t timeout_ms);
+// 回复请求，回复事件直接发送给请求者，不经过订阅表。请求已超时或已被回复时，返回EOS_False。
+eos_bool_t eos_reply(eos_u16_t id, eos_topic_t topic, void *data, eos_u32_t size);
+// 取消尚未回复的请求
+void eos_request_cancel(eos_u16_t id);
+#define EOS_REQUEST(_evt, _data, _size, _evt_timeout, _time_ms)                \
+    eos_request(&(me->super.super), _evt, _data, _size, _evt_timeout, _time_ms)
+#endif
+
+#if (EOS_USE_TOPIC_FILTER != 0)
+// 关于主题的防抖与节流 ---------------------------------------
+enum {
+    EosFilter_Debounce = 0,                         // 防抖：安静interval_ms之后，发布最后一次的事件
+    EosFilter_Throttle,                             // 节流：每interval_ms最多发布一次，见下
+
+    EosFilter_Max
+};
+// 为主题设置防抖或者节流，此后该主题的发布（包括时间事件）都经过过滤。节流时，窗口之外的事件
+// 立即发布并开启窗口，窗口之内的事件暂存，窗口结束时发布最后一次的事件，并开启下一个窗口。被暂存
+// 的事件不申请事件内存，只在过滤器中保留最后一次的数据。数据超过EOS_TOPIC_FILTER_DATA字节的事件
+// 不经过过滤，照常发布。已设置的主题更新其方式与间隔，过滤器已满时返回EOS_False。
+eos_bool_t eos_topic_filter(eos_topic_t topic, eos_u8_t mode, eos_u32_t interval_ms);
+// 取消主题的过滤，暂存的事件被丢弃。
+void eos_topic_filter_cancel(eos_topic_t topic);
+#endif
+
 /* port --------------------------------------------------------------------- */
 void eos_port_critical_enter(void);
 void eos_port_critical_exit(void);
 void eos_port_assert(eos_u32_t error_id);
+#if (EOS_USE_HRTIMER != 0)
+// 自由运行的计数器，每个计数为EOS_HRTIMER_RES_US微秒，允许溢出回绕。
+eos_u32_t eos_port_hrtime(void);
+#endif
 
 /* hook --------------------------------------------------------------------- */
 // 空闲回调函数
@@ -253,6 +714,12 @@ void eos_hook_stop(void);
 // 启动EventOS Nano的时候，所调用的回调函数
 void eos_hook_start(void);
 
+#if (EOS_USE_TICKLESS != 0)
+// 有事件发布或者启动了时间事件时调用的回调函数，用于唤醒在空闲回调函数中休眠的框架。
+// 可能在中断或者其他线程中被调用。
+void eos_hook_wakeup(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
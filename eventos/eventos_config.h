@@ -34,6 +34,14 @@
 #ifndef EVENTOS_CONFIG_H__
 #define EVENTOS_CONFIG_H__
 
+/* User Configuration ------------------------------------------------------- */
+// 定义了EOS_CONFIG_USER的工程使用自己的配置文件eos_config_user.h（位于工程的头文件路径中），代替
+// 下面的默认配置，其中未配置的功能按eventos.h中的默认值关闭。单元测试、POSIX示例与性能测试各有
+// 自己的配置文件。下面的默认配置只打开基本的功能，其余的功能按需打开。
+#if defined(EOS_CONFIG_USER)
+#include "eos_config_user.h"
+#else
+
 /* EventOS Nano General Configuration --------------------------------------- */
 #define EOS_MCU_TYPE                            32
 #define EOS_MAX_ACTORS                          4
@@ -48,25 +56,86 @@
 #define EOS_USE_SM_MODE                         1
 #define EOS_USE_HSM_MODE                        1
 #if (EOS_USE_SM_MODE != 0 && EOS_USE_HSM_MODE != 0)
-#define EOS_MAX_HSM_NEST_DEPTH                  4
+#define EOS_MAX_HSM_NEST_DEPTH                  4           // 最大嵌套层数（不含eos_state_top）
+#define EOS_USE_HSM_CACHE                       0           // 缓存父状态与转移路径
+#if (EOS_USE_HSM_CACHE != 0)
+    #define EOS_HSM_CACHE_STATE                 32          // 父状态缓存的数量
+    #define EOS_HSM_CACHE_TRAN                  16          // 转移路径缓存的数量
+#endif
+#define EOS_USE_SM_DESC                         0           // 描述符表驱动的层次状态机
 #endif
+#define EOS_USE_SM_TABLE                        0           // 转移表驱动的平面状态机
+#define EOS_USE_SM_REGION                       0           // 状态机的正交区域
+
+/* Reactor Function Configuration ------------------------------------------- */
+#define EOS_USE_REACTOR_TABLE                   0           // Reactor按主题查表分发事件
 
 /* Publish & Subscribe Configuration ---------------------------------------- */
 #define EOS_USE_PUB_SUB                         1
+#if (EOS_USE_PUB_SUB != 0)
+    #define EOS_USE_STATE_SUB                   0           // 状态机按当前状态自动订阅主题
+#endif
 
 /* Time Event Configuration ------------------------------------------------- */
 #define EOS_USE_TIME_EVENT                      1
 #if (EOS_USE_TIME_EVENT != 0)
     #define EOS_MAX_TIME_EVENT                  4           // 时间事件的数量
+    #define EOS_USE_TIMER_WHEEL                 0           // 使用分层时间轮管理时间事件
+    #define EOS_USE_TIME_64BIT                  0           // 64位的系统时间，不再处理30天回绕
+    #define EOS_USE_TIMER_HANDLE                0           // 按句柄取消与重新计时，同一主题可有多个
+    #define EOS_USE_TIMER_PAYLOAD               0           // 携带数据、可定向发送的时间事件
+    #define EOS_USE_TIMER_EXACT                 0           // 精确周期、追赶策略与迟到统计
+    #define EOS_USE_TIMER_SLACK                 0           // 定时器松弛（合并唤醒）与相位错开
+    #define EOS_USE_DELAY                       0           // 延时与无栈协程式的Reactor
+    #define EOS_USE_TICKLESS                    0           // 空闲时休眠至下一个到期时刻
+    #define EOS_USE_HRTIMER                     0           // 高精度（微秒级）时间事件
+    #if (EOS_USE_HRTIMER != 0)
+    #define EOS_MAX_HRTIMER                     4           // 高精度时间事件的数量
+    #define EOS_HRTIMER_RES_US                  1           // 高精度计数器的分辨率（微秒）
+    #endif
 #endif
 
 /* Event's Data Configuration ----------------------------------------------- */
 #define EOS_USE_EVENT_DATA                      1
 #define EOS_SIZE_HEAP                           32767       // 设定堆大小
 
+/* Request & Response Configuration ----------------------------------------- */
+#define EOS_USE_REQUEST                         0
+#if (EOS_USE_REQUEST != 0)
+    // 同时等待回复的请求数量，1 ~ 255。关联ID的低8位为槽位，高7位为序号，故不超过255。
+    #define EOS_MAX_REQUEST                     16
+#endif
+
+/* Topic Filter Configuration ----------------------------------------------- */
+#define EOS_USE_TOPIC_FILTER                    0
+#if (EOS_USE_TOPIC_FILTER != 0)
+    #define EOS_MAX_TOPIC_FILTER                8           // 防抖与节流的主题数量
+    #define EOS_TOPIC_FILTER_DATA               8           // 暂存的事件数据的最大长度（字节）
+#endif
+
+/* Event Block Configuration ------------------------------------------------ */
+#define EOS_USE_EVENT_BLOCK                     0
+#if (EOS_USE_EVENT_BLOCK != 0)
+    #define EOS_MAX_UNBLOCKED                   8           // 不可阻塞事件的主题数量
+#endif
+
+/* Event Batch Configuration ------------------------------------------------ */
+#define EOS_USE_EVENT_BATCH                     0
+#if (EOS_USE_EVENT_BATCH != 0)
+    #define EOS_MAX_EVENT_BATCH                 8           // 一次交给批处理函数的最大事件数
+#endif
+
+/* Preemptive Kernel Configuration ------------------------------------------ */
+#define EOS_USE_PREEMPT                         0           // 中断退出时抢占低优先级的Actor
+
+/* EDF Scheduling Configuration --------------------------------------------- */
+#define EOS_USE_EDF                             0           // 按事件的截止时间（最早截止优先）调度
+
 /* Event Bridge Configuration ----------------------------------------------- */
 #define EOS_USE_EVENT_BRIDGE                    0
 
+#endif
+
 /* Error -------------------------------------------------------------------- */
 #if ((EOS_MCU_TYPE != 8) && (EOS_MCU_TYPE != 16) && (EOS_MCU_TYPE != 32))
 #error The MCU type must be 8-bit, 16-bit or 32-bit !
@@ -82,14 +151,128 @@
 
 #if (EOS_USE_SM_MODE != 0)
     #if (EOS_USE_HSM_MODE != 0)
-        #if (EOS_MAX_HSM_NEST_DEPTH > 4 || EOS_MAX_HSM_NEST_DEPTH < 2)
-            #error The maximum nested depth of hsm must be 2 ~ 4 !
+        #if (EOS_MAX_HSM_NEST_DEPTH > 32 || EOS_MAX_HSM_NEST_DEPTH < 2)
+            #error The maximum nested depth of hsm must be 2 ~ 32 !
+        #endif
+        #if (EOS_USE_HSM_CACHE != 0)
+            #if (EOS_HSM_CACHE_STATE <= 0 || EOS_HSM_CACHE_TRAN <= 0)
+                #error The size of the hsm cache must be larger than 0 !
+            #endif
         #endif
     #endif
 #endif
 
-#if (EOS_USE_TIME_EVENT != 0 && EOS_MAX_TIME_EVENT >= 256)
-    #error The number of time events must be less than 256 !
+#if (EOS_USE_HSM_CACHE != 0 && (EOS_USE_SM_MODE == 0 || EOS_USE_HSM_MODE == 0))
+    #error The hsm cache depends on the hsm mode !
+#endif
+
+#if (EOS_USE_SM_DESC != 0 && (EOS_USE_SM_MODE == 0 || EOS_USE_HSM_MODE == 0))
+    #error The descriptor state machine depends on the hsm mode !
+#endif
+
+#if (EOS_USE_SM_REGION != 0 && EOS_USE_SM_MODE == 0)
+    #error The orthogonal region depends on the state machine mode !
+#endif
+
+#if (EOS_USE_STATE_SUB != 0 && EOS_USE_PUB_SUB == 0)
+    #error The state subscription depends on the publish-subscribe function !
+#endif
+
+#if (EOS_USE_TIME_EVENT != 0)
+    #if (EOS_USE_TIMER_WHEEL == 0 && EOS_MAX_TIME_EVENT >= 256)
+        #error The number of time events must be less than 256 !
+    #endif
+    #if (EOS_USE_TIMER_WHEEL != 0 && EOS_MAX_TIME_EVENT >= 65535)
+        #error The number of time events must be less than 65535 when the timer wheel is used !
+    #endif
+#endif
+
+#if (EOS_USE_TIMER_HANDLE != 0 && EOS_USE_TIME_EVENT == 0)
+    #error The timer handle function depends on the time event function !
+#endif
+
+#if (EOS_USE_TIMER_PAYLOAD != 0 && (EOS_USE_TIMER_HANDLE == 0 || EOS_USE_EVENT_DATA == 0))
+    #error The timer payload function depends on the timer handle and event data functions !
+#endif
+
+#if (EOS_USE_TIMER_EXACT != 0 && (EOS_USE_TIMER_HANDLE == 0 || EOS_USE_EVENT_DATA == 0))
+    #error The exact periodic timer depends on the timer handle and event data functions !
+#endif
+
+#if (EOS_USE_TIMER_SLACK != 0 && EOS_USE_TIMER_HANDLE == 0)
+    #error The timer slack function depends on the timer handle function !
+#endif
+
+#if (EOS_USE_DELAY != 0 && EOS_USE_TIME_EVENT == 0)
+    #error The delay function depends on the time event function !
+#endif
+
+#if (EOS_USE_TICKLESS != 0 && EOS_USE_TIME_EVENT == 0)
+    #error The tickless idle function depends on the time event function !
+#endif
+
+#if (EOS_USE_HRTIMER != 0)
+    #if (EOS_USE_TIME_EVENT == 0)
+        #error The high-resolution timer depends on the time event function !
+    #endif
+    #if (EOS_MAX_HRTIMER <= 0 || EOS_MAX_HRTIMER >= 256)
+        #error The number of high-resolution timers must be 1 ~ 255 !
+    #endif
+    #if (EOS_HRTIMER_RES_US <= 0 || (1000 % EOS_HRTIMER_RES_US) != 0)
+        #error The resolution of the high-resolution timer must be a divisor of 1000us !
+    #endif
+#endif
+
+#if (EOS_USE_REQUEST != 0)
+    #if (EOS_USE_TIME_EVENT == 0)
+        #error The request function depends on the time event function !
+    #endif
+    #if (EOS_MAX_REQUEST <= 0 || EOS_MAX_REQUEST >= 256)
+        #error The number of requests must be 1 ~ 255 !
+    #endif
+#endif
+
+#if (EOS_USE_TOPIC_FILTER != 0)
+    #if (EOS_USE_TIME_EVENT == 0)
+        #error The topic filter function depends on the time event function !
+    #endif
+    #if (EOS_MAX_TOPIC_FILTER <= 0 || EOS_MAX_TOPIC_FILTER >= 256)
+        #error The number of topic filters must be 1 ~ 255 !
+    #endif
+    #if (EOS_TOPIC_FILTER_DATA < 0 || EOS_TOPIC_FILTER_DATA >= 256)
+        #error The data size of the topic filter must be 0 ~ 255 !
+    #endif
+#endif
+
+#if (EOS_USE_EVENT_BLOCK != 0)
+    #if (EOS_USE_EVENT_DATA == 0)
+        #error The event block function depends on the event data function !
+    #endif
+    #if (EOS_MAX_UNBLOCKED <= 0 || EOS_MAX_UNBLOCKED >= 256)
+        #error The number of unblocked topics must be 1 ~ 255 !
+    #endif
+#endif
+
+#if (EOS_USE_EVENT_BATCH != 0)
+    #if (EOS_USE_EVENT_DATA == 0)
+        #error The event batch function depends on the event data function !
+    #endif
+    #if (EOS_MAX_EVENT_BATCH <= 0 || EOS_MAX_EVENT_BATCH >= 256)
+        #error The number of batched events must be 1 ~ 255 !
+    #endif
+#endif
+
+#if (EOS_USE_PREEMPT != 0 && EOS_USE_EVENT_DATA == 0)
+    #error The preemptive kernel depends on the event data function !
+#endif
+
+#if (EOS_USE_EDF != 0)
+    #if (EOS_USE_EVENT_DATA == 0)
+        #error The EDF scheduling depends on the event data function !
+    #endif
+    #if (EOS_USE_TIME_EVENT == 0)
+        #error The EDF scheduling depends on the time event function !
+    #endif
 #endif
 
 #if (EOS_USE_EVENT_DATA != 0)
@@ -43,6 +43,7 @@ typedef unsigned short                  eos_u16_t;
 typedef signed short                    eos_s16_t;
 typedef unsigned char                   eos_u8_t;
 typedef signed char                     eos_s8_t;
+typedef unsigned long long              eos_u64_t;
 
 typedef enum eos_bool {
     EOS_False = 0,
@@ -51,6 +52,8 @@ typedef enum eos_bool {
 
 #define EOS_NULL                        ((void *)0)
 
+#define EOS_U64_MAX                     0xffffffffffffffffULL
+
 #define EOS_U32_MAX                     0xffffffff
 #define EOS_U32_MIN                     0
 
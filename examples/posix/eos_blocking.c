@@ -0,0 +1,47 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_blocking.h"
+#include "eos_coroutine.h"
+#include "eventos.h"
+#include "event_def.h"
+#include <unistd.h>
+#include <stdio.h>
+
+// 在协程Actor中调用阻塞的第三方库：阻塞调用在工作线程中执行，期间LED状态机与抖动测量照常
+// 运行，调用返回后协程从原处继续，再延时1秒。
+
+#if (EOS_USE_DELAY != 0)
+/* data structure ----------------------------------------------------------- */
+static eos_coroutine_t blocking;
+static eos_u8_t blocking_stack[EOS_COROUTINE_STACK_MIN * 2];
+
+/* static function ---------------------------------------------------------- */
+// 模拟阻塞的库函数，如套接字的接收
+static void *blocking_read(void *arg)
+{
+    usleep(300000);
+
+    return arg;
+}
+
+static void blocking_entry(eos_coroutine_t * const me)
+{
+    eos_u32_t count = 0;
+
+    while (1) {
+        eos_u32_t *ret = eos_coroutine_call(me, blocking_read, &count);
+        (*ret) ++;
+        printf("Coroutine: blocking call %u returned at %u ms.\n",
+               count, (eos_u32_t)eos_time());
+        eos_coroutine_delay(me, 1000);
+    }
+}
+#endif
+
+/* api ---------------------------------------------------------------------- */
+void eos_blocking_init(void)
+{
+#if (EOS_USE_DELAY != 0)
+    eos_coroutine_init(&blocking, 3, Event_Coroutine, blocking_stack, sizeof(blocking_stack));
+    eos_coroutine_start(&blocking, blocking_entry);
+#endif
+}
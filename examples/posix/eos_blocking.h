@@ -0,0 +1,6 @@
+#ifndef EOS_BLOCKING_H__
+#define EOS_BLOCKING_H__
+
+void eos_blocking_init(void);
+
+#endif
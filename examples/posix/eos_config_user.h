@@ -0,0 +1,50 @@
+
+#ifndef EOS_CONFIG_USER_H__
+#define EOS_CONFIG_USER_H__
+
+// POSIX示例的配置，代替eventos_config.h中的默认配置，只打开各示例用到的功能。
+
+/* EventOS Nano General Configuration --------------------------------------- */
+#define EOS_MCU_TYPE                            32
+#define EOS_MAX_ACTORS                          4
+#define EOS_TEST_PLATFORM                       32
+#define EOS_TICK_MS                             1
+#define EOS_USE_MAGIC                           0
+
+/* Assert Configuration ----------------------------------------------------- */
+#define EOS_USE_ASSERT                          1
+
+/* State Machine Function Configuration ------------------------------------- */
+#define EOS_USE_SM_MODE                         1
+#define EOS_USE_HSM_MODE                        1
+#if (EOS_USE_SM_MODE != 0 && EOS_USE_HSM_MODE != 0)
+#define EOS_MAX_HSM_NEST_DEPTH                  4           // 最大嵌套层数（不含eos_state_top）
+#endif
+
+/* Publish & Subscribe Configuration ---------------------------------------- */
+#define EOS_USE_PUB_SUB                         1
+
+/* Time Event Configuration ------------------------------------------------- */
+#define EOS_USE_TIME_EVENT                      1
+#if (EOS_USE_TIME_EVENT != 0)
+    #define EOS_MAX_TIME_EVENT                  4           // 时间事件的数量
+    #define EOS_USE_DELAY                       1           // 延时与无栈协程式的Reactor
+    #define EOS_USE_TICKLESS                    1           // 空闲时休眠至下一个到期时刻
+    #define EOS_USE_HRTIMER                     1           // 高精度（微秒级）时间事件
+    #if (EOS_USE_HRTIMER != 0)
+    #define EOS_MAX_HRTIMER                     4           // 高精度时间事件的数量
+    #define EOS_HRTIMER_RES_US                  1           // 高精度计数器的分辨率（微秒）
+    #endif
+#endif
+
+/* Event's Data Configuration ----------------------------------------------- */
+#define EOS_USE_EVENT_DATA                      1
+#define EOS_SIZE_HEAP                           32767       // 设定堆大小
+
+/* Preemptive Kernel Configuration ------------------------------------------ */
+#define EOS_USE_PREEMPT                         1           // 中断退出时抢占低优先级的Actor
+
+/* Event Bridge Configuration ----------------------------------------------- */
+#define EOS_USE_EVENT_BRIDGE                    0
+
+#endif
@@ -0,0 +1,151 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_coroutine.h"
+
+/* assert ------------------------------------------------------------------- */
+#define CO_ASSERT(test_) do { if (!(test_)) {                                  \
+        eos_port_assert(__LINE__);                                             \
+    } } while (0)
+
+/* data --------------------------------------------------------------------- */
+enum {
+    CoState_Init = 0,                       // 尚未开始执行
+    CoState_Running,
+    CoState_Finished,
+};
+
+enum {
+    CoWorker_None = 0,                      // 工作线程尚未创建
+    CoWorker_Idle,
+    CoWorker_Busy,
+};
+
+// makecontext只能传递int参数，由调度器在切换之前记录即将开始执行的协程。
+static eos_coroutine_t *co_starting = EOS_NULL;
+
+/* static function ---------------------------------------------------------- */
+static void co_main(void)
+{
+    eos_coroutine_t *me = co_starting;
+    me->entry(me);
+    // 返回后经由uc_link回到调度器
+    me->state = CoState_Finished;
+}
+
+// 事件处理函数，切换到协程执行，直至协程再次等待。
+static void co_handler(eos_coroutine_t * const me, eos_event_t const * const e)
+{
+    if (me->state == CoState_Finished)
+        return;
+
+    if (me->state == CoState_Init) {
+        // 启动事件只用于开始执行，不交给入口函数。
+        me->state = CoState_Running;
+        co_starting = me;
+    }
+    me->event = e;
+    swapcontext(&me->caller, &me->context);
+}
+
+static void *co_worker(void *parameter)
+{
+    eos_coroutine_t *me = (eos_coroutine_t *)parameter;
+
+    pthread_mutex_lock(&me->mutex);
+    while (1) {
+        while (me->worker != CoWorker_Busy) {
+            pthread_cond_wait(&me->cond, &me->mutex);
+        }
+        pthread_mutex_unlock(&me->mutex);
+        void *ret = me->func(me->arg);
+        pthread_mutex_lock(&me->mutex);
+        me->ret = ret;
+        me->worker = CoWorker_Idle;
+        // 发布完成事件，跨线程发布由移植层的临界区保护。
+        eos_event_pub_topic(me->topic);
+    }
+
+    return EOS_NULL;
+}
+
+/* api ---------------------------------------------------------------------- */
+void eos_coroutine_init(eos_coroutine_t * const me, eos_u8_t priority, eos_topic_t topic,
+                        void *stack, eos_u32_t stack_size)
+{
+    CO_ASSERT(stack != EOS_NULL && stack_size >= EOS_COROUTINE_STACK_MIN);
+
+    eos_reactor_init(&me->super, priority, EOS_NULL);
+    me->topic = topic;
+    me->state = CoState_Init;
+    me->worker = CoWorker_None;
+    me->event = EOS_NULL;
+
+    getcontext(&me->context);
+    me->context.uc_stack.ss_sp = stack;
+    me->context.uc_stack.ss_size = stack_size;
+    me->context.uc_link = &me->caller;
+    makecontext(&me->context, co_main, 0);
+}
+
+void eos_coroutine_start(eos_coroutine_t * const me, eos_coroutine_entry entry)
+{
+    me->entry = entry;
+    eos_reactor_start(&me->super, EOS_HANDLER_CAST(co_handler));
+#if (EOS_USE_PUB_SUB != 0)
+    eos_event_sub(&me->super.super, me->topic);
+#endif
+    // 启动事件，入口函数在第一次调度时开始执行。
+    eos_event_pub_topic(me->topic);
+}
+
+eos_event_t const * eos_coroutine_wait(eos_coroutine_t * const me)
+{
+    swapcontext(&me->context, &me->caller);
+
+    return me->event;
+}
+
+eos_event_t const * eos_coroutine_wait_topic(eos_coroutine_t * const me, eos_topic_t topic)
+{
+    eos_event_t const *e;
+    do {
+        e = eos_coroutine_wait(me);
+    } while (e->topic != topic);
+
+    return e;
+}
+
+#if (EOS_USE_DELAY != 0)
+void eos_coroutine_delay(eos_coroutine_t * const me, eos_u32_t time_ms)
+{
+    // 协程在事件处理函数之内运行，延时属于该Actor，结束时收到Event_Null。
+    eos_delay(time_ms);
+    eos_coroutine_wait_topic(me, Event_Null);
+}
+#endif
+
+void * eos_coroutine_call(eos_coroutine_t * const me, eos_coroutine_func func, void *arg)
+{
+    if (me->worker == CoWorker_None) {
+        pthread_mutex_init(&me->mutex, EOS_NULL);
+        pthread_cond_init(&me->cond, EOS_NULL);
+        me->worker = CoWorker_Idle;
+        int ret = pthread_create(&me->thread, EOS_NULL, co_worker, me);
+        CO_ASSERT(ret == 0);
+        (void)ret;
+    }
+
+    pthread_mutex_lock(&me->mutex);
+    me->func = func;
+    me->arg = arg;
+    me->worker = CoWorker_Busy;
+    pthread_cond_signal(&me->cond);
+    pthread_mutex_unlock(&me->mutex);
+
+    eos_coroutine_wait_topic(me, me->topic);
+
+    pthread_mutex_lock(&me->mutex);
+    void *ret = me->ret;
+    pthread_mutex_unlock(&me->mutex);
+
+    return ret;
+}
@@ -0,0 +1,65 @@
+#ifndef EOS_COROUTINE_H__
+#define EOS_COROUTINE_H__
+
+#include "eventos.h"
+#include <ucontext.h>
+#include <pthread.h>
+
+// 有栈协程Actor（POSIX移植）------------------------------------------------------
+// 协程Actor在自己的栈上运行一个入口函数，可以在任意的调用深度上等待事件、延时，或者调用阻塞的
+// 第三方库（如套接字、LwIP的顺序API），等待时切换回调度器，其他Actor照常运行。阻塞函数在该协程
+// 专属的工作线程中执行，返回后以事件的形式恢复协程。协程Actor本身是一个Reactor，事件按优先级
+// 调度，与其他Actor相同；其入口函数中的代码总是在eos_run()所在的线程中执行。
+//
+// 内存开销（x86_64，glibc）：每个协程Actor约为sizeof(eos_coroutine_t)（两个ucontext_t，
+// 约2KB），加上调用者提供的栈，首次调用阻塞函数时再创建一个工作线程（默认栈8MB的虚拟内存，
+// 实际占用按页分配）。栈的大小取决于入口函数的调用深度，调用printf等库函数时建议不小于16KB。
+// 上下文切换使用swapcontext，每次切换包含一次信号掩码的系统调用，约为数百纳秒，协程Actor
+// 处理一个事件需切换两次，开销见benchmark。
+
+#define EOS_COROUTINE_STACK_MIN             16384
+
+typedef struct eos_coroutine eos_coroutine_t;
+typedef void (* eos_coroutine_entry)(eos_coroutine_t * const me);
+typedef void * (* eos_coroutine_func)(void *arg);
+
+struct eos_coroutine {
+    eos_reactor_t super;
+
+    ucontext_t context;                     // 协程的上下文
+    ucontext_t caller;                      // 调度器（事件处理函数）的上下文
+    eos_coroutine_entry entry;
+    eos_event_t const *event;               // 恢复协程的事件
+    eos_topic_t topic;                      // 协程专属的主题（启动与阻塞调用完成）
+    eos_u8_t state;
+
+    // 阻塞调用，在工作线程中执行
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    eos_coroutine_func func;
+    void *arg;
+    void *ret;
+    eos_u8_t worker;
+};
+
+// 初始化与启动。topic为该协程专属的主题，其他Actor不应订阅或发布。栈由调用者提供，不小于
+// EOS_COROUTINE_STACK_MIN字节。入口函数在第一次调度时开始执行，返回后协程结束，不再接收事件。
+void eos_coroutine_init(eos_coroutine_t * const me, eos_u8_t priority, eos_topic_t topic,
+                        void *stack, eos_u32_t stack_size);
+void eos_coroutine_start(eos_coroutine_t * const me, eos_coroutine_entry entry);
+
+// 以下函数只能在协程的入口函数中调用 ---------------------------------------------
+// 让出CPU，等待下一个事件。返回的事件只在下一次等待之前有效。
+eos_event_t const * eos_coroutine_wait(eos_coroutine_t * const me);
+// 等待主题，期间收到的其他事件被丢弃。协程需订阅该主题。
+eos_event_t const * eos_coroutine_wait_topic(eos_coroutine_t * const me, eos_topic_t topic);
+#if (EOS_USE_DELAY != 0)
+// 延时，期间收到的其他事件被丢弃。
+void eos_coroutine_delay(eos_coroutine_t * const me, eos_u32_t time_ms);
+#endif
+// 在工作线程中执行阻塞函数func(arg)，协程让出CPU直至其返回，返回值为func的返回值。期间收到
+// 的其他事件被丢弃。
+void * eos_coroutine_call(eos_coroutine_t * const me, eos_coroutine_func func, void *arg);
+
+#endif
@@ -0,0 +1,80 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_jitter.h"
+#include "eventos.h"
+#include "event_def.h"
+#include <stdio.h>
+
+// 测量高精度周期事件的抖动：每个事件被处理的时刻与其理论截止时刻之差即为延迟，
+// 每秒打印一次延迟的最小值、平均值、最大值，以及因延迟超过一个周期而被跳过的周期数。
+
+#if (EOS_USE_HRTIMER != 0)
+/* data structure ----------------------------------------------------------- */
+#define JITTER_PERIOD_US                    500
+#define JITTER_REPORT_COUNT                 (1000000 / JITTER_PERIOD_US)
+
+typedef struct eos_jitter_tag {
+    eos_reactor_t super;
+
+    eos_u32_t deadline;                     // 理论截止时刻（计数）
+    eos_u32_t count;
+    eos_u32_t skipped;
+    eos_u32_t late_min;
+    eos_u32_t late_max;
+    eos_u32_t late_sum;
+} eos_jitter_t;
+
+static eos_jitter_t jitter;
+
+/* static function ---------------------------------------------------------- */
+static void jitter_reset(eos_jitter_t * const me)
+{
+    me->count = 0;
+    me->skipped = 0;
+    me->late_min = EOS_U32_MAX;
+    me->late_max = 0;
+    me->late_sum = 0;
+}
+
+static void jitter_handler(eos_jitter_t * const me, eos_event_t const * const e)
+{
+    (void)e;
+    eos_u32_t period = JITTER_PERIOD_US / EOS_HRTIMER_RES_US;
+    eos_u32_t late = eos_port_hrtime() - me->deadline;
+    // 错过的周期被框架跳过，此事件对应最近的一个截止时刻。
+    while (late >= period) {
+        late -= period;
+        me->deadline += period;
+        me->skipped ++;
+    }
+    me->deadline += period;
+    eos_u32_t late_us = late * EOS_HRTIMER_RES_US;
+
+    me->late_min = (late_us < me->late_min) ? late_us : me->late_min;
+    me->late_max = (late_us > me->late_max) ? late_us : me->late_max;
+    me->late_sum += late_us;
+    me->count ++;
+    if (me->count < JITTER_REPORT_COUNT)
+        return;
+
+    printf("Jitter(%dus period): min %uus, avg %uus, max %uus, skipped %u.\n",
+           JITTER_PERIOD_US, me->late_min, me->late_sum / me->count, me->late_max,
+           me->skipped);
+    jitter_reset(me);
+}
+#endif
+
+/* api ---------------------------------------------------------------------- */
+void eos_jitter_init(void)
+{
+#if (EOS_USE_HRTIMER != 0)
+    eos_reactor_init(&jitter.super, 2, EOS_NULL);
+    eos_reactor_start(&jitter.super, EOS_HANDLER_CAST(jitter_handler));
+#if (EOS_USE_PUB_SUB != 0)
+    eos_event_sub(&jitter.super.super, Event_Time_Jitter);
+#endif
+
+    jitter_reset(&jitter);
+    jitter.deadline = eos_port_hrtime() + (JITTER_PERIOD_US / EOS_HRTIMER_RES_US);
+    eos_event_pub_period_us(Event_Time_Jitter, JITTER_PERIOD_US);
+#endif
+}
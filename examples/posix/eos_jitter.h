@@ -0,0 +1,6 @@
+#ifndef EOS_JITTER_H__
+#define EOS_JITTER_H__
+
+void eos_jitter_init(void);
+
+#endif
@@ -0,0 +1,113 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_preempt.h"
+#include "eventos.h"
+#include "event_def.h"
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <stdio.h>
+
+// 抢占式内核的响应延迟：低优先级的Reactor每秒忙等PREEMPT_BUSY_MS毫秒，模拟的定时器中断每
+// PREEMPT_IRQ_MS毫秒发布一个带时间戳的事件，由高优先级的Reactor计算从中断到处理的延迟。
+// 不抢占时，最大延迟接近忙等的时长；抢占时只有微秒级。每秒打印一次延迟的平均值与最大值。
+
+#if (EOS_USE_PREEMPT != 0 && EOS_USE_TIME_EVENT != 0)
+/* data structure ----------------------------------------------------------- */
+#define PREEMPT_BUSY_MS                     50
+#define PREEMPT_IRQ_MS                      10
+#define PREEMPT_REPORT_COUNT                (1000 / PREEMPT_IRQ_MS)
+
+typedef struct eos_preempt_tag {
+    eos_reactor_t super;
+
+    eos_u32_t count;
+    eos_u32_t latency_max;
+    eos_u32_t latency_sum;
+} eos_preempt_t;
+
+static eos_reactor_t busy;
+static eos_preempt_t preempt;
+static pthread_t preempt_cpu;
+static pthread_t preempt_timer;
+
+/* static function ---------------------------------------------------------- */
+static eos_u32_t preempt_time_us(void)
+{
+    struct timespec time_crt;
+    clock_gettime(CLOCK_MONOTONIC, &time_crt);
+
+    return (eos_u32_t)(time_crt.tv_sec * 1000000 + time_crt.tv_nsec / 1000);
+}
+
+// 模拟定时器外设，周期性地向事件循环的线程发出中断信号。
+static void *preempt_timer_thread(void *arg)
+{
+    (void)arg;
+    struct timespec time_next;
+    clock_gettime(CLOCK_MONOTONIC, &time_next);
+
+    while (1) {
+        time_next.tv_nsec += PREEMPT_IRQ_MS * 1000000;
+        if (time_next.tv_nsec >= 1000000000) {
+            time_next.tv_sec += 1;
+            time_next.tv_nsec -= 1000000000;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &time_next, EOS_NULL);
+        pthread_kill(preempt_cpu, SIGALRM);
+    }
+
+    return EOS_NULL;
+}
+
+static void preempt_isr(void)
+{
+    eos_u32_t stamp = preempt_time_us();
+    eos_event_pub(Event_Preempt, &stamp, sizeof(stamp));
+}
+
+static void busy_handler(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    (void)e;
+    eos_u32_t start = preempt_time_us();
+    while ((preempt_time_us() - start) < (PREEMPT_BUSY_MS * 1000)) {
+    }
+}
+
+static void preempt_handler(eos_preempt_t * const me, eos_event_t const * const e)
+{
+    eos_u32_t latency = preempt_time_us() - *(eos_u32_t *)e->data;
+
+    me->latency_max = (latency > me->latency_max) ? latency : me->latency_max;
+    me->latency_sum += latency;
+    me->count ++;
+    if (me->count < PREEMPT_REPORT_COUNT)
+        return;
+
+    printf("Preempt(%dms busy handler): avg %uus, max %uus.\n",
+           PREEMPT_BUSY_MS, me->latency_sum / me->count, me->latency_max);
+    me->count = 0;
+    me->latency_max = 0;
+    me->latency_sum = 0;
+}
+#endif
+
+/* api ---------------------------------------------------------------------- */
+void eos_preempt_init(void)
+{
+#if (EOS_USE_PREEMPT != 0 && EOS_USE_TIME_EVENT != 0)
+    eos_reactor_init(&busy, 0, EOS_NULL);
+    eos_reactor_start(&busy, busy_handler);
+    eos_reactor_init(&preempt.super, 1, EOS_NULL);
+    eos_reactor_start(&preempt.super, EOS_HANDLER_CAST(preempt_handler));
+#if (EOS_USE_PUB_SUB != 0)
+    eos_event_sub(&busy.super, Event_Preempt_Busy);
+    eos_event_sub(&preempt.super.super, Event_Preempt);
+#endif
+    eos_event_pub_period(Event_Preempt_Busy, 1000);
+
+    eos_port_irq(SIGALRM, preempt_isr);
+    preempt_cpu = pthread_self();
+    pthread_create(&preempt_timer, EOS_NULL, preempt_timer_thread, EOS_NULL);
+#endif
+}
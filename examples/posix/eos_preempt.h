@@ -0,0 +1,9 @@
+#ifndef EOS_PREEMPT_H__
+#define EOS_PREEMPT_H__
+
+// 移植层以信号sig模拟中断，isr在eos_isr_enter与eos_isr_exit之间执行。在事件循环的线程中调用。
+void eos_port_irq(int sig, void (*isr)(void));
+
+void eos_preempt_init(void);
+
+#endif
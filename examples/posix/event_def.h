@@ -7,6 +7,10 @@
 enum {
     Event_Test = Event_User,
     Event_Time_500ms,
+    Event_Time_Jitter,
+    Event_Coroutine,
+    Event_Preempt,
+    Event_Preempt_Busy,
 
     Event_Max
 };
@@ -2,6 +2,9 @@
 #include "eventos.h"                                // EventOS Nano头文件
 #include "event_def.h"                              // 事件主题的枚举
 #include "eos_led.h"                                // LED灯闪烁状态机
+#include "eos_jitter.h"                             // 高精度时间事件的抖动测量
+#include "eos_blocking.h"                           // 协程Actor中的阻塞调用
+#include "eos_preempt.h"                            // 抢占式内核的响应延迟
 
 /* define ------------------------------------------------------------------- */
 #if (EOS_USE_PUB_SUB != 0)
@@ -16,9 +19,13 @@ int main(void)
     eos_sub_init(eos_sub_table, Event_Max);         // 订阅表初始化
 #endif
 
-#if (EOS_USE_SM_MODE)
+#if (EOS_USE_PREEMPT != 0)
+    eos_preempt_init();                             // 抢占演示初始化（占用LED的优先级）
+#elif (EOS_USE_SM_MODE)
     eos_led_init();                                 // LED状态机初始化
 #endif
+    eos_jitter_init();                              // 抖动测量初始化
+    eos_blocking_init();                            // 协程Actor初始化
 
     eos_run();                                      // EventOS启动
 
@@ -1,27 +1,112 @@
 #include "eventos.h"
-#include <sys/time.h>
+#include <pthread.h>
+#include <time.h>
 #include <unistd.h>
 #include <stdlib.h>
 #include <stdio.h>
+#if (EOS_USE_HRTIMER != 0) && defined(__linux__)
+#include <sys/prctl.h>
+#endif
+#if (EOS_USE_PREEMPT != 0)
+#include <signal.h>
+#endif
+
+// 临界区使用递归互斥锁，允许在其他线程中发布事件，断言时也可以重复进入。
+static pthread_once_t critical_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t mutex_critical;
+
+#if (EOS_USE_PREEMPT != 0)
+// 以信号模拟中断。信号总是交给调用eos_port_irq的线程（事件循环的线程）处理，临界区内屏蔽这些
+// 信号，如同关中断。信号处理函数在被中断的线程的栈上执行，与中断相同。
+static void (*irq_isr[NSIG])(void);
+static sigset_t irq_mask;
+static pthread_t irq_thread;
+static volatile sig_atomic_t irq_nest = 0;
+static __thread eos_u32_t critical_nest = 0;
+static __thread sigset_t critical_mask;
+
+static void eos_port_irq_handler(int sig)
+{
+    if (pthread_equal(pthread_self(), irq_thread) == 0) {
+        pthread_kill(irq_thread, sig);
+        return;
+    }
+
+    irq_nest ++;
+    eos_isr_enter();
+    irq_isr[sig]();
+    eos_isr_exit();
+    irq_nest --;
+}
+
+void eos_port_irq(int sig, void (*isr)(void))
+{
+    struct sigaction action;
+
+    irq_thread = pthread_self();
+    irq_isr[sig] = isr;
+    sigaddset(&irq_mask, sig);
+
+    // SA_NODEFER：处理期间允许其他中断嵌套
+    action.sa_handler = eos_port_irq_handler;
+    action.sa_flags = SA_RESTART | SA_NODEFER;
+    sigemptyset(&action.sa_mask);
+    sigaction(sig, &action, EOS_NULL);
+}
+#endif
+
+static void eos_port_critical_init(void)
+{
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&mutex_critical, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
 
 static eos_u32_t eos_get_time(void)
 {
-    struct timeval time_crt;
-    gettimeofday(&time_crt, (void *)0);
-    eos_u32_t time_crt_ms = time_crt.tv_sec * 1000 + time_crt.tv_usec / 1000;
+    struct timespec time_crt;
+    clock_gettime(CLOCK_MONOTONIC, &time_crt);
+    eos_u32_t time_crt_ms = time_crt.tv_sec * 1000 + time_crt.tv_nsec / 1000000;
 
     return time_crt_ms;
 }
 
+#if (EOS_USE_HRTIMER != 0)
+eos_u32_t eos_port_hrtime(void)
+{
+    struct timespec time_crt;
+    clock_gettime(CLOCK_MONOTONIC, &time_crt);
+    unsigned long long time_us = (unsigned long long)time_crt.tv_sec * 1000000 +
+                                 time_crt.tv_nsec / 1000;
+
+    return (eos_u32_t)(time_us / EOS_HRTIMER_RES_US);
+}
+#endif
+
 void eos_port_critical_enter(void)
 {
-    // NULL
+#if (EOS_USE_PREEMPT != 0)
+    sigset_t mask;
+    pthread_sigmask(SIG_BLOCK, &irq_mask, &mask);
+    if (critical_nest ++ == 0) {
+        critical_mask = mask;
+    }
+#endif
+    pthread_once(&critical_once, eos_port_critical_init);
+    pthread_mutex_lock(&mutex_critical);
 }
 
 
 void eos_port_critical_exit(void)
 {
-    // NULL
+    pthread_mutex_unlock(&mutex_critical);
+#if (EOS_USE_PREEMPT != 0)
+    if (-- critical_nest == 0) {
+        pthread_sigmask(SIG_SETMASK, &critical_mask, EOS_NULL);
+    }
+#endif
 }
 
 void eos_port_assert(eos_u32_t error_id)
@@ -35,33 +120,117 @@ void eos_port_assert(eos_u32_t error_id)
     }
 }
 
+#if (EOS_USE_TIME_EVENT != 0)
 static eos_u32_t eos_time_bkp = 0;
-void eos_hook_idle(void)
+static eos_bool_t eos_time_started = EOS_False;
+
+// 将流逝的时间同步到框架中
+static void eos_port_time_update(void)
 {
-#if (EOS_USE_TIME_EVENT != 0)
-    if (eos_time_bkp == 0) {
-        eos_time_bkp = eos_get_time();
-        usleep(1000);
+    eos_u32_t system_time = eos_get_time();
+    if (eos_time_started == EOS_False) {
+        eos_time_started = EOS_True;
+        eos_time_bkp = system_time;
         return;
     }
 
-    eos_u32_t system_time = eos_get_time();
+    // 无符号减法，毫秒计数溢出时仍然正确。
+    eos_tick_advance(system_time - eos_time_bkp);
+    eos_time_bkp = system_time;
+}
+#endif
+
+#if (EOS_USE_TICKLESS != 0)
+// 空闲时在条件变量上休眠，直至下一个到期时刻，或者有事件发布。
+static pthread_once_t wakeup_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t mutex_wakeup = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond_wakeup;
+static eos_bool_t wakeup = EOS_False;
+
+static void eos_port_wakeup_init(void)
+{
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&cond_wakeup, &attr);
+    pthread_condattr_destroy(&attr);
+}
 
-    if (system_time >= eos_time_bkp) {
-        for (eos_u32_t i = 0; i < (system_time - eos_time_bkp); i ++) {
-            eos_tick();
+static void eos_port_sleep(eos_u32_t time_us)
+{
+    pthread_once(&wakeup_once, eos_port_wakeup_init);
+    pthread_mutex_lock(&mutex_wakeup);
+    // 计算休眠时长之后发布的事件，也不会被错过。
+    if (wakeup == EOS_False) {
+        if (time_us == EOS_U32_MAX) {
+            pthread_cond_wait(&cond_wakeup, &mutex_wakeup);
+        }
+        else {
+            struct timespec time_wakeup;
+            clock_gettime(CLOCK_MONOTONIC, &time_wakeup);
+            time_wakeup.tv_sec += time_us / 1000000;
+            time_wakeup.tv_nsec += (time_us % 1000000) * 1000;
+            if (time_wakeup.tv_nsec >= 1000000000) {
+                time_wakeup.tv_sec += 1;
+                time_wakeup.tv_nsec -= 1000000000;
+            }
+            pthread_cond_timedwait(&cond_wakeup, &mutex_wakeup, &time_wakeup);
         }
-        eos_time_bkp = system_time;
     }
-    // TODO 此处需要处理时间溢出情况。
+    wakeup = EOS_False;
+    pthread_mutex_unlock(&mutex_wakeup);
+}
+
+void eos_hook_wakeup(void)
+{
+#if (EOS_USE_PREEMPT != 0)
+    // 中断中发布的事件在中断退出时已被处理，被中断的线程也可能正持有mutex_wakeup。
+    if (irq_nest != 0)
+        return;
+#endif
+    pthread_once(&wakeup_once, eos_port_wakeup_init);
+    pthread_mutex_lock(&mutex_wakeup);
+    wakeup = EOS_True;
+    pthread_cond_signal(&cond_wakeup);
+    pthread_mutex_unlock(&mutex_wakeup);
+}
+#endif
+
+void eos_hook_idle(void)
+{
+#if (EOS_USE_TICKLESS != 0)
+    eos_port_time_update();
+    // 休眠时长（微秒），取毫秒级与高精度时间事件中较早的截止时刻。
+    eos_u32_t time_ms = eos_time_deadline();
+    eos_u32_t time_us = EOS_U32_MAX;
+    if (time_ms != EOS_U32_MAX) {
+        time_us = (time_ms >= (EOS_U32_MAX / 1000)) ? (EOS_U32_MAX - 1) : (time_ms * 1000);
+    }
+#if (EOS_USE_HRTIMER != 0)
+    eos_u32_t time_hr_us = eos_time_deadline_us();
+    if (time_us > time_hr_us) {
+        time_us = time_hr_us;
+    }
+#endif
+    if (time_us != 0) {
+        eos_port_sleep(time_us);
+        eos_port_time_update();
+    }
+#else
+#if (EOS_USE_TIME_EVENT != 0)
+    eos_port_time_update();
 #endif
 
     usleep(1000);
+#endif
 }
 
 void eos_hook_start(void)
 {
-
+#if (EOS_USE_HRTIMER != 0) && defined(__linux__)
+    // Linux默认的定时器松弛量为50us，会直接叠加到高精度时间事件的延迟上。
+    prctl(PR_SET_TIMERSLACK, 1UL);
+#endif
 }
 
 void eos_hook_stop(void)
@@ -1,3 +1,4 @@
+#include "stm32f0xx.h"
 #include "eventos.h"
 #include "rtt/SEGGER_RTT.h"
 
@@ -12,6 +13,21 @@ void eos_port_critical_exit(void)
     __enable_irq();
 }
 
+#if (EOS_USE_HRTIMER != 0)
+// 以1ms的SysTick为基准的微秒计数器，SysTick的重装载值为(SystemCoreClock / 1000 - 1)。
+eos_u32_t eos_port_hrtime(void)
+{
+    eos_u32_t time_ms, count;
+    do {
+        time_ms = (eos_u32_t)eos_time();
+        count = SysTick->VAL;
+    } while (time_ms != (eos_u32_t)eos_time());
+    eos_u32_t time_us = (SysTick->LOAD - count) / (SystemCoreClock / 1000000);
+
+    return (time_ms * (1000 / EOS_HRTIMER_RES_US) + time_us / EOS_HRTIMER_RES_US);
+}
+#endif
+
 eos_u32_t eos_error_id = 0;
 void eos_port_assert(eos_u32_t error_id)
 {
@@ -38,3 +54,10 @@ void eos_hook_stop(void)
 {
 
 }
+
+#if (EOS_USE_TICKLESS != 0)
+void eos_hook_wakeup(void)
+{
+
+}
+#endif
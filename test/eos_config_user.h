@@ -0,0 +1,99 @@
+
+#ifndef EOS_CONFIG_USER_H__
+#define EOS_CONFIG_USER_H__
+
+// 单元测试的配置，打开全部的功能，代替eventos_config.h中的默认配置。
+
+/* EventOS Nano General Configuration --------------------------------------- */
+#define EOS_MCU_TYPE                            32
+#define EOS_MAX_ACTORS                          4
+#define EOS_TEST_PLATFORM                       32
+#define EOS_TICK_MS                             1
+#define EOS_USE_MAGIC                           0
+
+/* Assert Configuration ----------------------------------------------------- */
+#define EOS_USE_ASSERT                          1
+
+/* State Machine Function Configuration ------------------------------------- */
+#define EOS_USE_SM_MODE                         1
+#define EOS_USE_HSM_MODE                        1
+#if (EOS_USE_SM_MODE != 0 && EOS_USE_HSM_MODE != 0)
+#define EOS_MAX_HSM_NEST_DEPTH                  8           // 最大嵌套层数（不含eos_state_top）
+#define EOS_USE_HSM_CACHE                       1           // 缓存父状态与转移路径
+#if (EOS_USE_HSM_CACHE != 0)
+    #define EOS_HSM_CACHE_STATE                 32          // 父状态缓存的数量
+    #define EOS_HSM_CACHE_TRAN                  16          // 转移路径缓存的数量
+#endif
+#define EOS_USE_SM_DESC                         1           // 描述符表驱动的层次状态机
+#endif
+#define EOS_USE_SM_TABLE                        1           // 转移表驱动的平面状态机
+#define EOS_USE_SM_REGION                       1           // 状态机的正交区域
+
+/* Reactor Function Configuration ------------------------------------------- */
+#define EOS_USE_REACTOR_TABLE                   1           // Reactor按主题查表分发事件
+
+/* Publish & Subscribe Configuration ---------------------------------------- */
+#define EOS_USE_PUB_SUB                         1
+#if (EOS_USE_PUB_SUB != 0)
+    #define EOS_USE_STATE_SUB                   1           // 状态机按当前状态自动订阅主题
+#endif
+
+/* Time Event Configuration ------------------------------------------------- */
+#define EOS_USE_TIME_EVENT                      1
+#if (EOS_USE_TIME_EVENT != 0)
+    #define EOS_USE_TIMER_WHEEL                 1           // 使用分层时间轮管理时间事件
+    #define EOS_MAX_TIME_EVENT                  512         // 时间事件的数量
+    #define EOS_USE_TIME_64BIT                  1           // 64位的系统时间，不再处理30天回绕
+    #define EOS_USE_TIMER_HANDLE                1           // 按句柄取消与重新计时，同一主题可有多个
+    #define EOS_USE_TIMER_PAYLOAD               1           // 携带数据、可定向发送的时间事件
+    #define EOS_USE_TIMER_EXACT                 1           // 精确周期、追赶策略与迟到统计
+    #define EOS_USE_TIMER_SLACK                 1           // 定时器松弛（合并唤醒）与相位错开
+    #define EOS_USE_DELAY                       1           // 延时与无栈协程式的Reactor
+    #define EOS_USE_TICKLESS                    1           // 空闲时休眠至下一个到期时刻
+    #define EOS_USE_HRTIMER                     1           // 高精度（微秒级）时间事件
+    #if (EOS_USE_HRTIMER != 0)
+    #define EOS_MAX_HRTIMER                     4           // 高精度时间事件的数量
+    #define EOS_HRTIMER_RES_US                  1           // 高精度计数器的分辨率（微秒）
+    #endif
+#endif
+
+/* Event's Data Configuration ----------------------------------------------- */
+#define EOS_USE_EVENT_DATA                      1
+#define EOS_SIZE_HEAP                           32767       // 设定堆大小
+
+/* Request & Response Configuration ----------------------------------------- */
+#define EOS_USE_REQUEST                         1
+#if (EOS_USE_REQUEST != 0)
+    // 同时等待回复的请求数量，1 ~ 255。关联ID的低8位为槽位，高7位为序号，故不超过255。
+    #define EOS_MAX_REQUEST                     16
+#endif
+
+/* Topic Filter Configuration ----------------------------------------------- */
+#define EOS_USE_TOPIC_FILTER                    1
+#if (EOS_USE_TOPIC_FILTER != 0)
+    #define EOS_MAX_TOPIC_FILTER                8           // 防抖与节流的主题数量
+    #define EOS_TOPIC_FILTER_DATA               8           // 暂存的事件数据的最大长度（字节）
+#endif
+
+/* Event Block Configuration ------------------------------------------------ */
+#define EOS_USE_EVENT_BLOCK                     1
+#if (EOS_USE_EVENT_BLOCK != 0)
+    #define EOS_MAX_UNBLOCKED                   8           // 不可阻塞事件的主题数量
+#endif
+
+/* Event Batch Configuration ------------------------------------------------ */
+#define EOS_USE_EVENT_BATCH                     1
+#if (EOS_USE_EVENT_BATCH != 0)
+    #define EOS_MAX_EVENT_BATCH                 8           // 一次交给批处理函数的最大事件数
+#endif
+
+/* Preemptive Kernel Configuration ------------------------------------------ */
+#define EOS_USE_PREEMPT                         1           // 中断退出时抢占低优先级的Actor
+
+/* EDF Scheduling Configuration --------------------------------------------- */
+#define EOS_USE_EDF                             1           // 按事件的截止时间（最早截止优先）调度
+
+/* Event Bridge Configuration ----------------------------------------------- */
+#define EOS_USE_EVENT_BRIDGE                    0
+
+#endif
@@ -5,24 +5,40 @@
 
 void set_time_ms(eos_u32_t time_ms)
 {
-#if (EOS_USE_TIME_EVENT != 0)
+#if (EOS_USE_TIME_EVENT != 0) && (EOS_USE_TIME_64BIT != 0)
+    // 64位时间不会回绕，只能向前推进。
+    eos_time_t time_ms_count = eos_time();
+    if (time_ms > time_ms_count) {
+        eos_tick_advance((eos_u32_t)(time_ms - time_ms_count));
+    }
+#elif (EOS_USE_TIME_EVENT != 0)
     #define EOS_MS_NUM_30DAY                    (2592000000)
     eos_u32_t time_ms_count = eos_time();
 
     if (time_ms >= time_ms_count) {
-        for (eos_u32_t i = 0; i < (time_ms - time_ms_count); i ++)
-            eos_tick();
+        eos_tick_advance(time_ms - time_ms_count);
     }
     else {
-        eos_u32_t count = (EOS_MS_NUM_30DAY + time_ms - time_ms_count);
-        for (eos_u32_t i = 0; i < count; i ++)
-            eos_tick();
+        eos_tick_advance(EOS_MS_NUM_30DAY + time_ms - time_ms_count);
     }
-
-    time_ms_count = time_ms;
 #endif
 }
 
+#if (EOS_USE_HRTIMER != 0)
+// 虚拟的高精度计数器，由测试代码设置
+static eos_u32_t time_hr = 0;
+
+void set_time_hr(eos_u32_t count)
+{
+    time_hr = count;
+}
+
+eos_u32_t eos_port_hrtime(void)
+{
+    return time_hr;
+}
+#endif
+
 void eos_port_critical_enter(void)
 {
     // NULL
@@ -48,6 +64,13 @@ void eos_hook_stop(void)
 
 }
 
+#if (EOS_USE_TICKLESS != 0)
+void eos_hook_wakeup(void)
+{
+
+}
+#endif
+
 void eos_port_assert(eos_u32_t error_id)
 {
     printf("------------------------------------\n");
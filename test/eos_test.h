@@ -37,14 +37,30 @@ int reactor_e_tr_count(reactor_t * const me);
 
 /* tool --------------------------------------------------------------------- */
 void set_time_ms(eos_u32_t time_ms);
+void set_time_hr(eos_u32_t count);
 
 /* test function ------------------------------------------------------------ */
 void eos_test_etimer(void);
+void eos_test_wheel(void);
+void eos_test_hrtimer(void);
+void eos_test_timer(void);
 void eos_test_event(void);
 void eos_test_heap(void);
 void eos_test_fsm(void);
 void eos_test_hsm(void);
+void eos_test_dsm(void);
+void eos_test_tsm(void);
+void eos_test_region(void);
+void eos_test_state_sub(void);
 void eos_test_reactor(void);
+void eos_test_reactor_table(void);
 void eos_test_sub(void);
+void eos_test_request(void);
+void eos_test_filter(void);
+void eos_test_delay(void);
+void eos_test_block(void);
+void eos_test_batch(void);
+void eos_test_preempt(void);
+void eos_test_edf(void);
 
 #endif
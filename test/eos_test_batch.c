@@ -0,0 +1,110 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_test.h"
+#include "eos_test_def.h"
+#include "event_def.h"
+#include "unity.h"
+#include "unity_pack.h"
+
+#if (EOS_USE_EVENT_BATCH != 0)
+/* data --------------------------------------------------------------------- */
+// 每次批处理记下事件的数量，以及各事件的主题与数据（一个字节）。
+static eos_u32_t batch_calls;
+static eos_u32_t batch_count;
+static eos_topic_t batch_topic[EOS_MAX_EVENT_BATCH];
+static eos_u8_t batch_data[EOS_MAX_EVENT_BATCH];
+static eos_u32_t single_count;
+
+static void batch_handler(eos_reactor_t * const me, eos_event_t const * const e, eos_u32_t count)
+{
+    (void)me;
+    batch_calls ++;
+    batch_count = count;
+    for (eos_u32_t i = 0; i < count; i ++) {
+        batch_topic[i] = e[i].topic;
+        batch_data[i] = (e[i].size == 0) ? 0 : *(eos_u8_t *)e[i].data;
+    }
+}
+
+static void single_handler(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    (void)e;
+    single_count ++;
+}
+
+/* unit test ---------------------------------------------------------------- */
+static eos_mcu_t sub_table[Event_Max];
+static eos_reactor_t batch, single;
+static eos_t *f;
+
+// 调度一次，检查批处理函数收到的事件数量
+static void batch_once(eos_u32_t count)
+{
+    batch_calls = 0;
+    batch_count = 0;
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_UINT32(1, batch_calls);
+    TEST_ASSERT_EQUAL_UINT32(count, batch_count);
+}
+#endif
+
+void eos_test_batch(void)
+{
+#if (EOS_USE_EVENT_BATCH != 0)
+    f = eos_get_framework();
+    eos_set_time(0);
+    eos_init();
+    eos_sub_init(sub_table, Event_Max);
+    eos_reactor_init(&batch, 1, EOS_NULL);
+    eos_reactor_start_batch(&batch, batch_handler);
+    eos_reactor_init(&single, 0, EOS_NULL);
+    eos_reactor_start(&single, single_handler);
+    eos_event_sub(&batch.super, Event_Test);
+    eos_event_sub(&batch.super, Event_TestFsm);
+    eos_event_sub(&single.super, Event_Test);
+
+    // 一次送达所有待处理的事件，保持发布的顺序与数据 -----------------------------
+    single_count = 0;
+    for (eos_u8_t i = 0; i < 3; i ++) {
+        eos_event_pub(Event_Test, &i, 1);
+    }
+    eos_event_pub_topic(Event_TestFsm);
+    batch_once(4);
+    TEST_ASSERT_EQUAL_UINT32(Event_Test, batch_topic[0]);
+    TEST_ASSERT_EQUAL_UINT8(0, batch_data[0]);
+    TEST_ASSERT_EQUAL_UINT8(1, batch_data[1]);
+    TEST_ASSERT_EQUAL_UINT8(2, batch_data[2]);
+    TEST_ASSERT_EQUAL_UINT32(Event_TestFsm, batch_topic[3]);
+    TEST_ASSERT_EQUAL_UINT32(0, single_count);
+    // 其他Actor订阅的事件仍保留，逐个送达
+    for (eos_u32_t i = 0; i < 3; i ++) {
+        TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    }
+    TEST_ASSERT_EQUAL_UINT32(3, single_count);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    TEST_ASSERT_EQUAL_UINT8(1, f->heap.empty);
+    TEST_ASSERT_EQUAL_UINT32(0, f->heap.sub_general);
+
+    // 超出EOS_MAX_EVENT_BATCH的事件，下一次调度时送达 -----------------------------
+    for (eos_u8_t i = 0; i < EOS_MAX_EVENT_BATCH + 3; i ++) {
+        eos_event_pub(Event_TestFsm, &i, 1);
+    }
+    batch_once(EOS_MAX_EVENT_BATCH);
+    TEST_ASSERT_EQUAL_UINT8(EOS_MAX_EVENT_BATCH - 1, batch_data[EOS_MAX_EVENT_BATCH - 1]);
+    batch_once(3);
+    TEST_ASSERT_EQUAL_UINT8(EOS_MAX_EVENT_BATCH, batch_data[0]);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    TEST_ASSERT_EQUAL_UINT8(1, f->heap.empty);
+
+    // 进入队列之后取消订阅的事件，不再送达 ---------------------------------------
+    eos_event_pub_topic(Event_TestFsm);
+    eos_event_pub_topic(Event_TestFsm);
+    eos_event_unsub(&batch.super, Event_TestFsm);
+    eos_event_unsub(&single.super, Event_Test);
+    eos_event_pub_topic(Event_Test);
+    batch_once(1);
+    TEST_ASSERT_EQUAL_UINT32(Event_Test, batch_topic[0]);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    TEST_ASSERT_EQUAL_UINT8(1, f->heap.empty);
+#endif
+}
@@ -0,0 +1,161 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_test.h"
+#include "eos_test_def.h"
+#include "event_def.h"
+#include "unity.h"
+#include "unity_pack.h"
+
+#if (EOS_USE_EVENT_BLOCK != 0)
+/* data --------------------------------------------------------------------- */
+#define BLOCK_LOG_SIZE                      16
+
+typedef struct block_reactor {
+    eos_reactor_t super;
+    eos_topic_t log[BLOCK_LOG_SIZE];
+    eos_u32_t count;
+} block_reactor_t;
+
+/* actors for test ---------------------------------------------------------- */
+// 记录收到的事件的主题与顺序
+static void block_func(block_reactor_t * const me, eos_event_t const * const e)
+{
+    if (me->count < BLOCK_LOG_SIZE) {
+        me->log[me->count] = e->topic;
+    }
+    me->count ++;
+}
+
+#if (EOS_USE_DELAY != 0)
+// 延时期间屏蔽事件，延时结束后等待Event_Timeout
+static void block_pt_func(block_reactor_t * const me, eos_event_t const * const e)
+{
+    block_func(me, e);
+
+    EOS_PT_BEGIN();
+    EOS_PT_DELAY_UNSUB(100);
+    EOS_PT_WAIT_TOPIC(Event_Timeout);
+    EOS_PT_END();
+}
+#endif
+
+/* unit test ---------------------------------------------------------------- */
+#if (EOS_USE_PUB_SUB != 0)
+static eos_mcu_t sub_table[Event_Max];
+#endif
+static block_reactor_t busy, other;
+static eos_t *f;
+
+static void block_run(void)
+{
+    while (eos_once() == EosRun_OK) {
+    }
+}
+
+static void block_reset(block_reactor_t * const me)
+{
+    me->count = 0;
+    for (eos_u32_t i = 0; i < BLOCK_LOG_SIZE; i ++) {
+        me->log[i] = Event_Null;
+    }
+}
+#endif
+
+void eos_test_block(void)
+{
+#if (EOS_USE_EVENT_BLOCK != 0)
+    f = eos_get_framework();
+    eos_set_time(0);
+
+    eos_init();
+#if (EOS_USE_PUB_SUB != 0)
+    eos_sub_init(sub_table, Event_Max);
+#endif
+    block_reset(&busy);
+    block_reset(&other);
+    eos_reactor_init(&busy.super, 1, EOS_NULL);
+    eos_reactor_start(&busy.super, EOS_HANDLER_CAST(block_func));
+    eos_reactor_init(&other.super, 0, EOS_NULL);
+    eos_reactor_start(&other.super, EOS_HANDLER_CAST(block_func));
+#if (EOS_USE_PUB_SUB != 0)
+    eos_event_sub(&busy.super.super, Event_Test);
+    eos_event_sub(&busy.super.super, Event_TestFsm);
+    eos_event_sub(&busy.super.super, Event_Timeout);
+    eos_event_sub(&other.super.super, Event_Test);
+    eos_event_sub(&other.super.super, Event_Timeout);
+#endif
+    eos_event_set_unblocked(Event_Timeout);
+    eos_event_set_unblocked(Event_Timeout);
+    TEST_ASSERT_EQUAL_UINT8(1, f->unblocked_count);
+
+    // 屏蔽期间只送达不可阻塞事件，其余事件保留，其他Actor不受影响 --------------
+    eos_actor_block(&busy.super.super);
+    TEST_ASSERT_EQUAL_UINT32(2, f->heap.sub_blocked);
+    eos_event_pub_topic(Event_Test);
+    eos_event_pub_topic(Event_TestFsm);
+    eos_event_pub_topic(Event_Timeout);
+    eos_event_pub_topic(Event_Test);
+    TEST_ASSERT_EQUAL_UINT32(3, f->heap.sub_urgent);
+    block_run();
+    TEST_ASSERT_EQUAL_UINT32(1, busy.count);
+    TEST_ASSERT_EQUAL_UINT16(Event_Timeout, busy.log[0]);
+    TEST_ASSERT_EQUAL_UINT32(3, other.count);
+    TEST_ASSERT_EQUAL_UINT16(Event_Test, other.log[0]);
+    TEST_ASSERT_EQUAL_UINT16(Event_Timeout, other.log[1]);
+    TEST_ASSERT_EQUAL_UINT16(Event_Test, other.log[2]);
+
+    // 只剩被保留的事件时，按空闲处理，不会丢失 --------------------------------
+    TEST_ASSERT_EQUAL_UINT32(2, f->heap.sub_general);
+    TEST_ASSERT_EQUAL_UINT32(0, f->heap.sub_urgent);
+    TEST_ASSERT_EQUAL_UINT8(0, f->heap.empty);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    TEST_ASSERT_EQUAL_UINT32(1, busy.count);
+
+    // 解除屏蔽，被保留的事件按原有顺序送达 ------------------------------------
+    eos_actor_unblock(&busy.super.super);
+    block_run();
+    TEST_ASSERT_EQUAL_UINT32(4, busy.count);
+    TEST_ASSERT_EQUAL_UINT16(Event_Test, busy.log[1]);
+    TEST_ASSERT_EQUAL_UINT16(Event_TestFsm, busy.log[2]);
+    TEST_ASSERT_EQUAL_UINT16(Event_Test, busy.log[3]);
+    TEST_ASSERT_EQUAL_UINT32(0, f->heap.sub_general);
+    TEST_ASSERT_EQUAL_UINT8(1, f->heap.empty);
+
+    // 屏蔽之前已在队列中的事件，同样被保留 ------------------------------------
+    block_reset(&busy);
+    eos_event_pub_topic(Event_TestFsm);
+    eos_actor_block(&busy.super.super);
+    eos_event_pub_topic(Event_Timeout);
+    block_run();
+    TEST_ASSERT_EQUAL_UINT32(1, busy.count);
+    TEST_ASSERT_EQUAL_UINT16(Event_Timeout, busy.log[0]);
+    eos_actor_unblock(&busy.super.super);
+    block_run();
+    TEST_ASSERT_EQUAL_UINT32(2, busy.count);
+    TEST_ASSERT_EQUAL_UINT16(Event_TestFsm, busy.log[1]);
+    TEST_ASSERT_EQUAL_UINT8(1, f->heap.empty);
+
+#if (EOS_USE_DELAY != 0)
+    // 延时期间屏蔽事件，延时结束时先收到Event_Null，再按顺序收到被保留的事件 ----
+    block_reset(&busy);
+    eos_reactor_init(&busy.super, 1, EOS_NULL);
+    eos_reactor_start(&busy.super, EOS_HANDLER_CAST(block_pt_func));
+    eos_event_pub_topic(Event_TestFsm);
+    block_run();
+    TEST_ASSERT_EQUAL_UINT32(1, busy.count);
+    TEST_ASSERT_EQUAL_UINT32(2, f->heap.sub_blocked);
+    eos_event_pub_topic(Event_Test);
+    eos_event_pub_topic(Event_TestFsm);
+    eos_tick_advance(99);
+    block_run();
+    TEST_ASSERT_EQUAL_UINT32(1, busy.count);
+    eos_tick_advance(1);
+    block_run();
+    TEST_ASSERT_EQUAL_UINT32(4, busy.count);
+    TEST_ASSERT_EQUAL_UINT16(Event_Null, busy.log[1]);
+    TEST_ASSERT_EQUAL_UINT16(Event_Test, busy.log[2]);
+    TEST_ASSERT_EQUAL_UINT16(Event_TestFsm, busy.log[3]);
+    TEST_ASSERT_EQUAL_UINT32(0, f->heap.sub_blocked);
+    TEST_ASSERT_EQUAL_UINT32(0, f->delay_unblock);
+#endif
+#endif
+}
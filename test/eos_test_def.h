@@ -25,6 +25,8 @@ enum {
     EosRunErr_TimerRepeated                 = -7,
 };
 
+#define EOS_MAGIC_NUMBER                    0xDEADBEEF
+
 #if (EOS_USE_TIME_EVENT != 0)
 #define EOS_MS_NUM_30DAY                    (2592000000)
 
@@ -32,7 +34,7 @@ enum {
     EosTimerUnit_Ms                         = 0,    // 60S, ms
     EosTimerUnit_100Ms,                             // 100Min, 50ms
     EosTimerUnit_Sec,                               // 16h, 500ms
-    EosTimerUnit_Minute,                            // 15day, 30S
+    EosTimerUnit_Minute,                            // 15day (45day in 64-bit time), 30S
 
     EosTimerUnit_Max
 };
@@ -41,7 +43,11 @@ static const eos_u32_t timer_threshold[EosTimerUnit_Max] = {
     60000,                                          // 60 S
     6000000,                                        // 100 Minutes
     57600000,                                       // 16 hours
+#if (EOS_USE_TIME_64BIT != 0)
+    3932100000,                                     // 65535 minutes, about 45 days
+#else
     1296000000,                                     // 15 days
+#endif
 };
 
 static const eos_u32_t timer_unit[EosTimerUnit_Max] = {
@@ -53,14 +59,66 @@ typedef struct eos_event_timer {
     eos_u32_t oneshoot                      : 1;
     eos_u32_t unit                          : 2;
     eos_u32_t period                        : 16;
-    eos_u32_t timeout_ms;
+    eos_time_t timeout_ms;
+#if (EOS_USE_TIMER_WHEEL != 0)
+    eos_u16_t next;                                 // list of the wheel slot
+    eos_u16_t last;
+    eos_u16_t slot;                                 // level * EOS_WHEEL_SIZE + index
+#endif
+#if (EOS_USE_TIMER_HANDLE != 0)
+    eos_u16_t id;                                   // index of timer_handle[]
+#endif
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+    eos_u16_t data;                                 // event block in the heap, or EOS_HEAP_MAX
+    eos_u8_t actor;                                 // priority of the receiver, or EOS_MAX_ACTORS
+#endif
+#if (EOS_USE_TIMER_EXACT != 0)
+    eos_u8_t catchup;                               // EosTimerCatchUp_xxx
+    eos_u32_t period_ms;                            // exact period, not quantized by the unit
+    eos_timer_stats_t stats;
+#endif
+#if (EOS_USE_TIMER_SLACK != 0)
+    eos_u16_t slack;                                // tolerance after the nominal deadline
+    eos_u16_t shift;                                // timeout_ms - nominal deadline
+#endif
 } eos_event_timer_t;
+
+#if (EOS_USE_TIMER_HANDLE != 0)
+#define EOS_TIMER_NONE                      0xffff
+
+// handle = (seq << 16) | id, id locates the timer in etimer[] through timer_handle[].
+typedef struct eos_timer_handle {
+    eos_u16_t index;                                // index of etimer[], or the next free id
+    eos_u16_t seq;                                  // changed when the id is released, never 0
+} eos_timer_handle_t;
+#endif
+
+#if (EOS_USE_HRTIMER != 0)
+// timeout and period are in counts of eos_port_hrtime(), compared wrap-safely.
+typedef struct eos_hrtimer {
+    eos_u32_t timeout;
+    eos_u32_t period;                               // 0 means oneshoot
+    eos_topic_t topic;
+} eos_hrtimer_t;
+#endif
+
+#if (EOS_USE_TIMER_WHEEL != 0)
+#define EOS_WHEEL_BITS                      5
+#define EOS_WHEEL_SIZE                      (1 << EOS_WHEEL_BITS)
+#define EOS_WHEEL_MASK                      (EOS_WHEEL_SIZE - 1)
+#define EOS_WHEEL_LEVEL                     6       // 32^6 ms, about 12 days
+#define EOS_WHEEL_DUE                       (EOS_WHEEL_LEVEL * EOS_WHEEL_SIZE)
+#define EOS_WHEEL_NONE                      0xffff
+#endif
 #endif
 
 typedef struct eos_block {
     // word[0]
     eos_u32_t next                          : 15;
     eos_u32_t q_next                        : 15;
+#if (EOS_USE_EVENT_BLOCK != 0)
+    eos_u32_t urgent                        : 1;    // delivered to blocked actors too
+#endif
     // word[1]
     eos_u32_t last                          : 15;
     eos_u32_t q_last                        : 15;
@@ -68,14 +126,78 @@ typedef struct eos_block {
     // word[2]
     eos_u16_t size                          : 15;
     eos_u32_t offset                        : 8;
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+    eos_u32_t pinned                        : 1;    // held by a time event
+    eos_u32_t queued                        : 1;    // in the event queue
+#endif
 } eos_block_t;
 
+// The event id is used by requests, and by events sent to one actor directly.
+#if (EOS_USE_REQUEST != 0 || EOS_USE_TIMER_PAYLOAD != 0 || EOS_USE_DELAY != 0)
+#define EOS_USE_EVENT_ID                    1
+#else
+#define EOS_USE_EVENT_ID                    0
+#endif
+
 typedef struct eos_event_inner {
     eos_sub_t sub;
     eos_topic_t topic;
+#if (EOS_USE_EVENT_ID != 0)
+    eos_u16_t id;                                   // bit15: sent to one actor directly
+#endif
+#if (EOS_USE_EDF != 0)
+    eos_time_t deadline;                            // absolute, EOS_TIME_MAX for none
+#endif
 } eos_event_inner_t;
 
+#if (EOS_USE_EVENT_ID != 0)
+#define EOS_EVENT_ID_DIRECT                 0x8000
+#endif
+
+#if (EOS_USE_REQUEST != 0)
+#define EOS_REQUEST_ID_SEQ_MAX              0x7f
+#define EOS_REQUEST_NONE                    0xff
+
+// id = (seq(7bit) << 8) | slot(8bit), so a reply locates its slot in O(1).
+typedef struct eos_request {
+    eos_time_t timeout_ms;
+    eos_topic_t topic_timeout;
+    eos_u16_t id;                                   // 0 means the slot is free
+    eos_u8_t priority;                              // priority of the requester
+    eos_u8_t next;                                  // free list
+} eos_request_t;
+#endif
+
+#if (EOS_USE_TOPIC_FILTER != 0)
+// The last suppressed event is kept in the filter itself, not in the heap.
+typedef struct eos_filter {
+    eos_time_t timeout_ms;                          // end of the quiet time or the window
+    eos_u32_t interval_ms;
+    eos_topic_t topic;                              // Event_Null means the slot is free
+    eos_u8_t mode;                                  // EosFilter_xxx
+    eos_u8_t active;                                // timeout_ms is valid
+    eos_u8_t pending;                               // an event is held
+#if (EOS_USE_EVENT_DATA != 0)
+    eos_u8_t size;
+    eos_u8_t data[EOS_TOPIC_FILTER_DATA];
+#endif
+} eos_filter_t;
+#endif
+
+#if (EOS_USE_HSM_CACHE != 0)
+// A transition exits up to the LCA and enters down to the target. Keeping the LCA only,
+// the size does not depend on the nesting depth.
+typedef struct eos_hsm_tran {
+    eos_state_handler source;                       // EOS_NULL means the slot is free
+    eos_state_handler target;
+    eos_state_handler lca;
+} eos_hsm_tran_t;
+#endif
+
 typedef struct eos_heap {
+#if (EOS_USE_MAGIC != 0)
+    eos_u32_t magic;
+#endif
     eos_u8_t data[EOS_SIZE_HEAP];
     // word[0]
     eos_u32_t size                          : 15;       /* total size */
@@ -87,9 +209,20 @@ typedef struct eos_heap {
     // word[2]
     eos_sub_t sub_general;
     eos_sub_t count;
+#if (EOS_USE_EVENT_BLOCK != 0)
+    eos_sub_t sub_blocked;                          // actors holding back their events
+    eos_sub_t sub_urgent;                           // actors with urgent events in queue
+#endif
+#if (EOS_USE_EDF != 0)
+    eos_time_t deadline[EOS_MAX_ACTORS];            // the earliest deadline of each actor's events
+    eos_u16_t deadline_num[EOS_MAX_ACTORS];         // number of the actor's events due at it
+#endif
 } eos_heap_t;
 
 typedef struct eos_tag {
+#if (EOS_USE_MAGIC != 0)
+    eos_u32_t magic;
+#endif
 #if (EOS_USE_PUB_SUB != 0)
     eos_mcu_t *sub_table;                                     // event sub table
 #endif
@@ -102,11 +235,76 @@ typedef struct eos_tag {
     eos_heap_t heap;
 #endif
 
+#if (EOS_USE_HSM_CACHE != 0)
+    eos_state_handler hsm_state[EOS_HSM_CACHE_STATE];         // direct mapped, keyed by the state
+    eos_state_handler hsm_super[EOS_HSM_CACHE_STATE];
+    eos_hsm_tran_t hsm_tran[EOS_HSM_CACHE_TRAN];              // keyed by (source, target)
+#endif
+
 #if (EOS_USE_TIME_EVENT != 0)
     eos_event_timer_t etimer[EOS_MAX_TIME_EVENT];
-    eos_u32_t time;
-    eos_u32_t timeout_min;
-    eos_u8_t timer_count;
+    eos_time_t time;
+    eos_time_t timeout_min;
+    eos_u16_t timer_count;
+#if (EOS_USE_TIMER_WHEEL != 0)
+    eos_u16_t wheel[EOS_WHEEL_DUE + 1];                       // slot heads, the last is the due list
+    eos_u32_t wheel_map[EOS_WHEEL_LEVEL];                     // bitmap of non-empty slots
+    eos_time_t wheel_time;                                    // the time before it is processed
+#endif
+#if (EOS_USE_TIMER_HANDLE != 0)
+    eos_timer_handle_t timer_handle[EOS_MAX_TIME_EVENT];
+    eos_u16_t timer_free;                                     // free list of handle ids
+#endif
+#if (EOS_USE_TIMER_SLACK != 0)
+    eos_u32_t timer_phase;                                    // golden ratio sequence of stagger
+#endif
+#endif
+
+#if (EOS_USE_HRTIMER != 0)
+    eos_hrtimer_t hrtimer[EOS_MAX_HRTIMER];
+    eos_u32_t hrtimer_next;                                   // the earliest timeout
+    eos_u8_t hrtimer_count;
+#endif
+
+#if (EOS_USE_REQUEST != 0)
+    eos_request_t request[EOS_MAX_REQUEST];
+    eos_time_t request_timeout_min;
+    eos_u8_t request_count;
+    eos_u8_t request_free;
+    eos_u8_t request_seq;
+#endif
+
+#if (EOS_USE_DELAY != 0)
+    eos_time_t delay_timeout[EOS_MAX_ACTORS];
+    eos_time_t delay_timeout_min;
+    eos_sub_t delay_actor;                                    // actors waiting for a delay
+    eos_u8_t actor_current;                                   // the running actor, or EOS_MAX_ACTORS
+#endif
+
+#if (EOS_USE_TOPIC_FILTER != 0)
+    eos_filter_t filter[EOS_MAX_TOPIC_FILTER];
+    eos_time_t filter_timeout_min;
+    eos_u8_t filter_count;
+#endif
+
+#if (EOS_USE_EVENT_BLOCK != 0)
+    eos_topic_t unblocked[EOS_MAX_UNBLOCKED];
+    eos_u8_t unblocked_count;
+#if (EOS_USE_DELAY != 0)
+    eos_sub_t delay_unblock;                                  // unblocked when the delay ends
+#endif
+#endif
+
+#if (EOS_USE_EDF != 0)
+    eos_u16_t *deadline;                                      // relative deadline of each topic
+    eos_topic_t deadline_count;
+    eos_deadline_stats_t deadline_stats[EOS_MAX_ACTORS];
+#endif
+
+#if (EOS_USE_PREEMPT != 0)
+    eos_s8_t prio_ceiling;                                    // only actors above it may run, -1 when idle
+    eos_s8_t ceiling_sm;                                      // the highest state machine, sharing the cache
+    eos_u8_t isr_nest;                                        // nesting of the interrupts
 #endif
 
     eos_u8_t enabled                        : 1;
@@ -119,7 +317,7 @@ eos_s8_t eos_once(void);
 eos_s8_t eos_event_pub_ret(eos_topic_t topic, void *data, eos_u32_t size);
 void * eos_get_framework(void);
 void eos_event_pub_time(eos_topic_t topic, eos_u32_t time_ms, eos_bool_t oneshoot);
-void eos_set_time(eos_u32_t time_ms);
+void eos_set_time(eos_time_t time_ms);
 // **eos end** -----------------------------------------------------------------
 
 #endif
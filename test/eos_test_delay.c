@@ -0,0 +1,141 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_test.h"
+#include "eos_test_def.h"
+#include "event_def.h"
+#include "unity.h"
+#include "unity_pack.h"
+
+#if (EOS_USE_DELAY != 0)
+/* actors for test ---------------------------------------------------------- */
+typedef struct pt_reactor {
+    eos_reactor_t super;
+    eos_u32_t step;
+    eos_u32_t count;
+} pt_reactor_t;
+
+// 顺序执行：延时100ms，再延时100ms，等待Event_TestReactor，然后从头开始。
+static void pt_func(pt_reactor_t * const me, eos_event_t const * const e)
+{
+    // 等待期间到来的事件也会执行这里
+    if (e->topic == Event_Test) {
+        me->count ++;
+    }
+
+    EOS_PT_BEGIN();
+    me->step = 1;
+    EOS_PT_DELAY(100);
+    me->step = 2;
+    EOS_PT_DELAY(100);
+    me->step = 3;
+    EOS_PT_WAIT_TOPIC(Event_TestReactor);
+    me->step = 4;
+    EOS_PT_END();
+}
+
+static eos_u32_t other_count;
+
+static void other_func(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    (void)e;
+    other_count ++;
+}
+
+/* unit test ---------------------------------------------------------------- */
+#if (EOS_USE_PUB_SUB != 0)
+static eos_mcu_t sub_table[Event_Max];
+#endif
+static pt_reactor_t pt[2];
+static eos_reactor_t other;
+static eos_t *f;
+
+// 推进到time_ms，执行所有事件。
+static void delay_run_to(eos_u32_t time_ms)
+{
+    eos_tick_advance((eos_u32_t)(time_ms - eos_time()));
+    while (eos_once() == EosRun_OK) {
+    }
+}
+#endif
+
+void eos_test_delay(void)
+{
+#if (EOS_USE_DELAY != 0)
+    f = eos_get_framework();
+    eos_set_time(0);
+
+    eos_init();
+#if (EOS_USE_PUB_SUB != 0)
+    eos_sub_init(sub_table, Event_Max);
+#endif
+    for (eos_u32_t i = 0; i < 2; i ++) {
+        pt[i].step = 0;
+        pt[i].count = 0;
+        eos_reactor_init(&pt[i].super, (i + 1), EOS_NULL);
+        eos_reactor_start(&pt[i].super, EOS_HANDLER_CAST(pt_func));
+    }
+    other_count = 0;
+    eos_reactor_init(&other, 0, EOS_NULL);
+    eos_reactor_start(&other, other_func);
+#if (EOS_USE_PUB_SUB != 0)
+    eos_event_sub(&pt[0].super.super, Event_Test);
+    eos_event_sub(&pt[0].super.super, Event_TestReactor);
+    eos_event_sub(&pt[1].super.super, Event_TestFsm);
+    eos_event_sub(&other.super, Event_Test);
+#endif
+
+    // 延时期间不阻塞其他Actor，也照常接收事件 -----------------------------------
+    eos_event_pub_topic(Event_Test);
+    delay_run_to(0);
+    TEST_ASSERT_EQUAL_UINT32(1, pt[0].step);
+    TEST_ASSERT_EQUAL_UINT32(1, pt[0].count);
+#if (EOS_USE_TICKLESS != 0)
+    TEST_ASSERT_EQUAL_UINT32(100, eos_time_deadline());
+#endif
+    delay_run_to(50);
+    eos_event_pub_topic(Event_Test);
+    delay_run_to(50);
+    TEST_ASSERT_EQUAL_UINT32(1, pt[0].step);
+    TEST_ASSERT_EQUAL_UINT32(2, pt[0].count);
+    TEST_ASSERT_EQUAL_UINT32(2, other_count);
+
+    // 另一个Reactor使用同一个协程，各自保存续点与延时 ---------------------------
+    eos_event_pub_topic(Event_TestFsm);
+    delay_run_to(60);
+    TEST_ASSERT_EQUAL_UINT32(1, pt[1].step);
+
+    // 连续的两次延时 -----------------------------------------------------------
+    delay_run_to(99);
+    TEST_ASSERT_EQUAL_UINT32(1, pt[0].step);
+    delay_run_to(100);
+    TEST_ASSERT_EQUAL_UINT32(2, pt[0].step);
+    delay_run_to(159);
+    TEST_ASSERT_EQUAL_UINT32(1, pt[1].step);
+    delay_run_to(160);
+    TEST_ASSERT_EQUAL_UINT32(2, pt[1].step);
+    delay_run_to(199);
+    TEST_ASSERT_EQUAL_UINT32(2, pt[0].step);
+    delay_run_to(200);
+    TEST_ASSERT_EQUAL_UINT32(3, pt[0].step);
+    delay_run_to(260);
+    TEST_ASSERT_EQUAL_UINT32(3, pt[1].step);
+    TEST_ASSERT_EQUAL_UINT32(0, f->delay_actor);
+
+    // 等待主题，其他事件不会使协程继续 -------------------------------------------
+    eos_event_pub_topic(Event_Test);
+    delay_run_to(300);
+    TEST_ASSERT_EQUAL_UINT32(3, pt[0].step);
+    TEST_ASSERT_EQUAL_UINT32(3, pt[0].count);
+    eos_event_pub_topic(Event_TestReactor);
+    delay_run_to(300);
+    TEST_ASSERT_EQUAL_UINT32(4, pt[0].step);
+    TEST_ASSERT_EQUAL_UINT16(0, pt[0].super.pt);
+
+    // 协程结束后，下一个事件从头开始执行 ---------------------------------------
+    eos_event_pub_topic(Event_Test);
+    delay_run_to(300);
+    TEST_ASSERT_EQUAL_UINT32(1, pt[0].step);
+    delay_run_to(400);
+    TEST_ASSERT_EQUAL_UINT32(2, pt[0].step);
+#endif
+}
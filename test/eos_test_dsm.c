@@ -0,0 +1,210 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_test.h"
+#include "eos_test_def.h"
+#include "event_def.h"
+#include "unity.h"
+#include "unity_pack.h"
+#include <string.h>
+
+#if (EOS_USE_SM_DESC != 0)
+/* data --------------------------------------------------------------------- */
+// 与eos_test_hsm.c相同的状态层次，s2没有进入与退出动作：
+// s ─┬─ s1 ── s11 ── s111
+//    └─ s2 ── s21 ── s211
+static char dsm_trace[128];
+static eos_u32_t dsm_calls;                         // handler的调用次数
+
+static void dsm_log(const char *text)
+{
+    strncat(dsm_trace, text, sizeof(dsm_trace) - strlen(dsm_trace) - 1);
+}
+
+#define DSM_ACTION(name_)                                                      \
+static void dsm_enter_##name_(eos_dsm_t * const me)                            \
+{                                                                              \
+    (void)me;                                                                  \
+    dsm_log("+" #name_);                                                       \
+}                                                                              \
+static void dsm_exit_##name_(eos_dsm_t * const me)                             \
+{                                                                              \
+    (void)me;                                                                  \
+    dsm_log("-" #name_);                                                       \
+}
+
+DSM_ACTION(s)
+DSM_ACTION(s1)
+DSM_ACTION(s11)
+DSM_ACTION(s111)
+DSM_ACTION(s21)
+DSM_ACTION(s211)
+
+static eos_ret_t dsm_s(eos_dsm_t * const me, eos_event_t const * const e);
+static eos_ret_t dsm_s1(eos_dsm_t * const me, eos_event_t const * const e);
+static eos_ret_t dsm_s11(eos_dsm_t * const me, eos_event_t const * const e);
+static eos_ret_t dsm_s111(eos_dsm_t * const me, eos_event_t const * const e);
+static eos_ret_t dsm_s211(eos_dsm_t * const me, eos_event_t const * const e);
+
+/* state descriptor --------------------------------------------------------- */
+static const eos_state_t state_s;
+static const eos_state_t state_s1;
+static const eos_state_t state_s11;
+static const eos_state_t state_s111;
+static const eos_state_t state_s2;
+static const eos_state_t state_s21;
+static const eos_state_t state_s211;
+
+static const eos_state_t state_s = {
+    EOS_NULL, &state_s111, dsm_enter_s, dsm_exit_s, dsm_s,
+#if (EOS_USE_STATE_SUB != 0)
+    EOS_NULL, 0
+#endif
+};
+static const eos_state_t state_s1 = {
+    &state_s, &state_s111, dsm_enter_s1, dsm_exit_s1, dsm_s1,
+#if (EOS_USE_STATE_SUB != 0)
+    EOS_NULL, 0
+#endif
+};
+static const eos_state_t state_s11 = {
+    &state_s1, &state_s111, dsm_enter_s11, dsm_exit_s11, dsm_s11,
+#if (EOS_USE_STATE_SUB != 0)
+    EOS_NULL, 0
+#endif
+};
+static const eos_state_t state_s111 = {
+    &state_s11, EOS_NULL, dsm_enter_s111, dsm_exit_s111, dsm_s111,
+#if (EOS_USE_STATE_SUB != 0)
+    EOS_NULL, 0
+#endif
+};
+static const eos_state_t state_s2 = {
+    &state_s, &state_s211, EOS_NULL, EOS_NULL, EOS_NULL,
+#if (EOS_USE_STATE_SUB != 0)
+    EOS_NULL, 0
+#endif
+};
+static const eos_state_t state_s21 = {
+    &state_s2, EOS_NULL, dsm_enter_s21, dsm_exit_s21, EOS_NULL,
+#if (EOS_USE_STATE_SUB != 0)
+    EOS_NULL, 0
+#endif
+};
+static const eos_state_t state_s211 = {
+    &state_s21, EOS_NULL, dsm_enter_s211, dsm_exit_s211, dsm_s211,
+#if (EOS_USE_STATE_SUB != 0)
+    EOS_NULL, 0
+#endif
+};
+
+/* state function ----------------------------------------------------------- */
+static eos_ret_t dsm_s(eos_dsm_t * const me, eos_event_t const * const e)
+{
+    dsm_calls ++;
+    if (e->topic == Event_Request)
+        return EOS_DSM_TRAN(state_s11);
+
+    return EOS_Ret_Null;
+}
+
+static eos_ret_t dsm_s1(eos_dsm_t * const me, eos_event_t const * const e)
+{
+    dsm_calls ++;
+    if (e->topic == Event_Test)
+        return EOS_DSM_TRAN(state_s2);
+
+    return EOS_Ret_Null;
+}
+
+static eos_ret_t dsm_s11(eos_dsm_t * const me, eos_event_t const * const e)
+{
+    dsm_calls ++;
+    if (e->topic == Event_TestHsm)
+        return EOS_DSM_TRAN(state_s11);
+
+    return EOS_Ret_Null;
+}
+
+static eos_ret_t dsm_s111(eos_dsm_t * const me, eos_event_t const * const e)
+{
+    dsm_calls ++;
+    if (e->topic == Event_TestReactor)
+        return EOS_DSM_TRAN(state_s1);
+    if (e->topic == Event_Time_500ms)
+        return EOS_Ret_Handled;
+
+    return EOS_Ret_Null;
+}
+
+static eos_ret_t dsm_s211(eos_dsm_t * const me, eos_event_t const * const e)
+{
+    dsm_calls ++;
+    if (e->topic == Event_TestFsm)
+        return EOS_DSM_TRAN(state_s111);
+
+    return EOS_Ret_Null;
+}
+
+/* unit test ---------------------------------------------------------------- */
+#if (EOS_USE_PUB_SUB != 0)
+static eos_mcu_t sub_table[Event_Max];
+#endif
+static eos_dsm_t dsm;
+
+// 发布事件并执行，检查退出与进入的顺序、最终的状态，以及handler的调用次数。
+static void dsm_dispatch(eos_topic_t topic, const char *trace,
+                         eos_state_t const *state, eos_u32_t calls)
+{
+    dsm_trace[0] = 0;
+    dsm_calls = 0;
+    eos_event_pub_topic(topic);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_STRING(trace, dsm_trace);
+    TEST_ASSERT_EQUAL_PTR(state, dsm.state);
+    TEST_ASSERT_EQUAL_UINT32(calls, dsm_calls);
+}
+#endif
+
+void eos_test_dsm(void)
+{
+#if (EOS_USE_SM_DESC != 0)
+    eos_set_time(0);
+    eos_init();
+#if (EOS_USE_PUB_SUB != 0)
+    eos_sub_init(sub_table, Event_Max);
+#endif
+
+    // 启动时逐层进入，并沿init钻入 --------------------------------------------
+    dsm_trace[0] = 0;
+    eos_dsm_init(&dsm, 0, EOS_NULL);
+    eos_dsm_start(&dsm, &state_s);
+    TEST_ASSERT_EQUAL_STRING("+s+s1+s11+s111", dsm_trace);
+    TEST_ASSERT_EQUAL_PTR(&state_s111, dsm.state);
+#if (EOS_USE_PUB_SUB != 0)
+    eos_event_sub(&dsm.super, Event_Test);
+    eos_event_sub(&dsm.super, Event_TestFsm);
+    eos_event_sub(&dsm.super, Event_TestHsm);
+    eos_event_sub(&dsm.super, Event_TestReactor);
+    eos_event_sub(&dsm.super, Event_Request);
+    eos_event_sub(&dsm.super, Event_Time_500ms);
+    eos_event_sub(&dsm.super, Event_Timeout);
+#endif
+
+    // 各类转移，只调用处理事件的handler，不存在的进入与退出动作被跳过 ----------
+    for (eos_u32_t i = 0; i < 2; i ++) {
+        // 由父状态处理，转移到另一分支，沿init钻入
+        dsm_dispatch(Event_Test, "-s111-s11-s1+s21+s211", &state_s211, 3);
+        // 转移到另一分支的叶子状态
+        dsm_dispatch(Event_TestFsm, "-s211-s21+s1+s11+s111", &state_s111, 1);
+        // 转移到自身
+        dsm_dispatch(Event_TestHsm, "-s111-s11+s11+s111", &state_s111, 2);
+        // 转移到父状态，父状态不重新进入
+        dsm_dispatch(Event_TestReactor, "-s111-s11+s11+s111", &state_s111, 1);
+        // 由父状态处理，转移到其子孙状态，父状态不退出
+        dsm_dispatch(Event_Test, "-s111-s11-s1+s21+s211", &state_s211, 3);
+        dsm_dispatch(Event_Request, "-s211-s21+s1+s11+s111", &state_s111, 2);
+        // 已处理与未处理的事件
+        dsm_dispatch(Event_Time_500ms, "", &state_s111, 1);
+        dsm_dispatch(Event_Timeout, "", &state_s111, 4);
+    }
+#endif
+}
@@ -0,0 +1,144 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_test.h"
+#include "eos_test_def.h"
+#include "event_def.h"
+#include "unity.h"
+#include "unity_pack.h"
+#include <string.h>
+
+#if (EOS_USE_EDF != 0)
+/* data --------------------------------------------------------------------- */
+// low（优先级0）订阅Test与TestFsm，分别记为"a"与"b"；high（1）订阅TestHsm，记为"H"。
+static char edf_trace[32];
+
+static void edf_low(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    strcat(edf_trace, (e->topic == Event_Test) ? "a" : "b");
+}
+
+static void edf_high(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    (void)e;
+    strcat(edf_trace, "H");
+}
+
+/* unit test ---------------------------------------------------------------- */
+static eos_mcu_t sub_table[Event_Max];
+static eos_u16_t deadline_table[Event_Max];
+static eos_reactor_t low, high;
+
+// 执行调度直至没有事件，检查处理的顺序。
+static void edf_run(const char *trace)
+{
+    edf_trace[0] = 0;
+    while (eos_once() == EosRun_OK) {
+    }
+    TEST_ASSERT_EQUAL_STRING(trace, edf_trace);
+}
+#endif
+
+void eos_test_edf(void)
+{
+#if (EOS_USE_EDF != 0)
+    eos_deadline_stats_t stats;
+
+    eos_set_time(0);
+    eos_init();
+    eos_sub_init(sub_table, Event_Max);
+    eos_deadline_init(deadline_table, Event_Max);
+    eos_reactor_init(&low, 0, EOS_NULL);
+    eos_reactor_start(&low, edf_low);
+    eos_reactor_init(&high, 1, EOS_NULL);
+    eos_reactor_start(&high, edf_high);
+    eos_event_sub(&low.super, Event_Test);
+    eos_event_sub(&low.super, Event_TestFsm);
+    eos_event_sub(&high.super, Event_TestHsm);
+
+    // 没有截止时间时按优先级调度 ------------------------------------------------
+    eos_event_pub_topic(Event_Test);
+    eos_event_pub_topic(Event_TestHsm);
+    edf_run("Ha");
+
+    // 主题的截止时间：有截止时间的事件先于高优先级的事件处理 ---------------------
+    eos_topic_deadline(Event_Test, 10);
+    eos_event_pub_topic(Event_TestHsm);
+    eos_event_pub_topic(Event_Test);
+    edf_run("aH");
+
+    // 截止时刻更早的Actor先处理，相同时按优先级 ---------------------------------
+    eos_event_pub_topic(Event_Test);
+    eos_event_pub_deadline(Event_TestHsm, EOS_NULL, 0, 20);
+    edf_run("aH");
+    eos_event_pub_topic(Event_Test);
+    eos_event_pub_deadline(Event_TestHsm, EOS_NULL, 0, 5);
+    edf_run("Ha");
+    eos_event_pub_topic(Event_Test);
+    eos_event_pub_deadline(Event_TestHsm, EOS_NULL, 0, 10);
+    edf_run("Ha");
+
+    // 同一个Actor先处理最早截止的事件，发布时的截止时间代替主题的 ---------------
+    eos_event_pub_topic(Event_TestFsm);
+    eos_event_pub_topic(Event_Test);
+    eos_event_pub_deadline(Event_TestFsm, EOS_NULL, 0, 5);
+    edf_run("bab");
+
+    // 截止时间统计 --------------------------------------------------------------
+    eos_deadline_stats(&low.super, &stats);
+    TEST_ASSERT_EQUAL_UINT32(6, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.missed);
+    eos_event_pub_topic(Event_Test);
+    eos_set_time(15);
+    edf_run("a");
+    eos_event_pub_topic(Event_Test);
+    eos_set_time(40);
+    edf_run("a");
+    eos_deadline_stats(&low.super, &stats);
+    TEST_ASSERT_EQUAL_UINT32(8, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.missed);
+    TEST_ASSERT_EQUAL_UINT32(15, stats.late_max);
+    TEST_ASSERT_EQUAL_UINT32(20, stats.late_total);
+    eos_deadline_stats(&high.super, &stats);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.missed);
+
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+    // 携带数据的时间事件，数据块每次入队时按主题重新设置截止时刻 -----------------
+    eos_u32_t value = 0;
+    eos_topic_deadline(Event_TestFsm, 3);
+    eos_timer_t timer = eos_timer_period_data(&low.super, Event_TestFsm, 10, &value, sizeof(value));
+    eos_event_pub_topic(Event_TestHsm);
+    eos_set_time(50);
+    edf_run("bH");
+    eos_set_time(60);
+    eos_event_pub_deadline(Event_TestHsm, EOS_NULL, 0, 2);
+    edf_run("Hb");
+    eos_timer_cancel(timer);
+    eos_deadline_stats(&low.super, &stats);
+    TEST_ASSERT_EQUAL_UINT32(10, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.missed);
+#endif
+
+    // 各Actor最早的截止时刻在事件入队与取出时增量更新 -----------------------------
+    eos_t *f = (eos_t *)eos_get_framework();
+    eos_time_t time = f->time;
+    eos_topic_deadline(Event_TestFsm, 0);
+    eos_event_pub_topic(Event_Test);
+    eos_event_pub_deadline(Event_TestFsm, EOS_NULL, 0, 5);
+    eos_event_pub_deadline(Event_TestFsm, EOS_NULL, 0, 5);
+    TEST_ASSERT_TRUE(f->heap.deadline[0] == time + 5);
+    TEST_ASSERT_EQUAL_UINT16(2, f->heap.deadline_num[0]);
+    edf_trace[0] = 0;
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_TRUE(f->heap.deadline[0] == time + 5);
+    TEST_ASSERT_EQUAL_UINT16(1, f->heap.deadline_num[0]);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_TRUE(f->heap.deadline[0] == time + 10);
+    TEST_ASSERT_EQUAL_UINT16(1, f->heap.deadline_num[0]);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_TRUE(f->heap.deadline[0] == EOS_TIME_MAX);
+    TEST_ASSERT_EQUAL_UINT16(0, f->heap.deadline_num[0]);
+    TEST_ASSERT_EQUAL_STRING("bba", edf_trace);
+#endif
+}
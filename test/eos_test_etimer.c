@@ -37,16 +37,28 @@ void eos_test_etimer(void)
 
     // 发送500ms延时事件 --------------------------------------------------------
     TEST_ASSERT_EQUAL_UINT8(0, f->timer_count);
+#if (EOS_USE_TICKLESS != 0)
+    TEST_ASSERT_EQUAL_UINT32(EOS_U32_MAX, eos_time_deadline());
+#endif
     eos_event_pub_delay(Event_Time_500ms, 500);
     TEST_ASSERT_EQUAL_UINT8(1, f->timer_count);
     for (int i = 0; i < 500; i ++) {
         eos_set_time(i);
+#if (EOS_USE_TICKLESS != 0)
+        TEST_ASSERT_EQUAL_UINT32(500 - i, eos_time_deadline());
+#endif
         TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
     }
     eos_set_time(500);
     TEST_ASSERT_EQUAL_UINT8(1, f->timer_count);
+#if (EOS_USE_TICKLESS != 0)
+    TEST_ASSERT_EQUAL_UINT32(0, eos_time_deadline());
+#endif
     TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
     TEST_ASSERT_EQUAL_UINT8(0, f->timer_count);
+#if (EOS_USE_TICKLESS != 0)
+    TEST_ASSERT_EQUAL_UINT32(EOS_U32_MAX, eos_time_deadline());
+#endif
     TEST_ASSERT_EQUAL_UINT32(1, fsm_state(&fsm));
 
     // 再次发送500ms延时事件 ----------------------------------------------------
@@ -178,6 +190,7 @@ void eos_test_etimer(void)
     TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
     TEST_ASSERT_EQUAL_UINT8(0, f->timer_count);
 
+#if (EOS_USE_TIME_64BIT == 0)
     // 测试时间溢出
     eos_set_time(EOS_MS_NUM_30DAY - 100);
     system_time = eos_time();
@@ -202,6 +215,85 @@ void eos_test_etimer(void)
     TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
     TEST_ASSERT_EQUAL_UINT8(0, f->timer_count);
 
+    // 一次推进越过时间溢出，溢出前已到期而尚未处理的事件，溢出后立即到期
+    eos_set_time(EOS_MS_NUM_30DAY - 100);
+    eos_event_pub_delay(Event_Time_500ms, 50);
+    eos_event_pub_delay(Event_TestFsm, 500);
+    eos_tick_advance(50);
+    TEST_ASSERT_EQUAL_UINT32((EOS_MS_NUM_30DAY - 50), eos_time());
+    eos_tick_advance(150);
+    TEST_ASSERT_EQUAL_UINT32(100, eos_time());
+    TEST_ASSERT_EQUAL_UINT32(0, f->etimer[0].timeout_ms);
+    TEST_ASSERT_EQUAL_UINT32(400, f->etimer[1].timeout_ms);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_UINT8(1, f->timer_count);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    eos_tick_advance(300);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_UINT8(0, f->timer_count);
+#else
+    // 64位时间越过30天，超时时间保持不变，不再重新计算
+    eos_set_time(EOS_MS_NUM_30DAY - 100);
+    eos_time_t time_start = eos_time();
+    eos_event_pub_delay(Event_Time_500ms, 500);
+    eos_event_pub_delay(Event_TestFsm, time_17hour);
+    eos_tick_advance(200);
+    TEST_ASSERT_TRUE(f->etimer[0].timeout_ms == (time_start + 500));
+    TEST_ASSERT_TRUE(f->etimer[1].timeout_ms == (time_start + time_17hour));
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    eos_tick_advance(300);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_UINT8(1, f->timer_count);
+    eos_tick_advance(time_17hour - 501);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    eos_tick_advance(1);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_UINT8(0, f->timer_count);
+
+    // 越过32位毫秒数的边界（约49.7天）
+    eos_set_time((eos_time_t)EOS_U32_MAX - 100);
+    time_start = eos_time();
+    eos_event_pub_delay(Event_Time_500ms, 500);
+    TEST_ASSERT_TRUE(f->etimer[0].timeout_ms == (time_start + 500));
+    TEST_ASSERT_TRUE(f->etimer[0].timeout_ms > EOS_U32_MAX);
+#if (EOS_USE_TICKLESS != 0)
+    TEST_ASSERT_EQUAL_UINT32(500, eos_time_deadline());
+#endif
+    eos_tick_advance(499);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    eos_tick_advance(1);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_UINT8(0, f->timer_count);
+
+    // 超过15天的延时与周期事件，从约5年后的时刻开始
+    eos_u32_t time_20day = (eos_u32_t)20 * 24 * 3600 * 1000;
+    eos_set_time((eos_time_t)5 * 365 * 24 * 3600 * 1000);
+    time_start = eos_time();
+    eos_event_pub_delay(Event_Time_500ms, time_20day * 2);
+    eos_event_pub_period(Event_TestFsm, time_20day);
+    TEST_ASSERT_EQUAL_UINT8(2, f->timer_count);
+    TEST_ASSERT_TRUE(f->etimer[0].timeout_ms == (time_start + time_20day * 2));
+    TEST_ASSERT_EQUAL_UINT32((20 * 24 * 60), f->etimer[1].period);
+#if (EOS_USE_TICKLESS != 0)
+    TEST_ASSERT_EQUAL_UINT32(time_20day, eos_time_deadline());
+#endif
+    eos_tick_advance(time_20day - 1);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    eos_tick_advance(1);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    TEST_ASSERT_EQUAL_UINT8(2, f->timer_count);
+    eos_tick_advance(time_20day - 1);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    eos_tick_advance(1);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    TEST_ASSERT_EQUAL_UINT8(1, f->timer_count);
+    eos_event_time_cancel(Event_TestFsm);
+    TEST_ASSERT_EQUAL_UINT8(0, f->timer_count);
+#endif
+
     // 对周期事件进行单元测试
     eos_set_time(0);
     system_time = eos_time();
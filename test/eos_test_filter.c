@@ -0,0 +1,168 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_test.h"
+#include "eos_test_def.h"
+#include "event_def.h"
+#include "unity.h"
+#include "unity_pack.h"
+
+#if (EOS_USE_TOPIC_FILTER != 0)
+/* actors for test ---------------------------------------------------------- */
+static eos_u32_t filter_count[2];
+static eos_u32_t filter_value;
+
+static void filter_func(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    filter_count[e->topic - Event_Test] ++;
+    filter_value = (e->size == sizeof(eos_u32_t)) ? *((eos_u32_t *)e->data) : 0;
+}
+
+/* unit test ---------------------------------------------------------------- */
+#if (EOS_USE_PUB_SUB != 0)
+static eos_mcu_t sub_table[Event_Max];
+#endif
+static eos_reactor_t filter_reactor;
+static eos_t *f;
+
+// 推进到time_ms，执行所有事件。
+static void filter_run_to(eos_u32_t time_ms)
+{
+    eos_tick_advance((eos_u32_t)(time_ms - eos_time()));
+    while (eos_once() == EosRun_OK) {
+    }
+}
+
+static void filter_pub(eos_topic_t topic, eos_u32_t value)
+{
+#if (EOS_USE_EVENT_DATA != 0)
+    eos_event_pub(topic, &value, sizeof(eos_u32_t));
+#else
+    (void)value;
+    eos_event_pub_topic(topic);
+#endif
+}
+#endif
+
+void eos_test_filter(void)
+{
+#if (EOS_USE_TOPIC_FILTER != 0)
+    f = eos_get_framework();
+    eos_set_time(0);
+
+    eos_init();
+#if (EOS_USE_PUB_SUB != 0)
+    eos_sub_init(sub_table, Event_Max);
+#endif
+    eos_reactor_init(&filter_reactor, 0, EOS_NULL);
+    eos_reactor_start(&filter_reactor, filter_func);
+#if (EOS_USE_PUB_SUB != 0)
+    eos_event_sub(&filter_reactor.super, Event_Test);
+    eos_event_sub(&filter_reactor.super, Event_TestFsm);
+#endif
+
+    // 防抖，安静50ms之后只发布最后一次的事件，暂存时不占用事件内存 ----------------
+    TEST_ASSERT_TRUE(eos_topic_filter(Event_Test, EosFilter_Debounce, 50));
+    filter_pub(Event_Test, 1);
+    filter_run_to(10);
+    filter_pub(Event_Test, 2);
+    filter_run_to(20);
+    filter_pub(Event_Test, 3);
+    TEST_ASSERT_EQUAL_UINT32(0, f->heap.count);
+#if (EOS_USE_TICKLESS != 0)
+    // 重新计时只会推迟截止时刻，休眠时长不超过最新的截止时刻
+    TEST_ASSERT_TRUE(eos_time_deadline() <= 50);
+#endif
+    filter_run_to(69);
+    TEST_ASSERT_EQUAL_UINT32(0, filter_count[0]);
+    filter_run_to(70);
+    TEST_ASSERT_EQUAL_UINT32(1, filter_count[0]);
+#if (EOS_USE_EVENT_DATA != 0)
+    TEST_ASSERT_EQUAL_UINT32(3, filter_value);
+#endif
+#if (EOS_USE_TICKLESS != 0)
+    TEST_ASSERT_EQUAL_UINT32(EOS_U32_MAX, eos_time_deadline());
+#endif
+    // 其他主题不受影响
+    filter_pub(Event_TestFsm, 4);
+    filter_run_to(71);
+    TEST_ASSERT_EQUAL_UINT32(1, filter_count[1]);
+
+    // 节流，窗口之外立即发布，窗口之内只在窗口结束时发布最后一次的事件 --------------
+    TEST_ASSERT_TRUE(eos_topic_filter(Event_Test, EosFilter_Throttle, 100));
+    filter_run_to(100);
+    filter_count[0] = 0;
+    filter_pub(Event_Test, 1);
+    filter_run_to(100);
+    TEST_ASSERT_EQUAL_UINT32(1, filter_count[0]);
+    filter_pub(Event_Test, 2);
+    filter_run_to(110);
+    filter_pub(Event_Test, 3);
+    TEST_ASSERT_EQUAL_UINT32(0, f->heap.count);
+    filter_run_to(199);
+    TEST_ASSERT_EQUAL_UINT32(1, filter_count[0]);
+    filter_run_to(200);
+    TEST_ASSERT_EQUAL_UINT32(2, filter_count[0]);
+#if (EOS_USE_EVENT_DATA != 0)
+    TEST_ASSERT_EQUAL_UINT32(3, filter_value);
+#endif
+    // 窗口结束时的发布开启了下一个窗口
+    filter_pub(Event_Test, 4);
+    filter_run_to(299);
+    TEST_ASSERT_EQUAL_UINT32(2, filter_count[0]);
+    filter_run_to(300);
+    TEST_ASSERT_EQUAL_UINT32(3, filter_count[0]);
+    // 窗口内没有事件，窗口结束，此后的事件再次立即发布
+    filter_run_to(400);
+    TEST_ASSERT_EQUAL_UINT32(3, filter_count[0]);
+    filter_run_to(450);
+    filter_pub(Event_Test, 5);
+    filter_run_to(450);
+    TEST_ASSERT_EQUAL_UINT32(4, filter_count[0]);
+
+    // 高频的周期事件经过节流 -----------------------------------------------------
+    eos_event_pub_period(Event_Test, 10);
+    for (eos_u32_t time = 451; time <= 1050; time ++) {
+        filter_run_to(time);
+    }
+    TEST_ASSERT_EQUAL_UINT32(10, filter_count[0]);
+    eos_event_time_cancel(Event_Test);
+
+    // 取消过滤，暂存的事件被丢弃，此后的事件直接发布 ------------------------------
+    filter_pub(Event_Test, 6);
+    eos_topic_filter_cancel(Event_Test);
+    TEST_ASSERT_EQUAL_UINT8(0, f->filter_count);
+    filter_run_to(2000);
+    TEST_ASSERT_EQUAL_UINT32(10, filter_count[0]);
+    filter_pub(Event_Test, 7);
+    filter_run_to(2000);
+    TEST_ASSERT_EQUAL_UINT32(11, filter_count[0]);
+
+#if (EOS_USE_EVENT_DATA != 0)
+    // 数据放不进过滤器的事件直接发布，不影响暂存的事件 ----------------------------
+    eos_u8_t data_large[EOS_TOPIC_FILTER_DATA + 4] = { 0 };
+    TEST_ASSERT_TRUE(eos_topic_filter(Event_Test, EosFilter_Debounce, 50));
+    filter_pub(Event_Test, 8);
+    eos_event_pub(Event_Test, data_large, sizeof(data_large));
+    filter_run_to(2001);
+    TEST_ASSERT_EQUAL_UINT32(12, filter_count[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, filter_value);
+    filter_run_to(2050);
+    TEST_ASSERT_EQUAL_UINT32(13, filter_count[0]);
+    TEST_ASSERT_EQUAL_UINT32(8, filter_value);
+    eos_topic_filter_cancel(Event_Test);
+#endif
+
+    // 过滤器已满 ----------------------------------------------------------------
+    for (eos_u32_t i = 0; i < EOS_MAX_TOPIC_FILTER; i ++) {
+        TEST_ASSERT_TRUE(eos_topic_filter(Event_Max + i, EosFilter_Debounce, 10));
+    }
+    TEST_ASSERT_FALSE(eos_topic_filter(Event_Test, EosFilter_Debounce, 10));
+    eos_topic_filter_cancel(Event_Max);
+    TEST_ASSERT_TRUE(eos_topic_filter(Event_Test, EosFilter_Debounce, 10));
+    for (eos_u32_t i = 1; i < EOS_MAX_TOPIC_FILTER; i ++) {
+        eos_topic_filter_cancel(Event_Max + i);
+    }
+    eos_topic_filter_cancel(Event_Test);
+    TEST_ASSERT_EQUAL_UINT8(0, f->filter_count);
+#endif
+}
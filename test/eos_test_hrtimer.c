@@ -0,0 +1,105 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_test.h"
+#include "eos_test_def.h"
+#include "event_def.h"
+#include "unity.h"
+#include "unity_pack.h"
+
+#if (EOS_USE_HRTIMER != 0)
+/* actors for test ---------------------------------------------------------- */
+static eos_u32_t hr_count[2];
+
+static void hr_func(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    hr_count[e->topic - Event_Time_500ms] ++;
+}
+
+/* unit test ---------------------------------------------------------------- */
+#if (EOS_USE_PUB_SUB != 0)
+static eos_mcu_t sub_table[Event_Max];
+#endif
+static eos_reactor_t hr_reactor;
+static eos_t *f;
+
+static void hr_set(eos_u32_t us)
+{
+    set_time_hr(us / EOS_HRTIMER_RES_US);
+}
+#endif
+
+void eos_test_hrtimer(void)
+{
+#if (EOS_USE_HRTIMER != 0)
+    f = eos_get_framework();
+    eos_set_time(0);
+    hr_set(0);
+
+    eos_init();
+#if (EOS_USE_PUB_SUB != 0)
+    eos_sub_init(sub_table, Event_Max);
+#endif
+    eos_reactor_init(&hr_reactor, 0, EOS_NULL);
+    eos_reactor_start(&hr_reactor, hr_func);
+#if (EOS_USE_PUB_SUB != 0)
+    eos_event_sub(&hr_reactor.super, Event_Time_500ms);
+    eos_event_sub(&hr_reactor.super, Event_Time_2000ms);
+#endif
+
+    // 延时事件，计数器溢出回绕 -------------------------------------------------
+    TEST_ASSERT_EQUAL_UINT32(EOS_U32_MAX, eos_time_deadline_us());
+    set_time_hr(0xffffff00);
+    eos_event_pub_delay_us(Event_Time_500ms, 300 * EOS_HRTIMER_RES_US);
+    TEST_ASSERT_EQUAL_UINT8(1, f->hrtimer_count);
+    TEST_ASSERT_EQUAL_UINT32(300 * EOS_HRTIMER_RES_US, eos_time_deadline_us());
+    set_time_hr(0x2b);
+    TEST_ASSERT_EQUAL_UINT32(EOS_HRTIMER_RES_US, eos_time_deadline_us());
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    set_time_hr(0x2c);
+    TEST_ASSERT_EQUAL_UINT32(0, eos_time_deadline_us());
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_UINT32(1, hr_count[0]);
+    TEST_ASSERT_EQUAL_UINT8(0, f->hrtimer_count);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+
+    // 周期事件按截止时刻推进，不随处理时刻漂移 ---------------------------------
+    hr_count[0] = 0;
+    hr_set(0);
+    eos_event_pub_period_us(Event_Time_500ms, 100);
+    eos_event_pub_delay_us(Event_Time_2000ms, 1000);
+    TEST_ASSERT_EQUAL_UINT8(2, f->hrtimer_count);
+    hr_set(130);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_UINT32(1, hr_count[0]);
+    TEST_ASSERT_EQUAL_UINT32(70, eos_time_deadline_us());
+    hr_set(199);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    hr_set(200);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_UINT32(2, hr_count[0]);
+
+    // 错过多个周期时，只发布一次，并跳到下一个周期的截止时刻
+    hr_set(650);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    TEST_ASSERT_EQUAL_UINT32(3, hr_count[0]);
+    TEST_ASSERT_EQUAL_UINT32(50, eos_time_deadline_us());
+
+    // 同时到期的两个事件
+    hr_set(1000);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    TEST_ASSERT_EQUAL_UINT32(4, hr_count[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, hr_count[1]);
+    TEST_ASSERT_EQUAL_UINT8(1, f->hrtimer_count);
+
+    // 取消
+    eos_event_time_cancel(Event_Time_500ms);
+    TEST_ASSERT_EQUAL_UINT8(0, f->hrtimer_count);
+    TEST_ASSERT_EQUAL_UINT32(EOS_U32_MAX, eos_time_deadline_us());
+    hr_set(2000);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    TEST_ASSERT_EQUAL_UINT32(4, hr_count[0]);
+#endif
+}
@@ -0,0 +1,341 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_test.h"
+#include "eos_test_def.h"
+#include "event_def.h"
+#include "unity.h"
+#include "unity_pack.h"
+#include <string.h>
+
+#if (EOS_USE_SM_MODE != 0 && EOS_USE_HSM_MODE != 0)
+/* data --------------------------------------------------------------------- */
+// 状态层次（4层）：
+// s ─┬─ s1 ── s11 ── s111
+//    └─ s2 ── s21 ── s211
+typedef struct hsm_tag {
+    eos_sm_t super;
+} hsm_t;
+
+static char hsm_trace[128];
+static eos_u32_t hsm_probe;                         // 用Event_Null探测父状态的次数
+
+static void hsm_log(const char *text)
+{
+    strncat(hsm_trace, text, sizeof(hsm_trace) - strlen(hsm_trace) - 1);
+}
+
+
+// 记录进入与退出，统计探测次数。返回EOS_True表示事件已处理。
+static eos_bool_t hsm_common(eos_event_t const * const e, const char *name)
+{
+    if (e->topic == Event_Null) {
+        hsm_probe ++;
+    }
+    else if (e->topic == Event_Enter) {
+        hsm_log("+");
+        hsm_log(name);
+        return EOS_True;
+    }
+    else if (e->topic == Event_Exit) {
+        hsm_log("-");
+        hsm_log(name);
+        return EOS_True;
+    }
+
+    return EOS_False;
+}
+
+/* state function ----------------------------------------------------------- */
+static eos_ret_t hsm_s(hsm_t * const me, eos_event_t const * const e);
+static eos_ret_t hsm_s1(hsm_t * const me, eos_event_t const * const e);
+static eos_ret_t hsm_s11(hsm_t * const me, eos_event_t const * const e);
+static eos_ret_t hsm_s111(hsm_t * const me, eos_event_t const * const e);
+static eos_ret_t hsm_s2(hsm_t * const me, eos_event_t const * const e);
+static eos_ret_t hsm_s21(hsm_t * const me, eos_event_t const * const e);
+static eos_ret_t hsm_s211(hsm_t * const me, eos_event_t const * const e);
+
+static eos_ret_t hsm_init(hsm_t * const me, eos_event_t const * const e)
+{
+    (void)e;
+#if (EOS_USE_PUB_SUB != 0)
+    EOS_EVENT_SUB(Event_Test);
+    EOS_EVENT_SUB(Event_TestFsm);
+    EOS_EVENT_SUB(Event_TestHsm);
+    EOS_EVENT_SUB(Event_TestReactor);
+    EOS_EVENT_SUB(Event_Request);
+#endif
+
+    return EOS_TRAN(hsm_s);
+}
+
+static eos_ret_t hsm_s(hsm_t * const me, eos_event_t const * const e)
+{
+    if (hsm_common(e, "s") == EOS_True)
+        return EOS_Ret_Handled;
+
+    switch (e->topic) {
+        case Event_Init:
+            return EOS_TRAN(hsm_s111);
+
+        case Event_Request:
+            return EOS_TRAN(hsm_s11);
+
+        default:
+            return EOS_SUPER(eos_state_top);
+    }
+}
+
+static eos_ret_t hsm_s1(hsm_t * const me, eos_event_t const * const e)
+{
+    if (hsm_common(e, "s1") == EOS_True)
+        return EOS_Ret_Handled;
+
+    switch (e->topic) {
+        case Event_Init:
+            return EOS_TRAN(hsm_s111);
+
+        case Event_Test:
+            return EOS_TRAN(hsm_s2);
+
+        default:
+            return EOS_SUPER(hsm_s);
+    }
+}
+
+static eos_ret_t hsm_s11(hsm_t * const me, eos_event_t const * const e)
+{
+    if (hsm_common(e, "s11") == EOS_True)
+        return EOS_Ret_Handled;
+
+    switch (e->topic) {
+        case Event_Init:
+            return EOS_TRAN(hsm_s111);
+
+        case Event_TestHsm:
+            return EOS_TRAN(hsm_s11);
+
+        default:
+            return EOS_SUPER(hsm_s1);
+    }
+}
+
+static eos_ret_t hsm_s111(hsm_t * const me, eos_event_t const * const e)
+{
+    if (hsm_common(e, "s111") == EOS_True)
+        return EOS_Ret_Handled;
+
+    switch (e->topic) {
+        case Event_TestReactor:
+            return EOS_TRAN(hsm_s1);
+
+        default:
+            return EOS_SUPER(hsm_s11);
+    }
+}
+
+static eos_ret_t hsm_s2(hsm_t * const me, eos_event_t const * const e)
+{
+    if (hsm_common(e, "s2") == EOS_True)
+        return EOS_Ret_Handled;
+
+    switch (e->topic) {
+        case Event_Init:
+            return EOS_TRAN(hsm_s211);
+
+        default:
+            return EOS_SUPER(hsm_s);
+    }
+}
+
+static eos_ret_t hsm_s21(hsm_t * const me, eos_event_t const * const e)
+{
+    if (hsm_common(e, "s21") == EOS_True)
+        return EOS_Ret_Handled;
+
+    return EOS_SUPER(hsm_s2);
+}
+
+static eos_ret_t hsm_s211(hsm_t * const me, eos_event_t const * const e)
+{
+    if (hsm_common(e, "s211") == EOS_True)
+        return EOS_Ret_Handled;
+
+    switch (e->topic) {
+        case Event_TestFsm:
+            return EOS_TRAN(hsm_s111);
+
+        default:
+            return EOS_SUPER(hsm_s21);
+    }
+}
+
+#if (EOS_MAX_HSM_NEST_DEPTH >= 8)
+// 8层的状态机，另一分支在第2层分出：
+// d1 ── d2 ─┬─ d3 ── d4 ── d5 ── d6 ── d7 ── d8
+//           └─ e3 ── e4 ── e5 ── e6 ── e7 ── e8
+#define HSM_DEEP_STATE(name_, super_, topic_, target_)                         \
+static eos_ret_t hsm_##name_(hsm_t * const me, eos_event_t const * const e)   \
+{                                                                              \
+    if (hsm_common(e, #name_) == EOS_True)                                     \
+        return EOS_Ret_Handled;                                                \
+    if (e->topic == (topic_))                                                  \
+        return EOS_TRAN(target_);                                              \
+    return EOS_SUPER(super_);                                                  \
+}
+
+static eos_ret_t hsm_d1(hsm_t * const me, eos_event_t const * const e);
+static eos_ret_t hsm_d8(hsm_t * const me, eos_event_t const * const e);
+static eos_ret_t hsm_e8(hsm_t * const me, eos_event_t const * const e);
+
+HSM_DEEP_STATE(d2, hsm_d1, Event_Max, hsm_d2)
+HSM_DEEP_STATE(d3, hsm_d2, Event_Max, hsm_d3)
+HSM_DEEP_STATE(d4, hsm_d3, Event_Max, hsm_d4)
+HSM_DEEP_STATE(d5, hsm_d4, Event_Max, hsm_d5)
+HSM_DEEP_STATE(d6, hsm_d5, Event_Max, hsm_d6)
+HSM_DEEP_STATE(d7, hsm_d6, Event_Max, hsm_d7)
+HSM_DEEP_STATE(d8, hsm_d7, Event_Test, hsm_e8)
+HSM_DEEP_STATE(e3, hsm_d2, Event_Max, hsm_e3)
+HSM_DEEP_STATE(e4, hsm_e3, Event_Max, hsm_e4)
+HSM_DEEP_STATE(e5, hsm_e4, Event_Max, hsm_e5)
+HSM_DEEP_STATE(e6, hsm_e5, Event_Max, hsm_e6)
+HSM_DEEP_STATE(e7, hsm_e6, Event_Max, hsm_e7)
+HSM_DEEP_STATE(e8, hsm_e7, Event_TestFsm, hsm_d8)
+
+static eos_ret_t hsm_deep_init(hsm_t * const me, eos_event_t const * const e)
+{
+    (void)e;
+#if (EOS_USE_PUB_SUB != 0)
+    EOS_EVENT_SUB(Event_Test);
+    EOS_EVENT_SUB(Event_TestFsm);
+    EOS_EVENT_SUB(Event_TestHsm);
+#endif
+
+    return EOS_TRAN(hsm_d1);
+}
+
+static eos_ret_t hsm_d1(hsm_t * const me, eos_event_t const * const e)
+{
+    if (hsm_common(e, "d1") == EOS_True)
+        return EOS_Ret_Handled;
+
+    switch (e->topic) {
+        case Event_Init:
+            return EOS_TRAN(hsm_d8);
+
+        case Event_TestHsm:
+            return EOS_TRAN(hsm_d8);
+
+        default:
+            return EOS_SUPER(eos_state_top);
+    }
+}
+#endif
+
+/* unit test ---------------------------------------------------------------- */
+#if (EOS_USE_PUB_SUB != 0)
+static eos_mcu_t sub_table[Event_Max];
+#endif
+static hsm_t hsm, hsm_deep;
+static hsm_t *hsm_active;
+
+// 发布事件并执行，检查退出与进入的顺序，以及最终的状态。
+static void hsm_dispatch(eos_topic_t topic, const char *trace, void *state)
+{
+    hsm_trace[0] = 0;
+    eos_event_pub_topic(topic);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_STRING(trace, hsm_trace);
+    TEST_ASSERT_EQUAL_PTR(state, (void *)hsm_active->super.state);
+}
+
+// 一轮覆盖各类转移的事件
+static void hsm_round(void)
+{
+    // 由子状态处理，转移到另一分支，目标状态的Init逐层钻入
+    hsm_dispatch(Event_Test, "-s111-s11-s1+s2+s21+s211", (void *)hsm_s211);
+    // 转移到另一分支的叶子状态
+    hsm_dispatch(Event_TestFsm, "-s211-s21-s2+s1+s11+s111", (void *)hsm_s111);
+    // 转移到自身
+    hsm_dispatch(Event_TestHsm, "-s111-s11+s11+s111", (void *)hsm_s111);
+    // 转移到父状态，父状态不重新进入
+    hsm_dispatch(Event_TestReactor, "-s111-s11+s11+s111", (void *)hsm_s111);
+    // 由父状态处理，转移到其子孙状态，父状态不退出
+    hsm_dispatch(Event_Test, "-s111-s11-s1+s2+s21+s211", (void *)hsm_s211);
+    hsm_dispatch(Event_Request, "-s211-s21-s2+s1+s11+s111", (void *)hsm_s111);
+    // 未处理的事件
+    hsm_dispatch(Event_Time_500ms, "", (void *)hsm_s111);
+}
+#endif
+
+void eos_test_hsm(void)
+{
+#if (EOS_USE_SM_MODE != 0 && EOS_USE_HSM_MODE != 0)
+    eos_set_time(0);
+    eos_init();
+#if (EOS_USE_PUB_SUB != 0)
+    eos_sub_init(sub_table, Event_Max);
+#endif
+
+    // 启动时逐层进入初始状态 ----------------------------------------------------
+    hsm_trace[0] = 0;
+    hsm_active = &hsm;
+    eos_sm_init(&hsm.super, 0, EOS_NULL);
+    eos_sm_start(&hsm.super, EOS_STATE_CAST(hsm_init));
+#if (EOS_USE_PUB_SUB != 0)
+    eos_event_sub(&hsm.super.super, Event_Time_500ms);
+#endif
+    TEST_ASSERT_EQUAL_STRING("+s+s1+s11+s111", hsm_trace);
+    TEST_ASSERT_EQUAL_PTR((void *)hsm_s111, (void *)hsm.super.state);
+
+    // 各类转移的退出与进入顺序 --------------------------------------------------
+    hsm_probe = 0;
+    hsm_round();
+    TEST_ASSERT_TRUE(hsm_probe > 0);
+#if (EOS_USE_HSM_CACHE != 0)
+    // 缓存之后，不再用Event_Null探测父状态 --------------------------------------
+    hsm_probe = 0;
+    hsm_round();
+    TEST_ASSERT_EQUAL_UINT32(0, hsm_probe);
+
+    // 显式清空缓存后重新探测，结果不变 ------------------------------------------
+    eos_sm_cache_clear();
+    hsm_round();
+    TEST_ASSERT_TRUE(hsm_probe > 0);
+    hsm_probe = 0;
+    hsm_round();
+    TEST_ASSERT_EQUAL_UINT32(0, hsm_probe);
+#endif
+
+#if (EOS_MAX_HSM_NEST_DEPTH >= 8)
+    // 8层嵌套：启动时逐层进入8层 ------------------------------------------------
+    eos_init();
+#if (EOS_USE_PUB_SUB != 0)
+    eos_sub_init(sub_table, Event_Max);
+#endif
+    hsm_trace[0] = 0;
+    hsm_active = &hsm_deep;
+    eos_sm_init(&hsm_deep.super, 0, EOS_NULL);
+    eos_sm_start(&hsm_deep.super, EOS_STATE_CAST(hsm_deep_init));
+    TEST_ASSERT_EQUAL_STRING("+d1+d2+d3+d4+d5+d6+d7+d8", hsm_trace);
+    TEST_ASSERT_EQUAL_PTR((void *)hsm_d8, (void *)hsm_deep.super.state);
+
+    for (eos_u32_t i = 0; i < 2; i ++) {
+        hsm_probe = 0;
+        // 叶子之间的转移，LCA在第2层
+        hsm_dispatch(Event_Test, "-d8-d7-d6-d5-d4-d3+e3+e4+e5+e6+e7+e8", (void *)hsm_e8);
+        hsm_dispatch(Event_TestFsm, "-e8-e7-e6-e5-e4-e3+d3+d4+d5+d6+d7+d8", (void *)hsm_d8);
+        // 由第1层处理，转移到第8层，第1层不退出
+        hsm_dispatch(Event_Test, "-d8-d7-d6-d5-d4-d3+e3+e4+e5+e6+e7+e8", (void *)hsm_e8);
+        hsm_dispatch(Event_TestHsm, "-e8-e7-e6-e5-e4-e3-d2+d2+d3+d4+d5+d6+d7+d8", (void *)hsm_d8);
+#if (EOS_USE_HSM_CACHE != 0)
+        // 第二轮全部命中缓存
+        if (i == 0) {
+            TEST_ASSERT_TRUE(hsm_probe > 0);
+        }
+        else {
+            TEST_ASSERT_EQUAL_UINT32(0, hsm_probe);
+        }
+#endif
+    }
+#endif
+#endif
+}
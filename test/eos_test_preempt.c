@@ -0,0 +1,209 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_test.h"
+#include "eos_test_def.h"
+#include "event_def.h"
+#include "unity.h"
+#include "unity_pack.h"
+#include <signal.h>
+#include <string.h>
+
+#if (EOS_USE_PREEMPT != 0)
+/* data --------------------------------------------------------------------- */
+// 以SIGUSR1模拟中断，中断服务函数发布一次preempt_isr_topic。三个Reactor：low（优先级0）订阅
+// Test，mid（1）订阅TestHsm，high（2）订阅TestFsm与TestHsm。low在处理中触发中断，high在处理
+// 中也触发中断。
+static char preempt_trace[64];
+static eos_topic_t preempt_isr_topic;
+static eos_bool_t preempt_lock;
+
+static void preempt_log(const char *text)
+{
+    strncat(preempt_trace, text, sizeof(preempt_trace) - strlen(preempt_trace) - 1);
+}
+
+static void preempt_isr(int sig)
+{
+    (void)sig;
+    eos_isr_enter();
+    eos_event_pub_topic(preempt_isr_topic);
+    preempt_isr_topic = Event_Null;
+    eos_isr_exit();
+}
+
+// 如设定了中断发布的主题，触发一次中断
+static void preempt_raise(void)
+{
+    if (preempt_isr_topic != Event_Null) {
+        raise(SIGUSR1);
+    }
+}
+
+static void preempt_low(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    (void)e;
+    preempt_log("L1");
+    if (preempt_lock == EOS_True) {
+        eos_s8_t lock = eos_sched_lock(1);
+        preempt_raise();
+        preempt_log("L2");
+        eos_sched_unlock(lock);
+        preempt_log("L3");
+    }
+    else {
+        preempt_raise();
+        preempt_log("L2");
+    }
+}
+
+static void preempt_mid(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    (void)e;
+    preempt_log("M");
+}
+
+static void preempt_high(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    (void)e;
+    preempt_log("H");
+    preempt_raise();
+}
+
+#if (EOS_USE_SM_MODE != 0)
+// 两个状态机：sm_low（优先级1）处理Test时触发中断，sm_high（3）处理TestFsm时在两个状态间转移。
+// 开启结构缓存时，两者共用缓存。
+static eos_ret_t preempt_sm_low(eos_sm_t * const me, eos_event_t const * const e);
+static eos_ret_t preempt_sm_a(eos_sm_t * const me, eos_event_t const * const e);
+static eos_ret_t preempt_sm_b(eos_sm_t * const me, eos_event_t const * const e);
+
+static eos_ret_t preempt_sm_init(eos_sm_t * const me, eos_event_t const * const e)
+{
+    (void)e;
+    if (me->super.priority == 1) {
+        eos_event_sub(&me->super, Event_Test);
+        return EOS_TRAN(preempt_sm_low);
+    }
+    eos_event_sub(&me->super, Event_TestFsm);
+    return EOS_TRAN(preempt_sm_a);
+}
+
+static eos_ret_t preempt_sm_low(eos_sm_t * const me, eos_event_t const * const e)
+{
+    if (e->topic == Event_Test) {
+        preempt_log("L1");
+        preempt_raise();
+        preempt_log("L2");
+        return EOS_Ret_Handled;
+    }
+
+    return EOS_SUPER(eos_state_top);
+}
+
+static eos_ret_t preempt_sm_a(eos_sm_t * const me, eos_event_t const * const e)
+{
+    if (e->topic == Event_TestFsm) {
+        preempt_log("H");
+        return EOS_TRAN(preempt_sm_b);
+    }
+
+    return EOS_SUPER(eos_state_top);
+}
+
+static eos_ret_t preempt_sm_b(eos_sm_t * const me, eos_event_t const * const e)
+{
+    if (e->topic == Event_TestFsm) {
+        preempt_log("H");
+        return EOS_TRAN(preempt_sm_a);
+    }
+
+    return EOS_SUPER(eos_state_top);
+}
+#endif
+
+/* unit test ---------------------------------------------------------------- */
+static eos_mcu_t sub_table[Event_Max];
+static eos_reactor_t low, mid, high;
+#if (EOS_USE_SM_MODE != 0)
+static eos_sm_t sm_low, sm_high;
+#endif
+
+// 发布事件，调度一次，检查处理的顺序。
+static void preempt_once(eos_topic_t topic, eos_topic_t isr_topic, const char *trace)
+{
+    preempt_trace[0] = 0;
+    preempt_isr_topic = isr_topic;
+    eos_event_pub_topic(topic);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_STRING(trace, preempt_trace);
+}
+#endif
+
+void eos_test_preempt(void)
+{
+#if (EOS_USE_PREEMPT != 0)
+    struct sigaction action;
+    struct sigaction action_old;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = preempt_isr;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGUSR1, &action, &action_old);
+
+    eos_set_time(0);
+    eos_init();
+    eos_sub_init(sub_table, Event_Max);
+    eos_reactor_init(&low, 0, EOS_NULL);
+    eos_reactor_start(&low, preempt_low);
+    eos_reactor_init(&mid, 1, EOS_NULL);
+    eos_reactor_start(&mid, preempt_mid);
+    eos_reactor_init(&high, 2, EOS_NULL);
+    eos_reactor_start(&high, preempt_high);
+    eos_event_sub(&low.super, Event_Test);
+    eos_event_sub(&mid.super, Event_TestHsm);
+    eos_event_sub(&high.super, Event_TestFsm);
+    eos_event_sub(&high.super, Event_TestHsm);
+
+    // 中断退出时，高优先级的Actor依次抢占低优先级的Actor -------------------------
+    preempt_lock = EOS_False;
+    preempt_once(Event_Test, Event_TestHsm, "L1HML2");
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+
+    // 优先级天花板之下的Actor推迟到解锁时抢占 -------------------------------------
+    preempt_lock = EOS_True;
+    preempt_once(Event_Test, Event_TestHsm, "L1HL2ML3");
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+
+    // 低优先级的事件不抢占，在下一次调度时处理 -----------------------------------
+    preempt_lock = EOS_False;
+    preempt_once(Event_TestFsm, Event_Test, "H");
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_STRING("HL1L2", preempt_trace);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+
+    // 空闲时的中断，退出时即处理其发布的事件 -------------------------------------
+    preempt_trace[0] = 0;
+    preempt_isr_topic = Event_TestHsm;
+    preempt_raise();
+    TEST_ASSERT_EQUAL_STRING("HM", preempt_trace);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+
+#if (EOS_USE_SM_MODE != 0)
+    // 高优先级的状态机抢占低优先级的状态机，结构缓存只在查找与填入时加锁 ------------
+    eos_init();
+    eos_sub_init(sub_table, Event_Max);
+    eos_sm_init(&sm_low, 1, EOS_NULL);
+    eos_sm_start(&sm_low, EOS_STATE_CAST(preempt_sm_init));
+    eos_sm_init(&sm_high, 3, EOS_NULL);
+    eos_sm_start(&sm_high, EOS_STATE_CAST(preempt_sm_init));
+    for (eos_u32_t i = 0; i < 3; i ++) {
+        preempt_once(Event_Test, Event_TestFsm, "L1HL2");
+        TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    }
+    TEST_ASSERT_TRUE(sm_high.state == EOS_STATE_CAST(preempt_sm_b));
+    TEST_ASSERT_EQUAL_INT8(-1, ((eos_t *)eos_get_framework())->prio_ceiling);
+#endif
+
+    sigaction(SIGUSR1, &action_old, EOS_NULL);
+#endif
+}
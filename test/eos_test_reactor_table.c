@@ -0,0 +1,108 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_test.h"
+#include "eos_test_def.h"
+#include "event_def.h"
+#include "unity.h"
+#include "unity_pack.h"
+#include <string.h>
+
+#if (EOS_USE_REACTOR_TABLE != 0)
+/* data --------------------------------------------------------------------- */
+// 每个处理函数记下一个字母，检查事件交给了哪个处理函数。
+static char table_trace[32];
+
+#define TABLE_HANDLER(name_)                                                   \
+static void table_##name_(eos_reactor_t * const me, eos_event_t const * const e) \
+{                                                                              \
+    (void)me;                                                                  \
+    (void)e;                                                                   \
+    strncat(table_trace, #name_, sizeof(table_trace) - strlen(table_trace) - 1); \
+}
+
+TABLE_HANDLER(a)
+TABLE_HANDLER(b)
+TABLE_HANDLER(c)
+TABLE_HANDLER(d)
+
+// 密集表，主题为Event_Test ~ Event_TestReactor，Event_TestFsm没有登记
+static const eos_event_handler table_dense_handler[4] = {
+    table_a, EOS_NULL, table_b, table_a,
+};
+static const eos_reactor_table_t table_dense = {
+    EOS_NULL, table_dense_handler, table_d, Event_Test, 4
+};
+
+// 散列表，大小为4，由eos_reactor_table_add填入
+static eos_topic_t table_hash_topic[4];
+static eos_event_handler table_hash_handler[4];
+static const eos_reactor_table_t table_hash = {
+    table_hash_topic, table_hash_handler, EOS_NULL, 0, 4
+};
+
+/* unit test ---------------------------------------------------------------- */
+#if (EOS_USE_PUB_SUB != 0)
+static eos_mcu_t sub_table[Event_Max];
+#endif
+static eos_reactor_t reactor[2];
+
+// 发布事件并执行，检查调用的处理函数。
+static void table_dispatch(eos_topic_t topic, const char *trace)
+{
+    table_trace[0] = 0;
+    eos_event_pub_topic(topic);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    TEST_ASSERT_EQUAL_STRING(trace, table_trace);
+}
+
+static void table_start(eos_reactor_t *me, eos_reactor_table_t const *table)
+{
+    eos_set_time(0);
+    eos_init();
+#if (EOS_USE_PUB_SUB != 0)
+    eos_sub_init(sub_table, Event_Max);
+#endif
+    eos_reactor_init(me, 0, EOS_NULL);
+    eos_reactor_start_table(me, table);
+#if (EOS_USE_PUB_SUB != 0)
+    for (eos_topic_t topic = Event_Test; topic < Event_Max; topic ++) {
+        eos_event_sub(&me->super, topic);
+    }
+#endif
+}
+#endif
+
+void eos_test_reactor_table(void)
+{
+#if (EOS_USE_REACTOR_TABLE != 0)
+    // 密集表，没有登记与范围之外的主题交给默认的处理函数 -------------------------
+    table_start(&reactor[0], &table_dense);
+    table_dispatch(Event_Test, "a");
+    table_dispatch(Event_TestHsm, "b");
+    table_dispatch(Event_TestReactor, "a");
+    table_dispatch(Event_TestFsm, "d");
+    table_dispatch(Event_Timeout, "d");
+
+    // 散列表，冲突时线性探测，没有默认的处理函数时忽略 ---------------------------
+    for (eos_u32_t i = 0; i < 4; i ++) {
+        table_hash_topic[i] = Event_Null;
+    }
+    eos_reactor_table_add(table_hash_topic, table_hash_handler, 4, Event_Test, table_a);
+    eos_reactor_table_add(table_hash_topic, table_hash_handler, 4, Event_Test + 4, table_b);
+    eos_reactor_table_add(table_hash_topic, table_hash_handler, 4, Event_Test + 8, table_c);
+    TEST_ASSERT_EQUAL_UINT32(Event_Test, table_hash_topic[Event_Test & 3]);
+    TEST_ASSERT_EQUAL_UINT32(Event_Test + 4, table_hash_topic[(Event_Test + 1) & 3]);
+    TEST_ASSERT_EQUAL_UINT32(Event_Test + 8, table_hash_topic[(Event_Test + 2) & 3]);
+    table_start(&reactor[1], &table_hash);
+    table_dispatch(Event_Test, "a");
+    table_dispatch(Event_Test + 4, "b");
+    table_dispatch(Event_Test + 8, "c");
+    table_dispatch(Event_TestFsm, "");
+    // 已登记的主题替换处理函数，填满之后查找没有登记的主题仍会结束
+    eos_reactor_table_add(table_hash_topic, table_hash_handler, 4, Event_Test + 4, table_d);
+    eos_reactor_table_add(table_hash_topic, table_hash_handler, 4, Event_Test + 3, table_a);
+    table_dispatch(Event_Test + 4, "d");
+    table_dispatch(Event_Test + 3, "a");
+    table_dispatch(Event_Test + 7, "");
+#endif
+}
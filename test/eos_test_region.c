@@ -0,0 +1,174 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_test.h"
+#include "eos_test_def.h"
+#include "event_def.h"
+#include "unity.h"
+#include "unity_pack.h"
+#include <string.h>
+
+#if (EOS_USE_SM_REGION != 0)
+/* data --------------------------------------------------------------------- */
+// 三个正交区域：
+// 0号区域：a <-Event_Test-> b
+// 1号区域：a --Event_TestFsm--> b --Event_Test--> a，a中的Event_Test为内部转移
+// 2号区域：只有一个与其他区域共用的状态shared，处理Event_TestHsm
+// 进入与退出记为"+区域状态"与"-区域状态"，内部转移记为"!区域"。
+static char region_trace[128];
+
+static void region_log(eos_sm_t * const me, char action, const char *name)
+{
+    char text[8] = { action, (char)('0' + eos_sm_region(me)), 0 };
+    strncat(region_trace, text, sizeof(region_trace) - strlen(region_trace) - 1);
+    strncat(region_trace, name, sizeof(region_trace) - strlen(region_trace) - 1);
+}
+
+#define REGION_ENTER_EXIT(name_)                                               \
+    if (e->topic == Event_Enter) {                                             \
+        region_log(me, '+', name_);                                            \
+        return EOS_Ret_Handled;                                                \
+    }                                                                          \
+    if (e->topic == Event_Exit) {                                              \
+        region_log(me, '-', name_);                                            \
+        return EOS_Ret_Handled;                                                \
+    }
+
+static eos_ret_t region0_a(eos_sm_t * const me, eos_event_t const * const e);
+static eos_ret_t region0_b(eos_sm_t * const me, eos_event_t const * const e);
+static eos_ret_t region1_a(eos_sm_t * const me, eos_event_t const * const e);
+static eos_ret_t region1_b(eos_sm_t * const me, eos_event_t const * const e);
+static eos_ret_t region_shared(eos_sm_t * const me, eos_event_t const * const e);
+
+/* state function ----------------------------------------------------------- */
+static eos_ret_t region0_init(eos_sm_t * const me, eos_event_t const * const e)
+{
+    (void)e;
+
+    return EOS_TRAN(region0_a);
+}
+
+static eos_ret_t region1_init(eos_sm_t * const me, eos_event_t const * const e)
+{
+    (void)e;
+
+    return EOS_TRAN(region1_a);
+}
+
+static eos_ret_t region_shared_init(eos_sm_t * const me, eos_event_t const * const e)
+{
+    (void)e;
+
+    return EOS_TRAN(region_shared);
+}
+
+static eos_ret_t region0_a(eos_sm_t * const me, eos_event_t const * const e)
+{
+    REGION_ENTER_EXIT("a")
+    if (e->topic == Event_Test)
+        return EOS_TRAN(region0_b);
+
+    return EOS_SUPER(eos_state_top);
+}
+
+static eos_ret_t region0_b(eos_sm_t * const me, eos_event_t const * const e)
+{
+    REGION_ENTER_EXIT("b")
+    if (e->topic == Event_Test)
+        return EOS_TRAN(region0_a);
+
+    return EOS_SUPER(eos_state_top);
+}
+
+static eos_ret_t region1_a(eos_sm_t * const me, eos_event_t const * const e)
+{
+    REGION_ENTER_EXIT("a")
+    if (e->topic == Event_TestFsm)
+        return EOS_TRAN(region1_b);
+    if (e->topic == Event_Test) {
+        region_log(me, '!', "");
+        return EOS_Ret_Handled;
+    }
+
+    return EOS_SUPER(eos_state_top);
+}
+
+static eos_ret_t region1_b(eos_sm_t * const me, eos_event_t const * const e)
+{
+    REGION_ENTER_EXIT("b")
+    if (e->topic == Event_Test)
+        return EOS_TRAN(region1_a);
+
+    return EOS_SUPER(eos_state_top);
+}
+
+static eos_ret_t region_shared(eos_sm_t * const me, eos_event_t const * const e)
+{
+    REGION_ENTER_EXIT("s")
+    if (e->topic == Event_TestHsm) {
+        region_log(me, '!', "");
+        return EOS_Ret_Handled;
+    }
+
+    return EOS_SUPER(eos_state_top);
+}
+
+/* unit test ---------------------------------------------------------------- */
+#if (EOS_USE_PUB_SUB != 0)
+static eos_mcu_t sub_table[Event_Max];
+#endif
+static eos_sm_t region_sm;
+static eos_region_t region[2];
+
+// 发布事件，一次调度即交给所有区域，检查各区域的退出与进入顺序。
+static void region_dispatch(eos_topic_t topic, const char *trace)
+{
+    region_trace[0] = 0;
+    eos_event_pub_topic(topic);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    TEST_ASSERT_EQUAL_STRING(trace, region_trace);
+    TEST_ASSERT_EQUAL_UINT8(0, eos_sm_region(&region_sm));
+}
+#endif
+
+void eos_test_region(void)
+{
+#if (EOS_USE_SM_REGION != 0)
+    eos_set_time(0);
+    eos_init();
+#if (EOS_USE_PUB_SUB != 0)
+    eos_sub_init(sub_table, Event_Max);
+#endif
+
+    // 各区域分别启动，未启动的区域不处理事件 --------------------------------------
+    region_trace[0] = 0;
+    eos_sm_init(&region_sm, 0, EOS_NULL);
+    eos_sm_region_init(&region_sm, region, 2);
+    eos_sm_start(&region_sm, region0_init);
+    eos_sm_region_start(&region_sm, 1, region1_init);
+    TEST_ASSERT_EQUAL_STRING("+0a+1a", region_trace);
+    TEST_ASSERT_EQUAL_PTR(region0_a, region_sm.state);
+    TEST_ASSERT_EQUAL_PTR(region1_a, region[0].state);
+    TEST_ASSERT_NULL(region[1].state);
+#if (EOS_USE_PUB_SUB != 0)
+    eos_event_sub(&region_sm.super, Event_Test);
+    eos_event_sub(&region_sm.super, Event_TestFsm);
+    eos_event_sub(&region_sm.super, Event_TestHsm);
+#endif
+
+    // 同一个事件依次交给各区域，各区域独立转移 ------------------------------------
+    region_dispatch(Event_Test, "-0a+0b!1");
+    region_dispatch(Event_TestFsm, "-1a+1b");
+    TEST_ASSERT_EQUAL_PTR(region0_b, region_sm.state);
+    TEST_ASSERT_EQUAL_PTR(region1_b, region[0].state);
+
+    // 共用的状态函数由eos_sm_region区分区域 ---------------------------------------
+    region_trace[0] = 0;
+    eos_sm_region_start(&region_sm, 2, region_shared_init);
+    TEST_ASSERT_EQUAL_STRING("+2s", region_trace);
+    region_dispatch(Event_TestHsm, "!2");
+    region_dispatch(Event_Test, "-0b+0a-1b+1a");
+    TEST_ASSERT_EQUAL_PTR(region0_a, region_sm.state);
+    TEST_ASSERT_EQUAL_PTR(region1_a, region[0].state);
+    TEST_ASSERT_EQUAL_PTR(region_shared, region[1].state);
+#endif
+}
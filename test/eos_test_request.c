@@ -0,0 +1,165 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_test.h"
+#include "eos_test_def.h"
+#include "event_def.h"
+#include "unity.h"
+#include "unity_pack.h"
+
+#if (EOS_USE_REQUEST != 0)
+/* actors for test ---------------------------------------------------------- */
+typedef struct req_reactor {
+    eos_reactor_t super;
+    eos_topic_t topic;
+    eos_u16_t id;
+    eos_u32_t count;
+    eos_u32_t data;
+} req_reactor_t;
+
+static void server_func(req_reactor_t * const me, eos_event_t const * const e)
+{
+    // 仅记录请求的关联ID，回复由测试代码发出。
+    me->topic = e->topic;
+    me->id = e->id;
+    me->count ++;
+}
+
+static void client_func(req_reactor_t * const me, eos_event_t const * const e)
+{
+    me->topic = e->topic;
+    me->id = e->id;
+    me->count ++;
+    if (e->size == sizeof(eos_u32_t)) {
+        me->data = *((eos_u32_t *)e->data);
+    }
+}
+
+/* unit test ---------------------------------------------------------------- */
+#if (EOS_USE_PUB_SUB != 0)
+static eos_mcu_t sub_table[Event_Max];
+#endif
+static req_reactor_t server, client;
+static eos_t *f;
+#endif
+
+void eos_test_request(void)
+{
+#if (EOS_USE_REQUEST != 0)
+    f = eos_get_framework();
+    eos_set_time(0);
+
+    eos_init();
+#if (EOS_USE_PUB_SUB != 0)
+    eos_sub_init(sub_table, Event_Max);
+#endif
+    eos_reactor_init(&server.super, 1, EOS_NULL);
+    eos_reactor_start(&server.super, EOS_HANDLER_CAST(server_func));
+    eos_reactor_init(&client.super, 2, EOS_NULL);
+    eos_reactor_start(&client.super, EOS_HANDLER_CAST(client_func));
+
+    // 无人订阅请求主题时，请求失败，且不占用请求表
+    TEST_ASSERT_EQUAL_UINT16(0, eos_request(&client.super.super, Event_Request,
+                                            EOS_NULL, 0, Event_Timeout, 100));
+    TEST_ASSERT_EQUAL_UINT8(0, f->request_count);
+#if (EOS_USE_PUB_SUB != 0)
+    eos_event_sub(&server.super.super, Event_Request);
+#endif
+
+    // 请求与回复 ---------------------------------------------------------------
+    eos_u32_t data = 0x12345678;
+    eos_u16_t id = eos_request(&client.super.super, Event_Request,
+                               EOS_NULL, 0, Event_Timeout, 100);
+    TEST_ASSERT_NOT_EQUAL(0, id);
+    TEST_ASSERT_EQUAL_UINT8(1, f->request_count);
+    TEST_ASSERT_EQUAL_UINT32(100, f->request_timeout_min);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_UINT32(1, server.count);
+    TEST_ASSERT_EQUAL_UINT16(Event_Request, server.topic);
+    TEST_ASSERT_EQUAL_UINT16(id, server.id);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+
+    // 回复直接送达请求者，请求者无需订阅回复主题
+    TEST_ASSERT_EQUAL_UINT8(EOS_True, eos_reply(id, Event_Reply, &data, sizeof(data)));
+    TEST_ASSERT_EQUAL_UINT8(0, f->request_count);
+    TEST_ASSERT_EQUAL_UINT32(EOS_U32_MAX, f->request_timeout_min);
+    TEST_ASSERT_EQUAL_UINT32((1 << 2), f->heap.sub_general);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_UINT32(1, client.count);
+    TEST_ASSERT_EQUAL_UINT16(Event_Reply, client.topic);
+    TEST_ASSERT_EQUAL_UINT16(id, client.id);
+    TEST_ASSERT_EQUAL_UINT32(data, client.data);
+    TEST_ASSERT_EQUAL_UINT32(1, server.count);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+
+    // 重复回复无效
+    TEST_ASSERT_EQUAL_UINT8(EOS_False, eos_reply(id, Event_Reply, EOS_NULL, 0));
+    TEST_ASSERT_EQUAL_UINT8(EOS_False, eos_reply(0, Event_Reply, EOS_NULL, 0));
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+
+    // 请求超时 -----------------------------------------------------------------
+    id = eos_request(&client.super.super, Event_Request, EOS_NULL, 0, Event_Timeout, 100);
+    TEST_ASSERT_NOT_EQUAL(0, id);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_UINT32(2, server.count);
+    for (int i = 1; i < 100; i ++) {
+        eos_set_time(i);
+        TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    }
+    eos_set_time(100);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_UINT8(0, f->request_count);
+    TEST_ASSERT_EQUAL_UINT32(2, client.count);
+    TEST_ASSERT_EQUAL_UINT16(Event_Timeout, client.topic);
+    TEST_ASSERT_EQUAL_UINT16(id, client.id);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    // 超时后的回复被丢弃
+    TEST_ASSERT_EQUAL_UINT8(EOS_False, eos_reply(id, Event_Reply, EOS_NULL, 0));
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+
+    // 取消请求
+    id = eos_request(&client.super.super, Event_Request, EOS_NULL, 0, Event_Timeout, 100);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    eos_request_cancel(id);
+    TEST_ASSERT_EQUAL_UINT8(0, f->request_count);
+    eos_set_time(300);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    TEST_ASSERT_EQUAL_UINT8(EOS_False, eos_reply(id, Event_Reply, EOS_NULL, 0));
+
+    // 请求表满 -----------------------------------------------------------------
+    eos_u16_t ids[EOS_MAX_REQUEST];
+    server.count = 0;
+    client.count = 0;
+    for (int i = 0; i < EOS_MAX_REQUEST; i ++) {
+        ids[i] = eos_request(&client.super.super, Event_Request,
+                             EOS_NULL, 0, Event_Timeout, (100 + i));
+        TEST_ASSERT_NOT_EQUAL(0, ids[i]);
+        for (int j = 0; j < i; j ++) {
+            TEST_ASSERT_NOT_EQUAL(ids[j], ids[i]);
+        }
+        TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    }
+    TEST_ASSERT_EQUAL_UINT8(EOS_MAX_REQUEST, f->request_count);
+    TEST_ASSERT_EQUAL_UINT16(0, eos_request(&client.super.super, Event_Request,
+                                            EOS_NULL, 0, Event_Timeout, 100));
+    TEST_ASSERT_EQUAL_UINT32(EOS_MAX_REQUEST, server.count);
+    TEST_ASSERT_EQUAL_UINT32(400, f->request_timeout_min);
+
+    // 乱序回复一半，其余的超时
+    for (int i = 0; i < EOS_MAX_REQUEST; i += 2) {
+        TEST_ASSERT_EQUAL_UINT8(EOS_True, eos_reply(ids[i], Event_Reply, EOS_NULL, 0));
+        TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+        TEST_ASSERT_EQUAL_UINT16(Event_Reply, client.topic);
+        TEST_ASSERT_EQUAL_UINT16(ids[i], client.id);
+    }
+    TEST_ASSERT_EQUAL_UINT8((EOS_MAX_REQUEST / 2), f->request_count);
+    eos_set_time(300 + 100 + EOS_MAX_REQUEST);
+    for (int i = 1; i < EOS_MAX_REQUEST; i += 2) {
+        TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+        TEST_ASSERT_EQUAL_UINT16(Event_Timeout, client.topic);
+        TEST_ASSERT_EQUAL_UINT16(ids[i], client.id);
+    }
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    TEST_ASSERT_EQUAL_UINT32(EOS_MAX_REQUEST, client.count);
+    TEST_ASSERT_EQUAL_UINT8(0, f->request_count);
+    TEST_ASSERT_EQUAL_UINT32(EOS_U32_MAX, f->request_timeout_min);
+#endif
+}
@@ -0,0 +1,210 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_test.h"
+#include "eos_test_def.h"
+#include "event_def.h"
+#include "unity.h"
+#include "unity_pack.h"
+#include <string.h>
+
+#if (EOS_USE_STATE_SUB != 0 && (EOS_USE_SM_DESC != 0 || EOS_USE_SM_TABLE != 0))
+/* data --------------------------------------------------------------------- */
+static eos_mcu_t sub_table[Event_Max];
+static char state_sub_trace[64];
+
+static void state_sub_log(const char *text)
+{
+    strncat(state_sub_trace, text, sizeof(state_sub_trace) - strlen(state_sub_trace) - 1);
+}
+
+// 检查Actor对主题的订阅
+static void state_sub_check(eos_actor_t *actor, eos_topic_t topic, eos_bool_t sub)
+{
+    eos_mcu_t bit = (eos_mcu_t)(1 << actor->priority);
+
+    TEST_ASSERT_EQUAL_UINT32((sub == EOS_True) ? bit : 0, sub_table[topic] & bit);
+}
+
+// 发布事件并执行，检查处理的结果。
+static void state_sub_dispatch(eos_topic_t topic, const char *trace)
+{
+    state_sub_trace[0] = 0;
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_event_pub_ret(topic, EOS_NULL, 0));
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    TEST_ASSERT_EQUAL_STRING(trace, state_sub_trace);
+}
+#endif
+
+#if (EOS_USE_STATE_SUB != 0 && EOS_USE_SM_DESC != 0)
+// p ─┬─ a    p处理Test；a处理TestFsm（转移到b）与Test（先于p处理）
+//    └─ b    b处理TestHsm（转移到a）
+static eos_ret_t dsm_p(eos_dsm_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    if (e->topic == Event_Test) {
+        state_sub_log("!p");
+        return EOS_Ret_Handled;
+    }
+
+    return EOS_Ret_Null;
+}
+
+static const eos_state_t state_a;
+static const eos_state_t state_b;
+
+static eos_ret_t dsm_a(eos_dsm_t * const me, eos_event_t const * const e)
+{
+    if (e->topic == Event_TestFsm) {
+        state_sub_log("!a");
+        return EOS_DSM_TRAN(state_b);
+    }
+    if (e->topic == Event_Test) {
+        state_sub_log("!a");
+        return EOS_Ret_Handled;
+    }
+
+    return EOS_Ret_Null;
+}
+
+static eos_ret_t dsm_b(eos_dsm_t * const me, eos_event_t const * const e)
+{
+    if (e->topic == Event_TestHsm) {
+        state_sub_log("!b");
+        return EOS_DSM_TRAN(state_a);
+    }
+
+    return EOS_Ret_Null;
+}
+
+static const eos_topic_t topics_p[] = { Event_Test };
+static const eos_topic_t topics_a[] = { Event_TestFsm, Event_Test };
+static const eos_topic_t topics_b[] = { Event_TestHsm };
+
+static const eos_state_t state_p = {
+    EOS_NULL, &state_a, EOS_NULL, EOS_NULL, dsm_p, topics_p, 1
+};
+static const eos_state_t state_a = {
+    &state_p, EOS_NULL, EOS_NULL, EOS_NULL, dsm_a, topics_a, 2
+};
+static const eos_state_t state_b = {
+    &state_p, EOS_NULL, EOS_NULL, EOS_NULL, dsm_b, topics_b, 1
+};
+
+static eos_dsm_t dsm;
+
+static void state_sub_dsm(void)
+{
+    eos_set_time(0);
+    eos_init();
+    eos_sub_init(sub_table, Event_Max);
+
+    // 进入p与a，只订阅二者处理的主题 ------------------------------------------
+    eos_dsm_init(&dsm, 0, EOS_NULL);
+    eos_dsm_start(&dsm, &state_p);
+    TEST_ASSERT_EQUAL_PTR(&state_a, dsm.state);
+    state_sub_check(&dsm.super, Event_Test, EOS_True);
+    state_sub_check(&dsm.super, Event_TestFsm, EOS_True);
+    state_sub_check(&dsm.super, Event_TestHsm, EOS_False);
+    // 当前状态不处理的事件不进入队列
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoActorSub, eos_event_pub_ret(Event_TestHsm, EOS_NULL, 0));
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    state_sub_dispatch(Event_Test, "!a");
+
+    // 转移到b，退出a时取消订阅，p仍订阅与a共同处理的Test -----------------------
+    state_sub_dispatch(Event_TestFsm, "!a");
+    TEST_ASSERT_EQUAL_PTR(&state_b, dsm.state);
+    state_sub_check(&dsm.super, Event_Test, EOS_True);
+    state_sub_check(&dsm.super, Event_TestFsm, EOS_False);
+    state_sub_check(&dsm.super, Event_TestHsm, EOS_True);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoActorSub, eos_event_pub_ret(Event_TestFsm, EOS_NULL, 0));
+    state_sub_dispatch(Event_Test, "!p");
+
+    // 转移之前已进入队列的事件，转移后被丢弃 -----------------------------------
+    state_sub_dispatch(Event_TestHsm, "!b");
+    TEST_ASSERT_EQUAL_PTR(&state_a, dsm.state);
+    state_sub_trace[0] = 0;
+    eos_event_pub_topic(Event_TestFsm);
+    eos_event_pub_topic(Event_TestFsm);
+    eos_once();
+    eos_once();
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    TEST_ASSERT_EQUAL_STRING("!a", state_sub_trace);
+    TEST_ASSERT_EQUAL_PTR(&state_b, dsm.state);
+}
+#endif
+
+#if (EOS_USE_STATE_SUB != 0 && EOS_USE_SM_TABLE != 0)
+// X --Test--> Y --TestFsm--> X，Y中的TestHsm为内部转移，主题为Event_Test ~ Event_TestHsm。
+enum {
+    Tsm_X = 0,
+    Tsm_Y,
+
+    Tsm_Max
+};
+
+static void tsm_action(eos_tsm_t * const me, eos_event_t const * const e)
+{
+    (void)e;
+    state_sub_log((me->state == Tsm_X) ? "!x" : "!y");
+}
+
+#define N                                   EOS_TSM_NONE
+static const eos_u8_t tsm_next[Tsm_Max * 3] = {
+    Tsm_Y, N,     N,
+    N,     Tsm_X, Tsm_Y,
+};
+static const eos_tsm_action tsm_action_table[Tsm_Max * 3] = {
+    tsm_action, EOS_NULL,   EOS_NULL,
+    EOS_NULL,   tsm_action, tsm_action,
+};
+#undef N
+static const eos_u32_t tsm_sub_map[Tsm_Max] = {
+    0x01, 0x06,
+};
+static const eos_tsm_table_t tsm_table = {
+    tsm_next, tsm_action_table, EOS_NULL, EOS_NULL, EOS_NULL, EOS_NULL,
+    Tsm_Max * 3, Tsm_Max, Event_Test, 3, tsm_sub_map
+};
+
+static eos_tsm_t tsm;
+
+static void state_sub_tsm(void)
+{
+    eos_set_time(0);
+    eos_init();
+    eos_sub_init(sub_table, Event_Max);
+
+    // 只订阅当前状态的非空表项 --------------------------------------------------
+    eos_tsm_init(&tsm, 0, EOS_NULL);
+    eos_tsm_start(&tsm, &tsm_table, Tsm_X);
+    state_sub_check(&tsm.super, Event_Test, EOS_True);
+    state_sub_check(&tsm.super, Event_TestFsm, EOS_False);
+    state_sub_check(&tsm.super, Event_TestHsm, EOS_False);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoActorSub, eos_event_pub_ret(Event_TestHsm, EOS_NULL, 0));
+
+    // 转移时更新订阅，内部转移不改变订阅 ----------------------------------------
+    state_sub_dispatch(Event_Test, "!x");
+    TEST_ASSERT_EQUAL_UINT8(Tsm_Y, tsm.state);
+    state_sub_check(&tsm.super, Event_Test, EOS_False);
+    state_sub_check(&tsm.super, Event_TestFsm, EOS_True);
+    state_sub_check(&tsm.super, Event_TestHsm, EOS_True);
+    state_sub_dispatch(Event_TestHsm, "!y");
+    state_sub_check(&tsm.super, Event_TestHsm, EOS_True);
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoActorSub, eos_event_pub_ret(Event_Test, EOS_NULL, 0));
+    state_sub_dispatch(Event_TestFsm, "!y");
+    TEST_ASSERT_EQUAL_UINT8(Tsm_X, tsm.state);
+    state_sub_check(&tsm.super, Event_Test, EOS_True);
+    state_sub_check(&tsm.super, Event_TestFsm, EOS_False);
+    state_sub_check(&tsm.super, Event_TestHsm, EOS_False);
+}
+#endif
+
+void eos_test_state_sub(void)
+{
+#if (EOS_USE_STATE_SUB != 0 && EOS_USE_SM_DESC != 0)
+    state_sub_dsm();
+#endif
+#if (EOS_USE_STATE_SUB != 0 && EOS_USE_SM_TABLE != 0)
+    state_sub_tsm();
+#endif
+}
@@ -0,0 +1,338 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_test.h"
+#include "eos_test_def.h"
+#include "event_def.h"
+#include "unity.h"
+#include "unity_pack.h"
+
+#if (EOS_USE_TIMER_HANDLE != 0)
+/* actors for test ---------------------------------------------------------- */
+static eos_u32_t timer_count[2];
+static eos_u32_t timer_value;
+
+static void timer_func(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    timer_count[e->topic - Event_Time_500ms] ++;
+    timer_value = (e->size == sizeof(eos_u32_t)) ? *((eos_u32_t *)e->data) : 0;
+}
+
+/* unit test ---------------------------------------------------------------- */
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+static eos_u32_t data_count[2];
+static eos_u32_t data_value[2];
+static void const *data_pointer[2];
+
+static void data_func(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    eos_u32_t index = me->super.priority - 1;
+    data_count[index] ++;
+    data_pointer[index] = e->data;
+    data_value[index] = (e->size == sizeof(eos_u32_t)) ? *((eos_u32_t *)e->data) : 0;
+}
+#endif
+
+#if (EOS_USE_PUB_SUB != 0)
+static eos_mcu_t sub_table[Event_Max];
+#endif
+static eos_reactor_t timer_reactor;
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+static eos_reactor_t data_reactor[2];
+#endif
+static eos_t *f;
+
+// 推进时间，执行所有事件。
+static void timer_run(eos_u32_t time_ms)
+{
+    eos_tick_advance(time_ms);
+    while (eos_once() == EosRun_OK) {
+    }
+}
+#endif
+
+void eos_test_timer(void)
+{
+#if (EOS_USE_TIMER_HANDLE != 0)
+    f = eos_get_framework();
+    eos_set_time(0);
+
+    eos_init();
+#if (EOS_USE_PUB_SUB != 0)
+    eos_sub_init(sub_table, Event_Max);
+#endif
+    eos_reactor_init(&timer_reactor, 0, EOS_NULL);
+    eos_reactor_start(&timer_reactor, timer_func);
+#if (EOS_USE_PUB_SUB != 0)
+    eos_event_sub(&timer_reactor.super, Event_Time_500ms);
+    eos_event_sub(&timer_reactor.super, Event_Time_2000ms);
+#endif
+
+    // 同一主题上的多个延时事件，各自到期 -------------------------------------
+    eos_timer_t timer[4];
+    timer[0] = eos_timer_delay(Event_Time_500ms, 100);
+    timer[1] = eos_timer_delay(Event_Time_500ms, 200);
+    timer[2] = eos_timer_delay(Event_Time_500ms, 300);
+    TEST_ASSERT_EQUAL_UINT16(3, f->timer_count);
+    TEST_ASSERT_TRUE(timer[0] != 0 && timer[0] != timer[1] && timer[1] != timer[2]);
+    timer_run(100);
+    TEST_ASSERT_EQUAL_UINT32(1, timer_count[0]);
+    TEST_ASSERT_EQUAL_UINT16(2, f->timer_count);
+    // 已到期的句柄失效，取消与重新计时都不影响其他定时器
+    eos_timer_cancel(timer[0]);
+    TEST_ASSERT_FALSE(eos_timer_restart(timer[0], 100));
+    TEST_ASSERT_EQUAL_UINT16(2, f->timer_count);
+    // 按句柄取消其中一个
+    eos_timer_cancel(timer[1]);
+    TEST_ASSERT_EQUAL_UINT16(1, f->timer_count);
+    timer_run(100);
+    TEST_ASSERT_EQUAL_UINT32(1, timer_count[0]);
+    timer_run(100);
+    TEST_ASSERT_EQUAL_UINT32(2, timer_count[0]);
+    TEST_ASSERT_EQUAL_UINT16(0, f->timer_count);
+
+    // 看门狗，不断重新计时，直至停止喂狗 ---------------------------------------
+    timer_count[0] = 0;
+    timer[0] = eos_timer_delay(Event_Time_500ms, 100);
+    for (eos_u32_t i = 0; i < 10; i ++) {
+        timer_run(90);
+        TEST_ASSERT_TRUE(eos_timer_restart(timer[0], 100));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, timer_count[0]);
+    timer_run(99);
+    TEST_ASSERT_EQUAL_UINT32(0, timer_count[0]);
+    timer_run(1);
+    TEST_ASSERT_EQUAL_UINT32(1, timer_count[0]);
+    TEST_ASSERT_FALSE(eos_timer_restart(timer[0], 100));
+
+    // 删除时最后一个定时器会移动位置，其句柄仍然有效 ---------------------------
+    timer_count[0] = 0;
+    timer_count[1] = 0;
+    timer[0] = eos_timer_delay(Event_Time_500ms, 100);
+    timer[1] = eos_timer_period(Event_Time_2000ms, 50);
+    timer[2] = eos_timer_delay(Event_Time_500ms, 300);
+    timer[3] = eos_timer_delay(Event_Time_500ms, 400);
+    eos_timer_cancel(timer[0]);
+    eos_timer_cancel(timer[0]);
+    TEST_ASSERT_EQUAL_UINT16(3, f->timer_count);
+    TEST_ASSERT_EQUAL_UINT16((timer[3] & 0xffff), f->etimer[0].id);
+    eos_timer_cancel(timer[3]);
+    TEST_ASSERT_TRUE(eos_timer_restart(timer[1], 100));
+    TEST_ASSERT_EQUAL_UINT16(2, f->timer_count);
+    timer_run(300);
+    TEST_ASSERT_EQUAL_UINT32(1, timer_count[0]);
+    TEST_ASSERT_EQUAL_UINT32(3, timer_count[1]);
+    TEST_ASSERT_EQUAL_UINT16(1, f->timer_count);
+    // 按主题取消该主题的所有时间事件
+    timer[0] = eos_timer_delay(Event_Time_2000ms, 100);
+    TEST_ASSERT_EQUAL_UINT16(2, f->timer_count);
+    eos_event_time_cancel(Event_Time_2000ms);
+    TEST_ASSERT_EQUAL_UINT16(0, f->timer_count);
+    TEST_ASSERT_FALSE(eos_timer_restart(timer[0], 100));
+    TEST_ASSERT_FALSE(eos_timer_restart(timer[1], 100));
+
+    // 句柄用尽所有的定时器，再全部取消 ---------------------------------------
+    static eos_timer_t timer_all[EOS_MAX_TIME_EVENT];
+    for (eos_u32_t i = 0; i < EOS_MAX_TIME_EVENT; i ++) {
+        timer_all[i] = eos_timer_delay(Event_Time_500ms, 1000 + i);
+    }
+    TEST_ASSERT_EQUAL_UINT16(EOS_MAX_TIME_EVENT, f->timer_count);
+    for (eos_u32_t i = 0; i < EOS_MAX_TIME_EVENT; i += 2) {
+        eos_timer_cancel(timer_all[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT16(EOS_MAX_TIME_EVENT / 2, f->timer_count);
+    timer_count[0] = 0;
+    timer_run(999);
+    for (eos_u32_t i = 0; i < EOS_MAX_TIME_EVENT; i ++) {
+        timer_run(1);
+        TEST_ASSERT_EQUAL_UINT32(((i + 1) / 2), timer_count[0]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(EOS_MAX_TIME_EVENT / 2, timer_count[0]);
+    TEST_ASSERT_EQUAL_UINT16(0, f->timer_count);
+
+#if (EOS_USE_TIMER_EXACT != 0)
+    // 精确的周期，不按时间单位（60秒以上为100毫秒）量化 -------------------------
+    timer_count[0] = 0;
+    timer[0] = eos_timer_period(Event_Time_500ms, 61234);
+    timer_run(61233);
+    TEST_ASSERT_EQUAL_UINT32(0, timer_count[0]);
+    timer_run(1);
+    TEST_ASSERT_EQUAL_UINT32(1, timer_count[0]);
+    timer_run(61233);
+    TEST_ASSERT_EQUAL_UINT32(1, timer_count[0]);
+    timer_run(1);
+    TEST_ASSERT_EQUAL_UINT32(2, timer_count[0]);
+    eos_timer_cancel(timer[0]);
+
+    // 追赶策略，截止时刻为10ms，35ms时才得到处理 -------------------------------
+    static const eos_u8_t catchup[3] = {
+        EosTimerCatchUp_All, EosTimerCatchUp_Skip, EosTimerCatchUp_Coalesce
+    };
+    static const eos_u32_t catchup_count[3] = { 3, 1, 1 };
+    static const eos_u32_t catchup_value[3] = { 0, 0, 3 };
+    static const eos_u32_t catchup_missed[3] = { 0, 2, 2 };
+    eos_timer_stats_t stats;
+    for (eos_u32_t i = 0; i < 3; i ++) {
+        timer_count[0] = 0;
+        timer_value = 0;
+        timer[0] = eos_timer_period(Event_Time_500ms, 10);
+        TEST_ASSERT_TRUE(eos_timer_set_catchup(timer[0], catchup[i]));
+        timer_run(35);
+        TEST_ASSERT_EQUAL_UINT32(catchup_count[i], timer_count[0]);
+        TEST_ASSERT_EQUAL_UINT32(catchup_value[i], timer_value);
+        TEST_ASSERT_TRUE(eos_timer_stats(timer[0], &stats));
+        TEST_ASSERT_EQUAL_UINT32(1, stats.count);
+        TEST_ASSERT_EQUAL_UINT32(catchup_missed[i], stats.missed);
+        TEST_ASSERT_EQUAL_UINT32(25, stats.late_max);
+        TEST_ASSERT_EQUAL_UINT32(25, stats.late_total);
+        // 截止时刻仍然对齐到周期的整数倍
+        timer_run(4);
+        TEST_ASSERT_EQUAL_UINT32(catchup_count[i], timer_count[0]);
+        timer_run(1);
+        TEST_ASSERT_EQUAL_UINT32(catchup_count[i] + 1, timer_count[0]);
+        TEST_ASSERT_TRUE(eos_timer_stats(timer[0], &stats));
+        TEST_ASSERT_EQUAL_UINT32(2, stats.count);
+        TEST_ASSERT_EQUAL_UINT32(25, stats.late_max);
+        TEST_ASSERT_EQUAL_UINT32(25, stats.late_total);
+        eos_timer_cancel(timer[0]);
+        TEST_ASSERT_FALSE(eos_timer_stats(timer[0], &stats));
+    }
+#endif
+
+#if (EOS_USE_TIMER_SLACK != 0)
+    // 松弛量，截止时刻1010ms与1013ms的两个定时器合并到1016ms一次到期 ---------------
+    eos_set_time(1000);
+    timer_count[0] = 0;
+    timer_count[1] = 0;
+    timer[0] = eos_timer_delay(Event_Time_500ms, 10);
+    timer[1] = eos_timer_delay(Event_Time_2000ms, 13);
+    TEST_ASSERT_TRUE(eos_timer_set_slack(timer[0], 8));
+    TEST_ASSERT_TRUE(eos_timer_set_slack(timer[1], 8));
+    TEST_ASSERT_TRUE(f->timeout_min <= 1016);
+    timer_run(15);
+    TEST_ASSERT_EQUAL_UINT32(0, timer_count[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, timer_count[1]);
+    timer_run(1);
+    TEST_ASSERT_EQUAL_UINT32(1, timer_count[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, timer_count[1]);
+    TEST_ASSERT_FALSE(eos_timer_set_slack(timer[0], 8));
+
+    // 周期事件在[名义截止时刻, 名义截止时刻 + 松弛量]之内到期，名义截止时刻不漂移 ------
+    eos_set_time(1000);
+    timer_count[0] = 0;
+    timer[0] = eos_timer_period(Event_Time_500ms, 100);
+    TEST_ASSERT_TRUE(eos_timer_set_slack(timer[0], 20));
+    for (eos_u32_t i = 1; i <= 20; i ++) {
+        timer_run((eos_u32_t)(1000 + i * 100 - 1 - eos_time()));
+        TEST_ASSERT_EQUAL_UINT32(i - 1, timer_count[0]);
+        timer_run(21);
+        TEST_ASSERT_EQUAL_UINT32(i, timer_count[0]);
+    }
+    // 松弛量为0时恢复准时到期
+    TEST_ASSERT_TRUE(eos_timer_set_slack(timer[0], 0));
+    timer_run((eos_u32_t)(3100 - 1 - eos_time()));
+    TEST_ASSERT_EQUAL_UINT32(20, timer_count[0]);
+    timer_run(1);
+    TEST_ASSERT_EQUAL_UINT32(21, timer_count[0]);
+    eos_timer_cancel(timer[0]);
+
+    // 相位错开，同时启动的相同周期的定时器分布在周期之内，不再同时到期 ---------------
+    eos_set_time(0);
+    timer_count[0] = 0;
+    for (eos_u32_t i = 0; i < 4; i ++) {
+        timer[i] = eos_timer_period(Event_Time_500ms, 40);
+        TEST_ASSERT_TRUE(eos_timer_stagger(timer[i]));
+    }
+    for (eos_u32_t i = 0; i < 80; i ++) {
+        eos_u32_t count = timer_count[0];
+        timer_run(1);
+        TEST_ASSERT_TRUE(timer_count[0] - count <= 1);
+        TEST_ASSERT_TRUE(timer_count[0] >= ((i + 1) / 40) * 4);
+    }
+    TEST_ASSERT_EQUAL_UINT32(8, timer_count[0]);
+    for (eos_u32_t i = 0; i < 4; i ++) {
+        eos_timer_cancel(timer[i]);
+    }
+    TEST_ASSERT_FALSE(eos_timer_stagger(timer[0]));
+#endif
+
+#if (EOS_USE_TIMER_PAYLOAD != 0)
+    // 携带数据的时间事件 -------------------------------------------------------
+    for (eos_u32_t i = 0; i < 2; i ++) {
+        eos_reactor_init(&data_reactor[i], (i + 1), EOS_NULL);
+        eos_reactor_start(&data_reactor[i], data_func);
+#if (EOS_USE_PUB_SUB != 0)
+        eos_event_sub(&data_reactor[i].super, Event_TestReactor);
+#endif
+    }
+    eos_u32_t heap_count = f->heap.count;
+    eos_u32_t value = 0x12345678;
+
+    // 数据在启动时存入事件堆，发布给所有订阅者，到期时不再申请内存
+    timer[0] = eos_timer_delay_data(EOS_NULL, Event_TestReactor, 100, &value, sizeof(value));
+    TEST_ASSERT_TRUE(timer[0] != 0);
+    value = 0;
+    TEST_ASSERT_EQUAL_UINT32(heap_count + 1, f->heap.count);
+    eos_tick_advance(100);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_UINT32(heap_count + 1, f->heap.count);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    TEST_ASSERT_EQUAL_UINT32(1, data_count[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, data_count[1]);
+    TEST_ASSERT_EQUAL_HEX32(0x12345678, data_value[0]);
+    TEST_ASSERT_EQUAL_HEX32(0x12345678, data_value[1]);
+    TEST_ASSERT_EQUAL_PTR(data_pointer[0], data_pointer[1]);
+    TEST_ASSERT_EQUAL_UINT32(heap_count, f->heap.count);
+
+    // 定向发送给一个Actor，即使它没有订阅该主题
+    value = 1;
+    timer[0] = eos_timer_delay_data(&data_reactor[0].super, Event_TestReactor, 100,
+                                    &value, sizeof(value));
+    timer[1] = eos_timer_delay_data(&data_reactor[1].super, Event_Time_2000ms, 100, EOS_NULL, 0);
+    TEST_ASSERT_EQUAL_UINT32(heap_count + 1, f->heap.count);
+    timer_run(100);
+    TEST_ASSERT_EQUAL_UINT32(2, data_count[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, data_count[1]);
+    TEST_ASSERT_EQUAL_UINT32(1, data_value[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, data_value[1]);
+    TEST_ASSERT_EQUAL_UINT32(heap_count, f->heap.count);
+
+    // 周期事件每个周期投递同一个数据块
+    value = 2;
+    timer[0] = eos_timer_period_data(&data_reactor[0].super, Event_TestReactor, 10,
+                                     &value, sizeof(value));
+    timer_run(10);
+    void const *pointer = data_pointer[0];
+    timer_run(10);
+    TEST_ASSERT_EQUAL_UINT32(4, data_count[0]);
+    TEST_ASSERT_EQUAL_PTR(pointer, data_pointer[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, data_value[0]);
+    TEST_ASSERT_EQUAL_UINT32(heap_count + 1, f->heap.count);
+    // 上一次投递尚未处理时再次到期，两次合并为一次（高优先级的Actor先处理其事件）
+    eos_event_pub_topic(Event_TestReactor);
+    eos_tick_advance(10);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    eos_tick_advance(10);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    TEST_ASSERT_EQUAL_UINT32(6, data_count[0]);
+    TEST_ASSERT_EQUAL_UINT32(3, data_count[1]);
+    TEST_ASSERT_EQUAL_UINT32(2, data_value[0]);
+    // 取消后数据块释放
+    eos_timer_cancel(timer[0]);
+    TEST_ASSERT_EQUAL_UINT32(heap_count, f->heap.count);
+
+    // 到期后尚未处理时取消，事件处理完毕后再释放
+    timer[0] = eos_timer_period_data(EOS_NULL, Event_TestReactor, 10, &value, sizeof(value));
+    eos_tick_advance(10);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    eos_timer_cancel(timer[0]);
+    TEST_ASSERT_EQUAL_UINT32(heap_count + 1, f->heap.count);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_INT8(EosRun_NoEvent, eos_once());
+    TEST_ASSERT_EQUAL_UINT32(heap_count, f->heap.count);
+    TEST_ASSERT_EQUAL_UINT16(0, f->timer_count);
+#endif
+#endif
+}
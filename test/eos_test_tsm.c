@@ -0,0 +1,201 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_test.h"
+#include "eos_test_def.h"
+#include "event_def.h"
+#include "unity.h"
+#include "unity_pack.h"
+#include <string.h>
+
+#if (EOS_USE_SM_TABLE != 0)
+/* data --------------------------------------------------------------------- */
+// 一个简单的帧解析器，Idle没有进入与退出动作：
+// Idle --Test/start--> Head --TestFsm/length--> Body --TestReactor--> Tail --Request/done--> Idle
+// Head中的Time_500ms与Body中的TestHsm为计数字节的内部转移，Tail中的Time_2000ms为无动作的内部
+// 转移。length在没有收到字节时，直接转移到Tail。
+enum {
+    Tsm_Idle = 0,
+    Tsm_Head,
+    Tsm_Body,
+    Tsm_Tail,
+
+    Tsm_Max
+};
+
+static char tsm_trace[128];
+static eos_u32_t tsm_bytes;
+
+static void tsm_log(const char *text)
+{
+    strncat(tsm_trace, text, sizeof(tsm_trace) - strlen(tsm_trace) - 1);
+}
+
+#define TSM_ACTION(name_)                                                      \
+static void tsm_enter_##name_(eos_tsm_t * const me)                            \
+{                                                                              \
+    (void)me;                                                                  \
+    tsm_log("+" #name_);                                                       \
+}                                                                              \
+static void tsm_exit_##name_(eos_tsm_t * const me)                             \
+{                                                                              \
+    (void)me;                                                                  \
+    tsm_log("-" #name_);                                                       \
+}
+
+TSM_ACTION(head)
+TSM_ACTION(body)
+TSM_ACTION(tail)
+
+static void tsm_start(eos_tsm_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    (void)e;
+    tsm_bytes = 0;
+    tsm_log("!start");
+}
+
+static void tsm_byte(eos_tsm_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    (void)e;
+    tsm_bytes ++;
+    tsm_log("!byte");
+}
+
+static void tsm_length(eos_tsm_t * const me, eos_event_t const * const e)
+{
+    (void)e;
+    tsm_log("!length");
+    if (tsm_bytes == 0) {
+        eos_tsm_tran(me, Tsm_Tail);
+    }
+}
+
+static void tsm_done(eos_tsm_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    (void)e;
+    tsm_log("!done");
+}
+
+/* transition table --------------------------------------------------------- */
+#define N                                   EOS_TSM_NONE
+
+static const eos_tsm_state_action tsm_entry[Tsm_Max] = {
+    EOS_NULL, tsm_enter_head, tsm_enter_body, tsm_enter_tail,
+};
+static const eos_tsm_state_action tsm_exit[Tsm_Max] = {
+    EOS_NULL, tsm_exit_head, tsm_exit_body, tsm_exit_tail,
+};
+
+// 密集表，主题为Event_Test ~ Event_Request
+static const eos_u8_t tsm_dense_next[Tsm_Max * 7] = {
+    Tsm_Head, N,        N,        N,        N,        N,        N,
+    N,        Tsm_Body, N,        N,        Tsm_Head, N,        N,
+    N,        N,        Tsm_Body, Tsm_Tail, N,        N,        N,
+    N,        N,        N,        N,        N,        Tsm_Tail, Tsm_Idle,
+};
+static const eos_tsm_action tsm_dense_action[Tsm_Max * 7] = {
+    tsm_start, EOS_NULL, EOS_NULL, EOS_NULL, EOS_NULL, EOS_NULL, EOS_NULL,
+    EOS_NULL, tsm_length, EOS_NULL, EOS_NULL, tsm_byte, EOS_NULL, EOS_NULL,
+    EOS_NULL, EOS_NULL, tsm_byte, EOS_NULL, EOS_NULL, EOS_NULL, EOS_NULL,
+    EOS_NULL, EOS_NULL, EOS_NULL, EOS_NULL, EOS_NULL, EOS_NULL, tsm_done,
+};
+static const eos_tsm_table_t tsm_dense = {
+    tsm_dense_next, tsm_dense_action, EOS_NULL, EOS_NULL, tsm_entry, tsm_exit,
+    Tsm_Max * 7, Tsm_Max, Event_Test, 7,
+#if (EOS_USE_STATE_SUB != 0)
+    EOS_NULL,
+#endif
+};
+
+// 同一个表的稀疏表，由tools/tsm_pack.py压缩，各行的表项互不冲突，全部从0开始，共7项。
+static const eos_u8_t tsm_sparse_next[7] = {
+    Tsm_Head, Tsm_Body, Tsm_Body, Tsm_Tail, Tsm_Head, Tsm_Tail, Tsm_Idle,
+};
+static const eos_tsm_action tsm_sparse_action[7] = {
+    tsm_start, tsm_length, tsm_byte, EOS_NULL, tsm_byte, EOS_NULL, tsm_done,
+};
+static const eos_u16_t tsm_sparse_base[Tsm_Max] = {
+    0, 0, 0, 0,
+};
+static const eos_u8_t tsm_sparse_check[7] = {
+    Tsm_Idle, Tsm_Head, Tsm_Body, Tsm_Body, Tsm_Head, Tsm_Tail, Tsm_Tail,
+};
+static const eos_tsm_table_t tsm_sparse = {
+    tsm_sparse_next, tsm_sparse_action, tsm_sparse_base, tsm_sparse_check,
+    tsm_entry, tsm_exit,
+    7, Tsm_Max, Event_Test, 7,
+#if (EOS_USE_STATE_SUB != 0)
+    EOS_NULL,
+#endif
+};
+#undef N
+
+/* unit test ---------------------------------------------------------------- */
+#if (EOS_USE_PUB_SUB != 0)
+static eos_mcu_t sub_table[Event_Max];
+#endif
+static eos_tsm_t tsm[2];
+
+// 发布事件并执行，检查动作、退出与进入的顺序，以及最终的状态。
+static void tsm_dispatch(eos_tsm_t *me, eos_topic_t topic, const char *trace, eos_u8_t state)
+{
+    tsm_trace[0] = 0;
+    eos_event_pub_topic(topic);
+    TEST_ASSERT_EQUAL_INT8(EosRun_OK, eos_once());
+    TEST_ASSERT_EQUAL_STRING(trace, tsm_trace);
+    TEST_ASSERT_EQUAL_UINT8(state, me->state);
+}
+
+static void tsm_run(eos_tsm_t *me, eos_tsm_table_t const *table)
+{
+    eos_set_time(0);
+    eos_init();
+#if (EOS_USE_PUB_SUB != 0)
+    eos_sub_init(sub_table, Event_Max);
+#endif
+
+    tsm_trace[0] = 0;
+    eos_tsm_init(me, 0, EOS_NULL);
+    eos_tsm_start(me, table, Tsm_Idle);
+    TEST_ASSERT_EQUAL_STRING("", tsm_trace);
+    TEST_ASSERT_EQUAL_UINT8(Tsm_Idle, me->state);
+#if (EOS_USE_PUB_SUB != 0)
+    for (eos_topic_t topic = Event_Test; topic < Event_Max; topic ++) {
+        eos_event_sub(&me->super, topic);
+    }
+#endif
+
+    for (eos_u32_t i = 0; i < 2; i ++) {
+        // 空表项与范围之外的主题被忽略
+        tsm_dispatch(me, Event_TestFsm, "", Tsm_Idle);
+        tsm_dispatch(me, Event_Timeout, "", Tsm_Idle);
+        tsm_dispatch(me, Event_Test, "!start+head", Tsm_Head);
+        // 内部转移，不退出也不进入
+        tsm_dispatch(me, Event_Time_500ms, "!byte", Tsm_Head);
+        tsm_dispatch(me, Event_Time_500ms, "!byte", Tsm_Head);
+        // 先执行动作，再退出与进入
+        tsm_dispatch(me, Event_TestFsm, "!length-head+body", Tsm_Body);
+        tsm_dispatch(me, Event_TestHsm, "!byte", Tsm_Body);
+        tsm_dispatch(me, Event_Test, "", Tsm_Body);
+        // 没有动作的转移与内部转移
+        tsm_dispatch(me, Event_TestReactor, "-body+tail", Tsm_Tail);
+        tsm_dispatch(me, Event_Time_2000ms, "", Tsm_Tail);
+        // 目标状态没有进入动作
+        tsm_dispatch(me, Event_Request, "!done-tail", Tsm_Idle);
+
+        // 动作以eos_tsm_tran改变下一个状态
+        tsm_dispatch(me, Event_Test, "!start+head", Tsm_Head);
+        tsm_dispatch(me, Event_TestFsm, "!length-head+tail", Tsm_Tail);
+        tsm_dispatch(me, Event_Request, "!done-tail", Tsm_Idle);
+    }
+}
+#endif
+
+void eos_test_tsm(void)
+{
+#if (EOS_USE_SM_TABLE != 0)
+    tsm_run(&tsm[0], &tsm_dense);
+    tsm_run(&tsm[1], &tsm_sparse);
+#endif
+}
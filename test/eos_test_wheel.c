@@ -0,0 +1,164 @@
+/* include ------------------------------------------------------------------ */
+#include "eos_test.h"
+#include "eos_test_def.h"
+#include "event_def.h"
+#include "unity.h"
+#include "unity_pack.h"
+
+#if (EOS_USE_TIMER_WHEEL != 0)
+/* data --------------------------------------------------------------------- */
+#define WHEEL_TEST_NUM                      256
+#define WHEEL_TEST_TOPIC                    Event_Max
+
+static eos_u32_t wheel_expect[WHEEL_TEST_NUM];
+static eos_u32_t wheel_fire[WHEEL_TEST_NUM];
+static eos_u32_t wheel_count[WHEEL_TEST_NUM];
+static eos_u32_t wheel_seed;
+
+// 覆盖时间轮每一层的延时范围，最后一项超出最高层的跨度。
+static const eos_u32_t wheel_range[] = {
+    32, 1024, 32768, 1048576, 33554432, 1296000000
+};
+
+/* actors for test ---------------------------------------------------------- */
+static void wheel_func(eos_reactor_t * const me, eos_event_t const * const e)
+{
+    (void)me;
+    eos_u32_t index = e->topic - WHEEL_TEST_TOPIC;
+    wheel_fire[index] = eos_time();
+    wheel_count[index] ++;
+}
+
+/* unit test ---------------------------------------------------------------- */
+#if (EOS_USE_PUB_SUB != 0)
+static eos_mcu_t sub_table[Event_Max + WHEEL_TEST_NUM];
+#endif
+static eos_reactor_t wheel_reactor;
+static eos_t *f;
+
+static eos_u32_t wheel_rand(void)
+{
+    wheel_seed = wheel_seed * 1103515245 + 12345;
+    return (wheel_seed >> 8);
+}
+
+static eos_u32_t wheel_delay(void)
+{
+    eos_u32_t range = wheel_range[wheel_rand() % (sizeof(wheel_range) / sizeof(eos_u32_t))];
+    return (wheel_rand() % range) + 1;
+}
+
+// 直接修改系统时间（不重建时间轮），执行所有事件。
+static void wheel_run_to(eos_u32_t time_ms)
+{
+    f->time = time_ms;
+    while (eos_once() == EosRun_OK) {
+    }
+}
+
+static void wheel_start(eos_u32_t index, eos_u32_t delay_ms)
+{
+    wheel_expect[index] = eos_time() + delay_ms;
+    wheel_fire[index] = 0;
+    wheel_count[index] = 0;
+    eos_event_pub_delay(WHEEL_TEST_TOPIC + index, delay_ms);
+}
+#endif
+
+void eos_test_wheel(void)
+{
+#if (EOS_USE_TIMER_WHEEL != 0)
+    f = eos_get_framework();
+    wheel_seed = 1;
+    eos_set_time(0);
+
+    eos_init();
+#if (EOS_USE_PUB_SUB != 0)
+    eos_sub_init(sub_table, Event_Max + WHEEL_TEST_NUM);
+#endif
+    eos_reactor_init(&wheel_reactor, 0, EOS_NULL);
+    eos_reactor_start(&wheel_reactor, wheel_func);
+#if (EOS_USE_PUB_SUB != 0)
+    for (eos_u32_t i = 0; i < WHEEL_TEST_NUM; i ++) {
+        eos_event_sub(&wheel_reactor.super, WHEEL_TEST_TOPIC + i);
+    }
+#endif
+
+    // 每次推进到timeout_min，每个定时器都应在其超时时刻准确到期 ----------------
+    for (eos_u32_t i = 0; i < WHEEL_TEST_NUM; i ++) {
+        wheel_start(i, wheel_delay());
+    }
+    TEST_ASSERT_EQUAL_UINT16(WHEEL_TEST_NUM, f->timer_count);
+    while (f->timer_count != 0) {
+        TEST_ASSERT_TRUE(f->timeout_min > eos_time());
+        wheel_run_to(f->timeout_min);
+    }
+    for (eos_u32_t i = 0; i < WHEEL_TEST_NUM; i ++) {
+        TEST_ASSERT_EQUAL_UINT32(1, wheel_count[i]);
+        TEST_ASSERT_EQUAL_UINT32(wheel_expect[i], wheel_fire[i]);
+    }
+
+    // 随机步长推进，定时器在越过其超时时刻的那一步到期 ----------------------------
+    eos_set_time(0);
+    for (eos_u32_t i = 0; i < WHEEL_TEST_NUM; i ++) {
+        wheel_start(i, (wheel_rand() % 1000000) + 1);
+    }
+    eos_u32_t time_last = 0;
+    while (f->timer_count != 0) {
+        eos_u32_t time = time_last + (wheel_rand() % 5000) + 1;
+        wheel_run_to(time);
+        for (eos_u32_t i = 0; i < WHEEL_TEST_NUM; i ++) {
+            if (wheel_expect[i] > time_last && wheel_expect[i] <= time) {
+                TEST_ASSERT_EQUAL_UINT32(1, wheel_count[i]);
+                TEST_ASSERT_EQUAL_UINT32(time, wheel_fire[i]);
+            }
+            if (wheel_expect[i] > time) {
+                TEST_ASSERT_EQUAL_UINT32(0, wheel_count[i]);
+            }
+        }
+        time_last = time;
+    }
+
+    // 取消一半的定时器，被取消的定时器不会到期，其余的仍准时到期 ------------------
+    eos_set_time(0);
+    for (eos_u32_t i = 0; i < WHEEL_TEST_NUM; i ++) {
+        wheel_start(i, wheel_delay());
+    }
+    for (eos_u32_t i = 0; i < WHEEL_TEST_NUM; i += 2) {
+        eos_event_time_cancel(WHEEL_TEST_TOPIC + i);
+    }
+    TEST_ASSERT_EQUAL_UINT16(WHEEL_TEST_NUM / 2, f->timer_count);
+    while (f->timer_count != 0) {
+        wheel_run_to(f->timeout_min);
+    }
+    for (eos_u32_t i = 0; i < WHEEL_TEST_NUM; i ++) {
+        if ((i % 2) == 0) {
+            TEST_ASSERT_EQUAL_UINT32(0, wheel_count[i]);
+            continue;
+        }
+        TEST_ASSERT_EQUAL_UINT32(1, wheel_count[i]);
+        TEST_ASSERT_EQUAL_UINT32(wheel_expect[i], wheel_fire[i]);
+    }
+
+    // 周期事件 ------------------------------------------------------------------
+    eos_set_time(0);
+    for (eos_u32_t i = 0; i < 4; i ++) {
+        wheel_count[i] = 0;
+    }
+    eos_event_pub_period(WHEEL_TEST_TOPIC + 0, 1);
+    eos_event_pub_period(WHEEL_TEST_TOPIC + 1, 7);
+    eos_event_pub_period(WHEEL_TEST_TOPIC + 2, 32);
+    eos_event_pub_period(WHEEL_TEST_TOPIC + 3, 1000);
+    for (eos_u32_t time = 1; time <= 10000; time ++) {
+        wheel_run_to(time);
+    }
+    TEST_ASSERT_EQUAL_UINT32(10000, wheel_count[0]);
+    TEST_ASSERT_EQUAL_UINT32(10000 / 7, wheel_count[1]);
+    TEST_ASSERT_EQUAL_UINT32(10000 / 32, wheel_count[2]);
+    TEST_ASSERT_EQUAL_UINT32(10, wheel_count[3]);
+    for (eos_u32_t i = 0; i < 4; i ++) {
+        eos_event_time_cancel(WHEEL_TEST_TOPIC + i);
+    }
+    TEST_ASSERT_EQUAL_UINT16(0, f->timer_count);
+#endif
+}
@@ -11,6 +11,9 @@ enum {
     Event_TestReactor,
     Event_Time_500ms,
     Event_Time_2000ms,
+    Event_Request,
+    Event_Reply,
+    Event_Timeout,
 
     Event_ActEnd,
     
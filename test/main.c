@@ -16,8 +16,24 @@ int main(void)
     RUN_TEST(eos_test_event);
     RUN_TEST(eos_test_sub);
     RUN_TEST(eos_test_etimer);
+    RUN_TEST(eos_test_wheel);
+    RUN_TEST(eos_test_hrtimer);
+    RUN_TEST(eos_test_timer);
     RUN_TEST(eos_test_fsm);
+    RUN_TEST(eos_test_hsm);
+    RUN_TEST(eos_test_dsm);
+    RUN_TEST(eos_test_tsm);
+    RUN_TEST(eos_test_region);
+    RUN_TEST(eos_test_state_sub);
     RUN_TEST(eos_test_reactor);
+    RUN_TEST(eos_test_reactor_table);
+    RUN_TEST(eos_test_request);
+    RUN_TEST(eos_test_filter);
+    RUN_TEST(eos_test_delay);
+    RUN_TEST(eos_test_block);
+    RUN_TEST(eos_test_batch);
+    RUN_TEST(eos_test_preempt);
+    RUN_TEST(eos_test_edf);
 
     UNITY_END();
 
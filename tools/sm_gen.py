@@ -0,0 +1,1009 @@
+# Filename: sm_gen.py
+
+# 状态图生成器：读入文本（.sm）或JSON格式的状态图，生成EventOS的状态机代码。
+#
+# 用法：
+#   python3 tools/sm_gen.py chart.sm [--backend sm|dsm|tsm] [--dense] [-o out.c]
+#   python3 tools/sm_gen.py --import test/eos_fsm.c [-o chart.sm]    由状态函数反推状态图
+#   python3 tools/sm_gen.py --check test/eos_fsm.c                   往返检查，并编译各后端的输出
+#
+# 后端：
+#   sm   状态函数（eos_sm_t），与手写的switch写法相同，可以与--import往返。
+#   dsm  描述符表（eos_state_t，eos_dsm_t），只为有动作的状态生成函数。
+#   tsm  转移表（eos_tsm_table_t，eos_tsm_t）。层次状态图被展开为平面的转移表：每个叶子状态的每个
+#        主题在生成时即确定由哪一层处理、退出与进入的序列以及最终的状态，运行时查表后直接执行。
+#        需要在状态图中用topics给出连续的主题（生成的代码在编译时检查）。
+# 各后端都在生成时检查状态图、计算订阅集合（所有状态处理的主题），由初始化时一次订阅。开启
+# EOS_USE_STATE_SUB时，dsm与tsm后端改为按当前状态订阅：dsm为每个状态生成处理的主题，tsm为转移表
+# 生成各状态的主题位图sub_map，初始化时不再一次订阅。
+#
+# 文本格式（以#开头的行为注释，动作为C代码，me为Actor，e为事件）：
+#   machine fsm fsm_t                       状态机的名称与Actor的类型
+#   prefix state_                           状态函数与描述符的前缀，默认为state_
+#   include eventos.h                       生成的#include
+#   condition EOS_USE_SM_MODE != 0          生成的代码所在的#if条件
+#   topics Event_A Event_B Event_C          tsm后端的主题范围，须连续
+#   %{
+#   原样输出的代码，位于状态的声明之后
+#   %}
+#   constructor fsm_init { me->count = 0; }  Actor的初始化函数（可选），由各后端生成：执行动作后，
+#                                           初始化并启动状态机
+#   initial -> off { me->count = 0; }       初始转移与动作
+#   state off                               状态，state s11 : s1 表示父状态为s1
+#       init -> s111                        进入后钻入的子孙状态
+#       entry { me->state = 0; }            进入动作，没有代码时只写entry
+#       exit
+#       Event_TestFsm -> on {               转移，多行的动作以单独一行的}结束
+#           me->count ++;
+#       }
+#       Event_Time_500ms { me->count ++; }  内部转移
+#
+# JSON格式与文本格式一一对应：
+#   { "name": "fsm", "type": "fsm_t", "prefix": "state_", "include": [...], "condition": "...",
+#     "topics": [...], "prologue": "...", "constructor": { "name": "fsm_init", "action": "..." },
+#     "initial": { "target": "off", "action": "..." },
+#     "states": [ { "name": "off", "parent": null, "init": null, "entry": "...", "exit": null,
+#                   "events": [ { "topic": "Event_TestFsm", "target": "on", "action": "..." } ] } ] }
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+sys.path.append(os.path.dirname(os.path.abspath(__file__)))
+import tsm_pack
+
+RESERVED = ("Event_Null", "Event_Enter", "Event_Exit", "Event_Init")
+
+
+class ChartError(Exception):
+    pass
+
+
+def chart_new():
+    return {
+        "name": "sm", "type": "eos_sm_t", "prefix": "state_", "include": ["eventos.h"],
+        "condition": None, "topics": [], "prologue": "", "constructor": None,
+        "initial": None, "states": [],
+    }
+
+
+def state_new(name, parent = None):
+    return {
+        "name": name, "parent": parent, "init": None, "entry": None, "exit": None, "events": [],
+    }
+
+
+# 去掉公共缩进与首尾的空行
+def dedent(lines):
+    while len(lines) != 0 and lines[0].strip() == "":
+        lines = lines[1:]
+    while len(lines) != 0 and lines[-1].strip() == "":
+        lines = lines[:-1]
+    indent = min([len(l) - len(l.lstrip()) for l in lines if l.strip() != ""] or [0])
+    return "\n".join(l[indent:].rstrip() for l in lines)
+
+
+# 文本格式 -------------------------------------------------------------------
+def parse_text(text):
+    chart = chart_new()
+    chart["include"] = []
+    lines = text.replace("\r\n", "\n").split("\n")
+    state = None
+    i = 0
+
+    # 解析行末的动作：{ code }、多行的{ ... }，或者没有动作
+    def action(rest, i):
+        rest = rest.strip()
+        if rest == "":
+            return "", i
+        if rest == "{":
+            block = []
+            while i < len(lines) and lines[i].strip() != "}":
+                block.append(lines[i])
+                i += 1
+            if i == len(lines):
+                raise ChartError("unterminated action block")
+            return dedent(block), i + 1
+        m = re.match(r"^\{(.*)\}$", rest)
+        if m is None:
+            raise ChartError("bad action: " + rest)
+        return m.group(1).strip(), i
+
+    while i < len(lines):
+        line = lines[i]
+        i += 1
+        words = line.split()
+        if len(words) == 0 or words[0].startswith("#"):
+            continue
+        key = words[0]
+
+        if key == "%{":
+            block = []
+            while i < len(lines) and lines[i].strip() != "%}":
+                block.append(lines[i])
+                i += 1
+            chart["prologue"] = "\n".join(block).strip("\n")
+            i += 1
+        elif key == "machine":
+            chart["name"] = words[1]
+            chart["type"] = words[2] if len(words) > 2 else "eos_sm_t"
+        elif key == "prefix":
+            chart["prefix"] = words[1]
+        elif key == "include":
+            chart["include"].append(words[1])
+        elif key == "condition":
+            chart["condition"] = line.split(None, 1)[1].strip()
+        elif key == "topics":
+            chart["topics"] = words[1:]
+        elif key == "constructor":
+            m = re.match(r"^\s*constructor\s+(\w+)(.*)$", line)
+            if m is None:
+                raise ChartError("bad constructor: " + line.strip())
+            act, i = action(m.group(2), i)
+            chart["constructor"] = { "name": m.group(1), "action": act }
+        elif key == "initial":
+            m = re.match(r"^\s*initial\s*->\s*(\w+)(.*)$", line)
+            if m is None:
+                raise ChartError("bad initial transition: " + line.strip())
+            act, i = action(m.group(2), i)
+            chart["initial"] = { "target": m.group(1), "action": act }
+        elif key == "state":
+            m = re.match(r"^\s*state\s+(\w+)\s*(?::\s*(\w+))?\s*$", line)
+            if m is None:
+                raise ChartError("bad state: " + line.strip())
+            state = state_new(m.group(1), m.group(2))
+            chart["states"].append(state)
+        elif state is None:
+            raise ChartError("unknown statement: " + line.strip())
+        elif key == "init":
+            m = re.match(r"^\s*init\s*->\s*(\w+)\s*$", line)
+            if m is None:
+                raise ChartError("bad init: " + line.strip())
+            state["init"] = m.group(1)
+        elif key in ("entry", "exit"):
+            state[key], i = action(line.strip()[len(key):], i)
+        else:
+            m = re.match(r"^\s*(\w+)\s*(?:->\s*(\w+))?(.*)$", line)
+            act, i = action(m.group(3), i)
+            state["events"].append({ "topic": m.group(1), "target": m.group(2), "action": act })
+
+    if chart["include"] == []:
+        chart["include"] = ["eventos.h"]
+    return chart
+
+
+def write_text(chart):
+    out = []
+
+    def action(head, act, indent):
+        if act is None or act == "":
+            out.append(indent + head)
+        elif "\n" not in act:
+            out.append("%s%s { %s }" % (indent, head, act))
+        else:
+            out.append(indent + head + " {")
+            for l in act.split("\n"):
+                out.append((indent + "    " + l) if l != "" else "")
+            out.append(indent + "}")
+
+    out.append("machine %s %s" % (chart["name"], chart["type"]))
+    out.append("prefix %s" % chart["prefix"])
+    for inc in chart["include"]:
+        out.append("include %s" % inc)
+    if chart["condition"] is not None:
+        out.append("condition %s" % chart["condition"])
+    if len(chart["topics"]) != 0:
+        out.append("topics %s" % " ".join(chart["topics"]))
+    if chart["prologue"] != "":
+        out.append("%{")
+        out.append(chart["prologue"])
+        out.append("%}")
+    if chart["constructor"] is not None:
+        action("constructor %s" % chart["constructor"]["name"], chart["constructor"]["action"], "")
+    out.append("")
+    action("initial -> %s" % chart["initial"]["target"], chart["initial"]["action"], "")
+    for s in chart["states"]:
+        out.append("")
+        out.append("state %s" % s["name"] + ("" if s["parent"] is None else " : %s" % s["parent"]))
+        if s["init"] is not None:
+            out.append("    init -> %s" % s["init"])
+        for key in ("entry", "exit"):
+            if s[key] is not None:
+                action(key, s[key], "    ")
+        for ev in s["events"]:
+            head = ev["topic"] + ("" if ev["target"] is None else " -> %s" % ev["target"])
+            action(head, ev["action"], "    ")
+    return "\n".join(out) + "\n"
+
+
+def parse_json(text):
+    chart = chart_new()
+    chart.update(json.loads(text))
+    for i, s in enumerate(chart["states"]):
+        state = state_new(s["name"])
+        state.update(s)
+        for ev in state["events"]:
+            ev.setdefault("target", None)
+            ev.setdefault("action", "")
+        chart["states"][i] = state
+    chart["initial"].setdefault("action", "")
+    if chart["constructor"] is not None:
+        chart["constructor"].setdefault("action", "")
+    return chart
+
+
+def load(path):
+    with open(path, encoding = 'utf-8') as f:
+        text = f.read()
+    if path.endswith(".json"):
+        return parse_json(text)
+    if path.endswith(".c"):
+        return import_c(text, os.path.dirname(os.path.abspath(path)))
+    return parse_text(text)
+
+
+# 由状态函数反推状态图 ---------------------------------------------------------
+# 只支持本生成器输出的写法：每个状态函数为switch (e->topic)，每个case以return EOS_TRAN(...)或
+# return EOS_Ret_Handled结束，default为return EOS_SUPER(...)；初始状态函数不含switch。声明之后的
+# 代码原样保留，其中以eos_sm_start启动状态机的初始化函数由各后端生成。主题的范围由directory中
+# 被包含的头文件里的枚举得到。
+RE_FUNC = r"^static eos_ret_t (\w+)\((\w+) \* const me, eos_event_t const \* const e\)"
+RE_CTOR = r"^void (\w+)\((\w+) \* const me, eos_u8_t priority, void const \* const parameter\)$"
+
+
+def import_c(text, directory = None):
+    chart = chart_new()
+    chart["include"] = re.findall(r'^#include "(.+)"', text, re.M)
+    lines = text.replace("\r\n", "\n").split("\n")
+
+    decl_end = None
+    funcs = []
+    i = 0
+    while i < len(lines):
+        m = re.match(RE_FUNC + r"\s*(;?)\s*$", lines[i])
+        if m is None:
+            if chart["condition"] is None and len(funcs) == 0 and decl_end is None:
+                c = re.match(r"^#if \((.*)\)\s*$", lines[i])
+                if c is not None:
+                    chart["condition"] = c.group(1)
+            i += 1
+            continue
+        chart["type"] = m.group(2)
+        if m.group(3) == ";":
+            decl_end = i + 1
+            i += 1
+            continue
+        if len(funcs) == 0 and decl_end is not None:
+            # 声明与第一个状态函数之间的代码，去掉段落注释
+            block = lines[decl_end:i]
+            while len(block) != 0 and (block[-1].strip() == "" or block[-1].startswith("// ")):
+                block = block[:-1]
+            chart["prologue"] = "\n".join(block).strip("\n")
+        body = []
+        i += 2
+        while lines[i] != "}":
+            body.append(lines[i])
+            i += 1
+        funcs.append((m.group(1), body))
+        i += 1
+    if len(funcs) == 0:
+        raise ChartError("no state function found")
+
+    names = [f[0] for f in funcs]
+    prefix = os.path.commonprefix(names)
+    prefix = prefix[:prefix.rfind("_") + 1]
+    chart["prefix"] = prefix
+    chart["name"] = chart["type"][:-2] if chart["type"].endswith("_t") else chart["type"]
+
+    subs = []
+    for name, body in funcs:
+        name = name[len(prefix):]
+        if not any("switch (e->topic)" in l for l in body):
+            chart["initial"] = import_initial(body, subs)
+            continue
+        chart["states"].append(import_state(name, body, prefix))
+    if chart["initial"] is None:
+        raise ChartError("no initial state function found")
+    if not chart["initial"]["target"].startswith(prefix):
+        raise ChartError("state %s does not start with %s" % (chart["initial"]["target"], prefix))
+    chart["initial"]["target"] = chart["initial"]["target"][len(prefix):]
+    import_constructor(chart)
+    chart["topics"] = import_topics(chart, directory)
+
+    # 手写的订阅须与状态图处理的主题一致
+    if len(subs) != 0 and set(subs) != set(subscriptions(chart)):
+        sys.stderr.write("warning: subscribed %s, handled %s\n" %
+                         (sorted(subs), sorted(subscriptions(chart))))
+    return chart
+
+
+# 由代码中取出初始化函数：除了eos_sm_init与以初始状态函数启动的eos_sm_start，其余为动作。
+def import_constructor(chart):
+    lines = chart["prologue"].split("\n")
+    start = "eos_sm_start(&me->super, EOS_STATE_CAST(%sinit));" % chart["prefix"]
+    for i, l in enumerate(lines):
+        m = re.match(RE_CTOR, l)
+        if m is None or m.group(2) != chart["type"] or i + 1 >= len(lines) or lines[i + 1] != "{":
+            continue
+        end = lines.index("}", i + 2)
+        body = [b for b in lines[i + 2:end] if b.strip() != start and
+                b.strip() != "eos_sm_init(&me->super, priority, parameter);"]
+        if len(body) != end - i - 4:
+            continue
+        chart["constructor"] = { "name": m.group(1), "action": dedent(body) }
+        # 连同其后的空行一起去掉
+        if end + 1 < len(lines) and lines[end + 1].strip() == "":
+            end += 1
+        chart["prologue"] = "\n".join(lines[:i] + lines[end + 1:]).strip("\n")
+        return
+
+
+# 主题的范围：在被包含的头文件的枚举中，从处理的第一个主题到最后一个主题。找不到时为处理的主题。
+def import_topics(chart, directory):
+    handled = subscriptions(chart)
+    for inc in chart["include"] if directory is not None else []:
+        path = os.path.join(directory, inc)
+        if len(handled) == 0 or not os.path.isfile(path):
+            continue
+        with open(path, encoding = 'utf-8') as f:
+            text = f.read()
+        for body in re.findall(r"\benum\s*\w*\s*\{(.*?)\}", text, re.S):
+            names = re.findall(r"^\s*(\w+)\s*(?:=[^,]*)?,?\s*(?://.*)?$", body, re.M)
+            if all(t in names for t in handled):
+                index = [names.index(t) for t in handled]
+                return names[min(index):max(index) + 1]
+    return handled
+
+
+def import_initial(body, subs):
+    action = []
+    target = None
+    for l in body:
+        s = l.strip()
+        m = re.match(r"^EOS_EVENT_SUB\((\w+)\);$", s)
+        if m is not None:
+            subs.append(m.group(1))
+        elif re.match(r"^return EOS_TRAN\((\w+)\);$", s):
+            target = re.match(r"^return EOS_TRAN\((\w+)\);$", s).group(1)
+        elif s not in ("(void)e;", "#if (EOS_USE_PUB_SUB != 0)", "#endif"):
+            action.append(l)
+    if target is None:
+        raise ChartError("the initial state function must return EOS_TRAN")
+    return { "target": target, "action": dedent(action) }
+
+
+def import_state(name, body, prefix):
+    state = state_new(name)
+    labels = []
+    action = []
+    brace = False
+
+    def strip(n):
+        if not n.startswith(prefix):
+            raise ChartError("state %s does not start with %s" % (n, prefix))
+        return n[len(prefix):]
+
+    def close(target):
+        for topic in labels:
+            act = dedent(action)
+            if topic == "Event_Enter":
+                state["entry"] = act
+            elif topic == "Event_Exit":
+                state["exit"] = act
+            elif topic == "Event_Init":
+                state["init"] = target
+            else:
+                state["events"].append({ "topic": topic, "target": target, "action": act })
+
+    after_return = False
+    for l in body:
+        s = l.strip()
+        if s == "" or s.startswith("switch (e->topic)"):
+            continue
+        if after_return and s == "}":
+            after_return = False
+            continue
+        after_return = False
+        m = re.match(r"^case (\w+):\s*(\{?)$", s)
+        if m is not None:
+            if len(action) != 0:
+                raise ChartError("state %s: case %s falls through" % (name, m.group(1)))
+            labels.append(m.group(1))
+            brace = (m.group(2) == "{")
+            continue
+        if s == "default:":
+            continue
+        m = re.match(r"^return EOS_SUPER\((\w+)\);$", s)
+        if m is not None:
+            state["parent"] = None if m.group(1) == "eos_state_top" else strip(m.group(1))
+            continue
+        m = re.match(r"^return EOS_TRAN\((\w+)\);$", s)
+        if m is not None or s == "return EOS_Ret_Handled;":
+            close(None if m is None else strip(m.group(1)))
+            labels = []
+            action = []
+            after_return = brace
+            brace = False
+            continue
+        if s == "}" and len(labels) == 0:
+            # switch的结束
+            continue
+        action.append(l)
+    return state
+
+
+# 状态图的分析 -----------------------------------------------------------------
+def states_map(chart):
+    return { s["name"]: s for s in chart["states"] }
+
+
+def ancestors(sm, name):
+    chain = []
+    while name is not None:
+        chain.append(name)
+        name = sm[name]["parent"]
+    return chain
+
+
+def check(chart):
+    sm = states_map(chart)
+    if len(sm) != len(chart["states"]):
+        raise ChartError("duplicate state names")
+    if chart["initial"] is None:
+        raise ChartError("no initial transition")
+
+    def known(n, where):
+        if n is not None and n not in sm:
+            raise ChartError("%s: unknown state %s" % (where, n))
+
+    known(chart["initial"]["target"], "initial")
+    for s in chart["states"]:
+        known(s["parent"], s["name"])
+        known(s["init"], s["name"])
+        if s["init"] is not None and s["name"] not in ancestors(sm, s["init"])[1:]:
+            raise ChartError("%s: init must be a descendant" % s["name"])
+        for ev in s["events"]:
+            known(ev["target"], s["name"])
+            if ev["topic"] in RESERVED:
+                raise ChartError("%s: %s is reserved" % (s["name"], ev["topic"]))
+        topics = [ev["topic"] for ev in s["events"]]
+        if len(set(topics)) != len(topics):
+            raise ChartError("%s: duplicate topics" % s["name"])
+    for s in chart["states"]:
+        if len(ancestors(sm, s["name"])) > 32:
+            raise ChartError("%s: nested too deep (or cyclic)" % s["name"])
+
+
+def depth(chart):
+    sm = states_map(chart)
+    return max(len(ancestors(sm, s["name"])) for s in chart["states"])
+
+
+# 订阅集合：所有状态处理的主题，按出现的顺序
+def subscriptions(chart):
+    topics = []
+    for s in chart["states"]:
+        for ev in s["events"]:
+            if ev["topic"] not in topics:
+                topics.append(ev["topic"])
+    return topics
+
+
+# 由状态name进入，沿init钻入，返回进入的状态序列（不含name）与最终的状态
+def drill(sm, name):
+    seq = []
+    while sm[name]["init"] is not None:
+        init = sm[name]["init"]
+        path = ancestors(sm, init)
+        seq += list(reversed(path[:path.index(name)]))
+        name = init
+    return seq, name
+
+
+# 当前状态为leaf，由状态source处理并转移到target时，退出与进入的序列，以及最终的状态。与
+# eos_sm、eos_dsm的语义相同：转移到自身时退出并重新进入，转移到父状态时不重新进入。
+def transition(sm, leaf, source, target):
+    chain_s = ancestors(sm, sm[source]["parent"] if source == target else source)
+    chain_t = ancestors(sm, target)
+    lca = next((n for n in chain_s if n in chain_t), None)
+
+    exits = []
+    for n in ancestors(sm, leaf):
+        if n == lca:
+            break
+        exits.append(n)
+    entries = []
+    if target != lca:
+        entries = list(reversed(chain_t[:chain_t.index(lca)] if lca is not None else chain_t))
+    seq, final = drill(sm, target)
+    return exits, entries + seq, final
+
+
+# 后端的公共部分 ---------------------------------------------------------------
+class Writer:
+    def __init__(self, chart, source):
+        self.chart = chart
+        self.out = []
+        self.p = chart["prefix"]
+        self.t = chart["type"]
+        self.out.append("// Generated by tools/sm_gen.py from %s, do not edit." % source)
+        for inc in chart["include"]:
+            self.out.append('#include "%s"' % inc)
+        self.out.append("")
+        if chart["condition"] is not None:
+            self.out.append("#if (%s)" % chart["condition"])
+
+    def line(self, text = ""):
+        self.out.append(text)
+
+    def section(self, title):
+        self.out.append(("// %s " % title).ljust(80, "-"))
+
+    def code(self, act, indent):
+        if act is None or act == "":
+            return
+        for l in act.split("\n"):
+            self.out.append((indent + l) if l != "" else "")
+
+    def prologue(self):
+        if self.chart["prologue"] != "":
+            self.line()
+            self.out.append(self.chart["prologue"])
+        self.line()
+
+    # Actor的初始化函数：执行动作后，以calls初始化并启动状态机
+    def constructor(self, calls):
+        c = self.chart["constructor"]
+        if c is None:
+            return
+        self.line("void %s(%s * const me, eos_u8_t priority, void const * const parameter)" %
+                  (c["name"], self.t))
+        self.line("{")
+        if c["action"] != "":
+            self.code(c["action"], "    ")
+            self.line()
+        for call in calls:
+            self.line("    " + call)
+        self.line("}")
+        self.line()
+
+    def subscribe(self, indent, state_sub = False):
+        if state_sub:
+            self.line("#if (EOS_USE_PUB_SUB != 0 && EOS_USE_STATE_SUB == 0)")
+        else:
+            self.line("#if (EOS_USE_PUB_SUB != 0)")
+        for topic in subscriptions(self.chart):
+            self.line("%sEOS_EVENT_SUB(%s);" % (indent, topic))
+        self.line("#endif")
+
+    def depth_check(self):
+        n = depth(self.chart)
+        if n > 1:
+            self.line("#if (EOS_USE_HSM_MODE == 0 || EOS_MAX_HSM_NEST_DEPTH < %d)" % n)
+            self.line("#error The state machine %s needs the hsm mode with %d nested levels !" %
+                      (self.chart["name"], n))
+            self.line("#endif")
+            self.line()
+
+    def end(self):
+        while self.out[-1] == "":
+            self.out.pop()
+        if self.chart["condition"] is not None:
+            self.line()
+            self.line("#endif")
+        return "\n".join(self.out) + "\n"
+
+
+# sm后端：状态函数 ---------------------------------------------------------------
+def gen_sm(chart, source):
+    w = Writer(chart, source)
+    p, t = w.p, w.t
+    sig = "static eos_ret_t %s%s(%s * const me, eos_event_t const * const e)"
+
+    w.section("state")
+    w.depth_check()
+    w.line((sig % (p, "init", t)) + ";")
+    for s in chart["states"]:
+        w.line((sig % (p, s["name"], t)) + ";")
+    w.prologue()
+    w.constructor([ "eos_sm_init(&me->super, priority, parameter);",
+                    "eos_sm_start(&me->super, EOS_STATE_CAST(%sinit));" % p ])
+
+    w.section("state function")
+    w.line(sig % (p, "init", t))
+    w.line("{")
+    w.line("    (void)e;")
+    w.line()
+    w.subscribe("    ")
+    w.line()
+    if chart["initial"]["action"] != "":
+        w.code(chart["initial"]["action"], "    ")
+        w.line()
+    w.line("    return EOS_TRAN(%s%s);" % (p, chart["initial"]["target"]))
+    w.line("}")
+
+    for s in chart["states"]:
+        cases = []
+        if s["entry"] is not None:
+            cases.append(("Event_Enter", s["entry"], "EOS_Ret_Handled"))
+        if s["exit"] is not None:
+            cases.append(("Event_Exit", s["exit"], "EOS_Ret_Handled"))
+        if s["init"] is not None:
+            cases.append(("Event_Init", "", "EOS_TRAN(%s%s)" % (p, s["init"])))
+        for ev in s["events"]:
+            ret = "EOS_Ret_Handled" if ev["target"] is None else "EOS_TRAN(%s%s)" % (p, ev["target"])
+            cases.append((ev["topic"], ev["action"], ret))
+
+        w.line()
+        w.line(sig % (p, s["name"], t))
+        w.line("{")
+        w.line("    switch (e->topic) {")
+        for topic, act, ret in cases:
+            w.line("        case %s:" % topic)
+            w.code(act, "            ")
+            w.line("            return %s;" % ret)
+            w.line()
+        w.line("        default:")
+        parent = "eos_state_top" if s["parent"] is None else p + s["parent"]
+        w.line("            return EOS_SUPER(%s);" % parent)
+        w.line("    }")
+        w.line("}")
+    return w.end()
+
+
+# dsm后端：描述符表 --------------------------------------------------------------
+def gen_dsm(chart, source):
+    w = Writer(chart, source)
+    p, t = w.p, w.t
+    name = chart["name"]
+
+    w.section("state")
+    w.depth_check()
+    w.line("void %s_start(%s * const me);" % (name, t))
+    for s in chart["states"]:
+        w.line("static const eos_state_t %s%s;" % (p, s["name"]))
+    w.prologue()
+
+    w.section("state function")
+    for s in chart["states"]:
+        for key in ("entry", "exit"):
+            if s[key] is None or s[key] == "":
+                continue
+            w.line("static void %s%s_%s(%s * const me)" % (p, s["name"], key, t))
+            w.line("{")
+            w.code(s[key], "    ")
+            w.line("}")
+            w.line()
+        if len(s["events"]) == 0:
+            continue
+        w.line("static eos_ret_t %s%s_handler(%s * const me, eos_event_t const * const e)" %
+               (p, s["name"], t))
+        w.line("{")
+        w.line("    switch (e->topic) {")
+        for ev in s["events"]:
+            w.line("        case %s:" % ev["topic"])
+            w.code(ev["action"], "            ")
+            if ev["target"] is None:
+                w.line("            return EOS_Ret_Handled;")
+            else:
+                w.line("            return EOS_DSM_TRAN(%s%s);" % (p, ev["target"]))
+            w.line()
+        w.line("        default:")
+        w.line("            return EOS_Ret_Null;")
+        w.line("    }")
+        w.line("}")
+        w.line()
+
+    w.section("state descriptor")
+    w.line("#if (EOS_USE_STATE_SUB != 0)")
+    for s in chart["states"]:
+        if len(s["events"]) != 0:
+            w.line("static const eos_topic_t %s%s_topics[] = { %s };" %
+                   (p, s["name"], ", ".join(ev["topic"] for ev in s["events"])))
+    w.line("#endif")
+    w.line()
+    for s in chart["states"]:
+        def ref(n):
+            return "EOS_NULL" if n is None else "&%s%s" % (p, n)
+
+        def func(key, cast):
+            if key == "handler":
+                return "EOS_NULL" if len(s["events"]) == 0 else \
+                    "(%s)%s%s_handler" % (cast, p, s["name"])
+            return "EOS_NULL" if s[key] is None or s[key] == "" else \
+                "(%s)%s%s_%s" % (cast, p, s["name"], key)
+
+        w.line("static const eos_state_t %s%s = {" % (p, s["name"]))
+        w.line("    %s, %s," % (ref(s["parent"]), ref(s["init"])))
+        w.line("    %s, %s," % (func("entry", "eos_dsm_action"), func("exit", "eos_dsm_action")))
+        w.line("    %s," % func("handler", "eos_dsm_handler"))
+        if len(s["events"]) != 0:
+            w.line("#if (EOS_USE_STATE_SUB != 0)")
+            w.line("    %s%s_topics, %d," % (p, s["name"], len(s["events"])))
+            w.line("#endif")
+        w.line("};")
+    w.line()
+
+    w.section("api")
+    w.line("// 在eos_dsm_init之后调用，执行初始转移的动作，订阅所有被处理的主题（按状态订阅时除外），进入初始状态。")
+    w.line("void %s_start(%s * const me)" % (name, t))
+    w.line("{")
+    w.code(chart["initial"]["action"], "    ")
+    w.subscribe("    ", True)
+    w.line("    eos_dsm_start(&me->super, &%s%s);" % (p, chart["initial"]["target"]))
+    w.line("}")
+    w.line()
+    w.constructor([ "eos_dsm_init(&me->super, priority, parameter);", "%s_start(me);" % name ])
+    return w.end()
+
+
+# tsm后端：展开为平面的转移表 -----------------------------------------------------
+def gen_tsm(chart, source, dense):
+    w = Writer(chart, source)
+    p, t = w.p, w.t
+    name = chart["name"]
+    sm = states_map(chart)
+    topics = chart["topics"]
+    for topic in subscriptions(chart):
+        if topic not in topics:
+            raise ChartError("topic %s is not in the topics of the table" % topic)
+
+    # 只有不再钻入的状态可以成为当前状态
+    leaves = [s["name"] for s in chart["states"] if s["init"] is None]
+    if len(leaves) >= tsm_pack.EOS_TSM_NONE:
+        raise ChartError("the number of states must be 1 ~ 254")
+
+    # 每个（叶子状态，主题）：处理的状态，退出与进入的序列，以及最终的状态
+    rows = []
+    funcs = []
+    for leaf in leaves:
+        row = {}
+        for ti, topic in enumerate(topics):
+            for source_ in ancestors(sm, leaf):
+                ev = next((e for e in sm[source_]["events"] if e["topic"] == topic), None)
+                if ev is not None:
+                    break
+            if ev is None:
+                continue
+            if ev["target"] is None:
+                exits, entries, final = [], [], leaf
+            else:
+                exits, entries, final = transition(sm, leaf, source_, ev["target"])
+            calls = [n for n in exits if sm[n]["exit"]] + [n for n in entries if sm[n]["entry"]]
+            func = None
+            if ev["action"] != "" or len(calls) != 0:
+                func = "%s%s_%s" % (p, leaf, topic)
+                funcs.append((func, ev["action"],
+                              [n + "_exit" for n in exits if sm[n]["exit"]] +
+                              [n + "_entry" for n in entries if sm[n]["entry"]]))
+            row[ti] = (leaves.index(final), func)
+        rows.append(row)
+
+    if dense:
+        base = [i * len(topics) for i in range(len(leaves))]
+        size = len(leaves) * len(topics)
+    else:
+        base, size = tsm_pack.pack([list(r.keys()) for r in rows], len(topics))
+
+    w.section("state")
+    w.line("void %s_start(%s * const me);" % (name, t))
+    w.line()
+    w.line("enum {")
+    for i, leaf in enumerate(leaves):
+        w.line("    %s%s = %d," % (p, leaf, i))
+    w.line("};")
+    w.line()
+    # 表以主题的相对位置为下标，编译时检查主题是连续的
+    w.line("typedef char %s_topic_check[(" % name)
+    for i, topic in enumerate(topics[1:]):
+        w.line("    %s == %s + %d &&" % (topic, topics[0], i + 1))
+    w.line("    1) ? 1 : -1];")
+    w.prologue()
+
+    # 初始转移：由最外层进入目标状态，再沿init钻入
+    target = chart["initial"]["target"]
+    seq, final = drill(sm, target)
+    entries = list(reversed(ancestors(sm, target))) + seq
+
+    # 只生成被调用的进入与退出动作（如最外层的状态从不退出）
+    used = set(n + "_entry" for n in entries if sm[n]["entry"])
+    for func, act, calls in funcs:
+        used.update(calls)
+    w.section("state function")
+    for s in chart["states"]:
+        for key in ("entry", "exit"):
+            if s[key] is None or s[key] == "" or (s["name"] + "_" + key) not in used:
+                continue
+            w.line("static void %s%s_%s(%s * const me)" % (p, s["name"], key, t))
+            w.line("{")
+            w.code(s[key], "    ")
+            w.line("}")
+            w.line()
+    for func, act, calls in funcs:
+        w.line("static void %s(%s * const me, eos_event_t const * const e)" % (func, t))
+        w.line("{")
+        w.line("    (void)e;")
+        w.code(act, "    ")
+        for c in calls:
+            w.line("    %s%s(me);" % (p, c))
+        w.line("}")
+        w.line()
+
+    w.section("transition table")
+    w.line("// %d states x %d topics, %d entries (%s)" %
+           (len(leaves), len(topics), size, "dense" if dense else "sparse"))
+    next_ = ["EOS_TSM_NONE"] * size
+    action = ["EOS_NULL"] * size
+    check = ["EOS_TSM_NONE"] * size
+    for s, row in enumerate(rows):
+        for ti, (n, func) in row.items():
+            next_[base[s] + ti] = p + leaves[n]
+            check[base[s] + ti] = p + leaves[s]
+            if func is not None:
+                action[base[s] + ti] = "(eos_tsm_action)" + func
+
+    def array(ctype, var, items):
+        w.line("static const %s %s_%s[%d] = {" % (ctype, name, var, len(items)))
+        for i in range(0, len(items), 4):
+            w.line("    " + ", ".join(str(x) for x in items[i:i + 4]) + ",")
+        w.line("};")
+
+    array("eos_u8_t", "next", next_)
+    array("eos_tsm_action", "action", action)
+    if not dense:
+        array("eos_u16_t", "base", base)
+        array("eos_u8_t", "check", check)
+    words = (len(topics) + 31) // 32
+    sub_map = []
+    for row in rows:
+        for k in range(words):
+            bits = sum(1 << (ti - k * 32) for ti in row if ti // 32 == k)
+            sub_map.append("0x%08X" % bits)
+    w.line("#if (EOS_USE_STATE_SUB != 0)")
+    array("eos_u32_t", "sub_map", sub_map)
+    w.line("#endif")
+    w.line("static const eos_tsm_table_t %s_table = {" % name)
+    w.line("    %s_next, %s_action, %s, %s, EOS_NULL, EOS_NULL," %
+           (name, name, "EOS_NULL" if dense else name + "_base",
+            "EOS_NULL" if dense else name + "_check"))
+    w.line("    %d, %d, %s, %d," % (size, len(leaves), topics[0], len(topics)))
+    w.line("#if (EOS_USE_STATE_SUB != 0)")
+    w.line("    %s_sub_map," % name)
+    w.line("#endif")
+    w.line("};")
+    w.line()
+
+    w.section("api")
+    w.line("// 在eos_tsm_init之后调用，执行初始转移的动作，订阅所有被处理的主题（按状态订阅时除外），进入初始状态。")
+    w.line("void %s_start(%s * const me)" % (name, t))
+    w.line("{")
+    w.code(chart["initial"]["action"], "    ")
+    w.subscribe("    ", True)
+    for n in entries:
+        if sm[n]["entry"]:
+            w.line("    %s%s_entry(me);" % (p, n))
+    w.line("    eos_tsm_start(&me->super, &%s_table, %s%s);" % (name, p, final))
+    w.line("}")
+    w.line()
+    w.constructor([ "eos_tsm_init(&me->super, priority, parameter);", "%s_start(me);" % name ])
+    return w.end()
+
+
+def generate(chart, backend, source, dense = False):
+    check(chart)
+    if backend == "sm":
+        return gen_sm(chart, source)
+    if backend == "dsm":
+        return gen_dsm(chart, source)
+    if backend == "tsm":
+        return gen_tsm(chart, source, dense)
+    raise ChartError("unknown backend " + backend)
+
+
+# 往返检查：状态函数 -> 状态图 -> 状态函数 -> 状态图，两次得到的状态图相同，且再次生成的代码不变。
+def roundtrip(path):
+    chart = load(path)
+    code = generate(chart, "sm", os.path.basename(path))
+    chart2 = import_c(code, os.path.dirname(os.path.abspath(path)))
+    chart2["name"] = chart["name"]
+    if chart != chart2:
+        return False
+    return generate(chart2, "sm", os.path.basename(path)) == code
+
+
+# 编译检查：由path反推的状态图，以各后端生成代码，用C编译器（环境变量CC，默认cc）检查语法与
+# 警告。定义Actor类型的头文件换成替身，其super为后端的状态机类型，其余成员取自代码中的me->xxx。
+BACKEND_SUPER = { "sm": "eos_sm_t", "dsm": "eos_dsm_t", "tsm": "eos_tsm_t" }
+
+
+def compile_check(path):
+    chart = load(path)
+    directory = os.path.dirname(os.path.abspath(path))
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    header = None
+    for inc in chart["include"]:
+        f = os.path.join(directory, inc)
+        if os.path.isfile(f):
+            with open(f, encoding = 'utf-8') as h:
+                if re.search(r"\}\s*%s\s*;" % re.escape(chart["type"]), h.read()) is not None:
+                    header = inc
+
+    ok = True
+    with tempfile.TemporaryDirectory() as tmp:
+        for backend in ("sm", "dsm", "tsm"):
+            code = generate(chart, backend, os.path.basename(path))
+            if header is not None:
+                fields = sorted(set(re.findall(r"\bme->(\w+)", code)) - set(["super"]))
+                with open(os.path.join(tmp, "sm_gen_actor.h"), mode = 'w') as h:
+                    h.write('#include "eventos.h"\n')
+                    h.write("typedef struct { %s super; %s} %s;\n" %
+                            (BACKEND_SUPER[backend],
+                             "".join("eos_u32_t %s; " % n for n in fields), chart["type"]))
+                code = code.replace('#include "%s"' % header, '#include "sm_gen_actor.h"')
+            source = os.path.join(tmp, "%s_%s.c" % (chart["name"], backend))
+            with open(source, mode = 'w') as f:
+                f.write(code)
+            cmd = [os.environ.get("CC", "cc"), "-fsyntax-only", "-Wall", "-Wextra", "-Werror",
+                   "-I" + tmp, "-I" + os.path.join(root, "eventos"), "-I" + directory, source]
+            # 状态图所在的工程有自己的配置文件时，按此配置编译
+            if os.path.isfile(os.path.join(directory, "eos_config_user.h")):
+                cmd.append("-DEOS_CONFIG_USER")
+            try:
+                result = subprocess.run(cmd, stdout = subprocess.PIPE, stderr = subprocess.STDOUT,
+                                        universal_newlines = True)
+            except OSError:
+                print("%s: no C compiler, compile check skipped" % path)
+                return ok
+            print("%s: %s backend %s" % (path, backend, "OK" if result.returncode == 0 else "FAILED"))
+            if result.returncode != 0:
+                sys.stderr.write(result.stdout)
+                ok = False
+    return ok
+
+
+def main(argv):
+    args = list(argv)
+    out = None
+    if "-o" in args:
+        i = args.index("-o")
+        out = args[i + 1]
+        del args[i:i + 2]
+    backend = "sm"
+    if "--backend" in args:
+        i = args.index("--backend")
+        backend = args[i + 1]
+        del args[i:i + 2]
+    dense = "--dense" in args
+    args = [a for a in args if a != "--dense"]
+
+    if len(args) == 2 and args[0] == "--check":
+        ok = roundtrip(args[1])
+        print("%s: round-trip %s" % (args[1], "OK" if ok else "FAILED"))
+        ok = compile_check(args[1]) and ok
+        return 0 if ok else 1
+    if len(args) == 2 and args[0] == "--import":
+        text = write_text(load(args[1]))
+    elif len(args) == 1:
+        text = generate(load(args[0]), backend, os.path.basename(args[0]), dense)
+    else:
+        print("usage: sm_gen.py <chart.sm|chart.json> [--backend sm|dsm|tsm] [--dense] [-o out.c]")
+        print("       sm_gen.py --import <file.c> [-o chart.sm]")
+        print("       sm_gen.py --check <file.c>")
+        return 1
+
+    if out is None:
+        sys.stdout.write(text)
+    else:
+        with open(out, mode = 'w', encoding = 'utf-8', newline = '\r\n') as f:
+            f.write(text)
+    return 0
+
+
+if __name__ == '__main__':
+    try:
+        sys.exit(main(sys.argv[1:]))
+    except ChartError as err:
+        sys.stderr.write("error: %s\n" % err)
+        sys.exit(1)
@@ -0,0 +1,141 @@
+# Filename: tsm_pack.py
+
+# 将平面状态机的转移表（JSON）生成为eos_tsm_table_t的C代码，默认按行位移压缩为稀疏表。
+#
+# 用法：python3 tools/tsm_pack.py parser.json [--dense] > parser_table.c
+#
+# JSON格式：
+# {
+#     "name": "parser",
+#     "states": ["Idle", "Head", "Body"],                  状态的编号即其下标
+#     "topics": ["Event_Start", "Event_Byte", "Event_End"], 须为连续的主题，首个为topic_min
+#     "entry": { "Head": "parser_enter_head" },             可选，进入动作
+#     "exit": { "Head": "parser_exit_head" },               可选，退出动作
+#     "table": {
+#         "Idle": { "Event_Start": ["Head", "parser_start"] },   [下一个状态, 动作（可选）]
+#         "Head": { "Event_Byte": ["Head"], "Event_End": ["Idle"] }
+#     }
+# }
+import json
+import sys
+
+EOS_TSM_NONE = 0xff
+
+
+# 按行位移压缩：非空表项较多的行先放，每一行取第一个与已有表项不冲突的位置。返回各行的起始位置
+# 与表项数量，表项数量保证每一行的[base, base + topic_num)都不越界。
+def pack(rows, topic_num):
+    base = [0] * len(rows)
+    used = set()
+    order = sorted(range(len(rows)), key = lambda s: -len(rows[s]))
+    for s in order:
+        b = 0
+        while any((b + t) in used for t in rows[s]):
+            b += 1
+        base[s] = b
+        used.update(b + t for t in rows[s])
+    size = max(b + topic_num for b in base)
+    return base, size
+
+
+def load(path):
+    with open(path, encoding = 'utf-8') as f:
+        sm = json.load(f)
+
+    states = sm["states"]
+    topics = sm["topics"]
+    if len(states) == 0 or len(states) >= EOS_TSM_NONE:
+        raise ValueError("the number of states must be 1 ~ 254")
+
+    # 每一行为 {主题下标: (下一个状态的编号, 动作)}
+    rows = []
+    for state in states:
+        row = {}
+        for topic, item in sm["table"].get(state, {}).items():
+            action = item[1] if len(item) > 1 else None
+            row[topics.index(topic)] = (states.index(item[0]), action)
+        rows.append(row)
+    return sm, rows
+
+
+def generate(sm, rows, dense):
+    name = sm["name"]
+    states = sm["states"]
+    topics = sm["topics"]
+    topic_num = len(topics)
+
+    if dense:
+        base = [s * topic_num for s in range(len(states))]
+        size = len(states) * topic_num
+    else:
+        base, size = pack([list(row.keys()) for row in rows], topic_num)
+
+    next_ = [EOS_TSM_NONE] * size
+    action = ["EOS_NULL"] * size
+    check = [EOS_TSM_NONE] * size
+    for s, row in enumerate(rows):
+        for t, (n, a) in row.items():
+            next_[base[s] + t] = n
+            check[base[s] + t] = s
+            if a is not None:
+                action[base[s] + t] = a
+    has_action = any(a != "EOS_NULL" for a in action)
+
+    out = []
+    out.append("// Generated by tools/tsm_pack.py, do not edit.")
+    out.append("// %s: %d states x %d topics, %d entries (%s)" %
+               (name, len(states), topic_num, size, "dense" if dense else "sparse"))
+    out.append("enum {")
+    for s, state in enumerate(states):
+        out.append("    %s_%s = %d," % (name, state, s))
+    out.append("};")
+    out.append("")
+
+    # 动作函数的声明
+    functions = set(a for a in action if a != "EOS_NULL")
+    for a in sorted(functions):
+        out.append("static void %s(eos_tsm_t * const me, eos_event_t const * const e);" % a)
+    hooks = set(sm.get("entry", {}).values()) | set(sm.get("exit", {}).values())
+    for a in sorted(hooks):
+        out.append("static void %s(eos_tsm_t * const me);" % a)
+    if len(functions) + len(hooks) != 0:
+        out.append("")
+
+    def array(ctype, var, items):
+        out.append("static const %s %s_%s[%d] = {" % (ctype, name, var, len(items)))
+        for i in range(0, len(items), 8):
+            out.append("    " + ", ".join(str(x) for x in items[i:i + 8]) + ",")
+        out.append("};")
+
+    array("eos_u8_t", "next", next_)
+    if has_action:
+        array("eos_tsm_action", "action", action)
+    if not dense:
+        array("eos_u16_t", "base", base)
+        array("eos_u8_t", "check", check)
+    for kind in ("entry", "exit"):
+        if len(sm.get(kind, {})) != 0:
+            array("eos_tsm_state_action", kind,
+                  [sm[kind].get(state, "EOS_NULL") for state in states])
+    out.append("")
+
+    def member(var, cond):
+        return ("%s_%s" % (name, var)) if cond else "EOS_NULL"
+
+    out.append("static const eos_tsm_table_t %s_table = {" % name)
+    out.append("    %s, %s, %s, %s, %s, %s," % (
+        member("next", True), member("action", has_action),
+        member("base", not dense), member("check", not dense),
+        member("entry", len(sm.get("entry", {})) != 0),
+        member("exit", len(sm.get("exit", {})) != 0)))
+    out.append("    %d, %d, %s, %d" % (size, len(states), topics[0], topic_num))
+    out.append("};")
+    return "\n".join(out) + "\n"
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        print("usage: tsm_pack.py <table.json> [--dense]")
+        sys.exit(1)
+    sm, rows = load(sys.argv[1])
+    sys.stdout.write(generate(sm, rows, "--dense" in sys.argv[2:]))